@@ -35,6 +35,9 @@ public class CarespaceSDK : ModuleRules
 				"SlateCore"
 			}
 		);
+
+		// Compressed response bodies are inflated with zlib directly, streaming into a growing buffer
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
 		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
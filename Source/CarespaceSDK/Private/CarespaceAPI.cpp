@@ -1,14 +1,81 @@
 #include "CarespaceAPI.h"
+#include "CarespacePreparedEndpoint.h"
+#include "CarespaceCompletionDispatcher.h"
 #include "Json.h"
-#include "JsonObjectConverter.h"
+#include "Async/Async.h"
+
+namespace CarespaceEndpoints
+{
+	static const FCarespacePreparedEndpoint ListUsers(TEXT("GET"), TEXT("/users"));
+	static const FCarespacePreparedEndpoint GetUser(TEXT("GET"), TEXT("/users/{id}"));
+	static const FCarespacePreparedEndpoint CreateUser(TEXT("POST"), TEXT("/users"));
+	static const FCarespacePreparedEndpoint ListClients(TEXT("GET"), TEXT("/clients"));
+	static const FCarespacePreparedEndpoint GetClient(TEXT("GET"), TEXT("/clients/{id}"));
+	static const FCarespacePreparedEndpoint CreateClient(TEXT("POST"), TEXT("/clients"));
+	static const FCarespacePreparedEndpoint ListPrograms(TEXT("GET"), TEXT("/programs"));
+	static const FCarespacePreparedEndpoint GetProgram(TEXT("GET"), TEXT("/programs/{id}"));
+	static const FCarespacePreparedEndpoint CreateProgram(TEXT("POST"), TEXT("/programs"));
+}
+
+template <typename ItemType>
+void UCarespaceAPI::ParseOffGameThread(const TArray<uint8>& ResponseBody, TUniqueFunction<TArray<ItemType>(const TArray<uint8>&)> Parse, TUniqueFunction<void(TArray<ItemType>&&)> Continuation)
+{
+	// Results are delivered in the lane of the request they answer, within the dispatcher's frame budget
+	const ECarespaceRequestPriority Priority = HTTPClient ? HTTPClient->GetDispatchPriority() : ECarespaceRequestPriority::Interactive;
+
+	// The caller stays cancellable until its results are delivered
+	const uint64 Token = HTTPClient ? HTTPClient->BeginDeferredCompletion() : 0;
+
+	// The body is only valid during the response callback, so the worker gets its own copy
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis = TWeakObjectPtr<UCarespaceAPI>(this), Priority, Token, Body = ResponseBody, Parse = MoveTemp(Parse), Continuation = MoveTemp(Continuation)]() mutable
+	{
+		TArray<ItemType> Items = Parse(Body);
+
+		FCarespaceCompletionDispatcher::Dispatch(Priority, [WeakThis, Token, Items = MoveTemp(Items), Continuation = MoveTemp(Continuation)]() mutable
+		{
+			if (WeakThis.IsValid() && WeakThis->EndDeferredCompletion(Token))
+			{
+				Continuation(MoveTemp(Items));
+			}
+		});
+	});
+}
+
+template <typename ItemType>
+void UCarespaceAPI::DecodeList(const TArray<uint8>& ResponseBody, TSharedRef<TCarespaceJsonListDecoder<ItemType>> Decoder, TUniqueFunction<TArray<ItemType>(const TArray<uint8>&)> Parse, TUniqueFunction<void(TArray<ItemType>&&)> Continuation)
+{
+	// Bodies served from a cache, or shared with an identical request already in flight, never went through the decoder
+	if (!Decoder->IsComplete())
+	{
+		ParseOffGameThread<ItemType>(ResponseBody, MoveTemp(Parse), MoveTemp(Continuation));
+		return;
+	}
+
+	const ECarespaceRequestPriority Priority = HTTPClient ? HTTPClient->GetDispatchPriority() : ECarespaceRequestPriority::Interactive;
+	const uint64 Token = HTTPClient ? HTTPClient->BeginDeferredCompletion() : 0;
+	FCarespaceCompletionDispatcher::Dispatch(Priority, [WeakThis = TWeakObjectPtr<UCarespaceAPI>(this), Token, Items = Decoder->MoveItems(), Continuation = MoveTemp(Continuation)]() mutable
+	{
+		if (WeakThis.IsValid() && WeakThis->EndDeferredCompletion(Token))
+		{
+			Continuation(MoveTemp(Items));
+		}
+	});
+}
+
+bool UCarespaceAPI::EndDeferredCompletion(uint64 Token) const
+{
+	return !HTTPClient || HTTPClient->EndDeferredCompletion(Token);
+}
 
 UCarespaceAPI::UCarespaceAPI()
 {
 	HTTPClient = nullptr;
 	AuthAPI = nullptr;
+	bWarmUpConnection = false;
+	SearchDebounceSeconds = 0.25f;
 }
 
-void UCarespaceAPI::Initialize(const FString& InBaseURL, const FString& InAPIKey)
+void UCarespaceAPI::Initialize(const FString& InBaseURL, const FString& InAPIKey, bool bInWarmUpConnection)
 {
 	// Create HTTP client
 	HTTPClient = NewObject<UCarespaceHTTPClient>(this);
@@ -22,6 +89,12 @@ void UCarespaceAPI::Initialize(const FString& InBaseURL, const FString& InAPIKey
 	AuthAPI = NewObject<UCarespaceAuthAPI>(this);
 	AuthAPI->Initialize(HTTPClient);
 
+	bWarmUpConnection = bInWarmUpConnection;
+	if (bWarmUpConnection)
+	{
+		HTTPClient->WarmUpConnection();
+	}
+
 	UE_LOG(LogTemp, Log, TEXT("CarespaceAPI initialized with Base URL: %s"), *InBaseURL);
 }
 
@@ -39,6 +112,10 @@ void UCarespaceAPI::SetBaseURL(const FString& InBaseURL)
 	if (HTTPClient)
 	{
 		HTTPClient->SetBaseURL(InBaseURL);
+		if (bWarmUpConnection)
+		{
+			HTTPClient->WarmUpConnection();
+		}
 		UE_LOG(LogTemp, Log, TEXT("CarespaceAPI: Base URL updated to %s"), *InBaseURL);
 	}
 }
@@ -59,142 +136,230 @@ UCarespaceAPI* UCarespaceAPI::CreateCarespaceAPI(const FString& BaseURL, const F
 }
 
 // Users API implementations
-void UCarespaceAPI::GetUsers(int32 Page, int32 Limit, const FString& Search, const FOnCarespaceUsersReceived& OnComplete)
+FCarespaceRequestHandle UCarespaceAPI::GetUsers(int32 Page, int32 Limit, const FString& Search, const FOnCarespaceUsersReceived& OnComplete)
 {
 	if (!HTTPClient)
 	{
 		UE_LOG(LogTemp, Error, TEXT("CarespaceAPI: Not initialized"));
 		OnComplete.ExecuteIfBound(false, TArray<FCarespaceUser>());
-		return;
+		return FCarespaceRequestHandle();
 	}
 
-	TMap<FString, FString> QueryParams;
-	QueryParams.Add(TEXT("page"), FString::FromInt(Page));
-	QueryParams.Add(TEXT("limit"), FString::FromInt(Limit));
-	if (!Search.IsEmpty())
-	{
-		QueryParams.Add(TEXT("search"), Search);
-	}
-
-	HTTPClient->SendGETRequest(TEXT("/users"), QueryParams, 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleUsersResponse"), OnComplete));
+	TSharedRef<TCarespaceJsonListDecoder<FCarespaceUser>> Decoder = MakeShared<TCarespaceJsonListDecoder<FCarespaceUser>>();
+	return SendListRequest(CarespaceEndpoints::ListUsers, Page, Limit, TEXT("search"), Search,
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAPI::HandleUsersResponse, OnComplete, Decoder), OnComplete.GetUObject(), Decoder);
 }
 
-void UCarespaceAPI::GetUser(const FString& UserId, const FOnCarespaceUsersReceived& OnComplete)
+FCarespaceRequestHandle UCarespaceAPI::GetUser(const FString& UserId, const FOnCarespaceUsersReceived& OnComplete)
 {
 	if (!HTTPClient)
 	{
 		UE_LOG(LogTemp, Error, TEXT("CarespaceAPI: Not initialized"));
 		OnComplete.ExecuteIfBound(false, TArray<FCarespaceUser>());
-		return;
+		return FCarespaceRequestHandle();
 	}
 
-	FString Endpoint = FString::Printf(TEXT("/users/%s"), *UserId);
-	HTTPClient->SendGETRequest(Endpoint, TMap<FString, FString>(), 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleSingleUserResponse"), OnComplete));
+	return HTTPClient->SendPrepared(CarespaceEndpoints::GetUser, { FStringView(UserId) }, TMap<FString, FString>(), TArray<uint8>(),
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAPI::HandleSingleUserResponse, OnComplete), OnComplete.GetUObject());
 }
 
-void UCarespaceAPI::CreateUser(const FCarespaceCreateUserRequest& UserRequest, const FOnCarespaceUsersReceived& OnComplete)
+FCarespaceRequestHandle UCarespaceAPI::CreateUser(const FCarespaceCreateUserRequest& UserRequest, const FOnCarespaceUsersReceived& OnComplete)
 {
 	if (!HTTPClient)
 	{
 		UE_LOG(LogTemp, Error, TEXT("CarespaceAPI: Not initialized"));
 		OnComplete.ExecuteIfBound(false, TArray<FCarespaceUser>());
-		return;
+		return FCarespaceRequestHandle();
 	}
 
-	FString JsonPayload = UCarespaceHTTPClient::StructToJsonString(FCarespaceCreateUserRequest::StaticStruct(), &UserRequest);
-	HTTPClient->SendPOSTRequest(TEXT("/users"), JsonPayload, 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleSingleUserResponse"), OnComplete));
+	// Serialized on a worker thread from a copy, so the caller may change or destroy its struct right away
+	return HTTPClient->SendPreparedDeferred(CarespaceEndpoints::CreateUser, {}, TMap<FString, FString>(),
+		[UserRequest]() { return CarespaceJson::ToJsonBytes(UserRequest); },
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAPI::HandleSingleUserResponse, OnComplete), OnComplete.GetUObject());
 }
 
 // Clients API implementations
-void UCarespaceAPI::GetClients(int32 Page, int32 Limit, const FString& Search, const FOnCarespaceClientsReceived& OnComplete)
+FCarespaceRequestHandle UCarespaceAPI::GetClients(int32 Page, int32 Limit, const FString& Search, const FOnCarespaceClientsReceived& OnComplete)
 {
 	if (!HTTPClient)
 	{
 		UE_LOG(LogTemp, Error, TEXT("CarespaceAPI: Not initialized"));
 		OnComplete.ExecuteIfBound(false, TArray<FCarespaceClient>());
-		return;
+		return FCarespaceRequestHandle();
 	}
 
-	TMap<FString, FString> QueryParams;
-	QueryParams.Add(TEXT("page"), FString::FromInt(Page));
-	QueryParams.Add(TEXT("limit"), FString::FromInt(Limit));
-	if (!Search.IsEmpty())
+	TSharedRef<TCarespaceJsonListDecoder<FCarespaceClient>> Decoder = MakeShared<TCarespaceJsonListDecoder<FCarespaceClient>>();
+	return SendListRequest(CarespaceEndpoints::ListClients, Page, Limit, TEXT("search"), Search,
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAPI::HandleClientsResponse, OnComplete, Decoder), OnComplete.GetUObject(), Decoder);
+}
+
+FCarespaceRequestHandle UCarespaceAPI::GetClient(const FString& ClientId, const FOnCarespaceClientsReceived& OnComplete)
+{
+	if (!HTTPClient)
 	{
-		QueryParams.Add(TEXT("search"), Search);
+		UE_LOG(LogTemp, Error, TEXT("CarespaceAPI: Not initialized"));
+		OnComplete.ExecuteIfBound(false, TArray<FCarespaceClient>());
+		return FCarespaceRequestHandle();
 	}
 
-	HTTPClient->SendGETRequest(TEXT("/clients"), QueryParams, 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleClientsResponse"), OnComplete));
+	return HTTPClient->SendPrepared(CarespaceEndpoints::GetClient, { FStringView(ClientId) }, TMap<FString, FString>(), TArray<uint8>(),
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAPI::HandleSingleClientResponse, OnComplete), OnComplete.GetUObject());
 }
 
-void UCarespaceAPI::GetClient(const FString& ClientId, const FOnCarespaceClientsReceived& OnComplete)
+FCarespaceRequestHandle UCarespaceAPI::CreateClient(const FCarespaceClient& ClientData, const FOnCarespaceClientsReceived& OnComplete)
 {
 	if (!HTTPClient)
 	{
 		UE_LOG(LogTemp, Error, TEXT("CarespaceAPI: Not initialized"));
 		OnComplete.ExecuteIfBound(false, TArray<FCarespaceClient>());
-		return;
+		return FCarespaceRequestHandle();
 	}
 
-	FString Endpoint = FString::Printf(TEXT("/clients/%s"), *ClientId);
-	HTTPClient->SendGETRequest(Endpoint, TMap<FString, FString>(), 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleSingleClientResponse"), OnComplete));
+	// Serialized on a worker thread from a copy, so the caller may change or destroy its struct right away
+	return HTTPClient->SendPreparedDeferred(CarespaceEndpoints::CreateClient, {}, TMap<FString, FString>(),
+		[ClientData]() { return CarespaceJson::ToJsonBytes(ClientData); },
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAPI::HandleSingleClientResponse, OnComplete), OnComplete.GetUObject());
 }
 
-void UCarespaceAPI::CreateClient(const FCarespaceClient& ClientData, const FOnCarespaceClientsReceived& OnComplete)
+// Programs API implementations
+FCarespaceRequestHandle UCarespaceAPI::GetPrograms(int32 Page, int32 Limit, const FString& Category, const FOnCarespaceProgramsReceived& OnComplete)
 {
 	if (!HTTPClient)
 	{
 		UE_LOG(LogTemp, Error, TEXT("CarespaceAPI: Not initialized"));
-		OnComplete.ExecuteIfBound(false, TArray<FCarespaceClient>());
-		return;
+		OnComplete.ExecuteIfBound(false, TArray<FCarespaceProgram>());
+		return FCarespaceRequestHandle();
 	}
 
-	FString JsonPayload = UCarespaceHTTPClient::StructToJsonString(FCarespaceClient::StaticStruct(), &ClientData);
-	HTTPClient->SendPOSTRequest(TEXT("/clients"), JsonPayload, 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleSingleClientResponse"), OnComplete));
+	TSharedRef<TCarespaceJsonListDecoder<FCarespaceProgram>> Decoder = MakeShared<TCarespaceJsonListDecoder<FCarespaceProgram>>();
+	return SendListRequest(CarespaceEndpoints::ListPrograms, Page, Limit, TEXT("category"), Category,
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAPI::HandleProgramsResponse, OnComplete, Decoder), OnComplete.GetUObject(), Decoder);
 }
 
-// Programs API implementations
-void UCarespaceAPI::GetPrograms(int32 Page, int32 Limit, const FString& Category, const FOnCarespaceProgramsReceived& OnComplete)
+FCarespaceRequestHandle UCarespaceAPI::GetProgram(const FString& ProgramId, const FOnCarespaceProgramsReceived& OnComplete)
 {
 	if (!HTTPClient)
 	{
 		UE_LOG(LogTemp, Error, TEXT("CarespaceAPI: Not initialized"));
 		OnComplete.ExecuteIfBound(false, TArray<FCarespaceProgram>());
-		return;
+		return FCarespaceRequestHandle();
 	}
 
+	return HTTPClient->SendPrepared(CarespaceEndpoints::GetProgram, { FStringView(ProgramId) }, TMap<FString, FString>(), TArray<uint8>(),
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAPI::HandleSingleProgramResponse, OnComplete), OnComplete.GetUObject());
+}
+
+FCarespaceRequestHandle UCarespaceAPI::CreateProgram(const FCarespaceProgram& ProgramData, const FOnCarespaceProgramsReceived& OnComplete)
+{
+	if (!HTTPClient)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CarespaceAPI: Not initialized"));
+		OnComplete.ExecuteIfBound(false, TArray<FCarespaceProgram>());
+		return FCarespaceRequestHandle();
+	}
+
+	// Serialized on a worker thread from a copy, so the caller may change or destroy its struct right away
+	return HTTPClient->SendPreparedDeferred(CarespaceEndpoints::CreateProgram, {}, TMap<FString, FString>(),
+		[ProgramData]() { return CarespaceJson::ToJsonBytes(ProgramData); },
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAPI::HandleSingleProgramResponse, OnComplete), OnComplete.GetUObject());
+}
+
+FCarespaceRequestHandle UCarespaceAPI::SendListRequest(const FCarespacePreparedEndpoint& Endpoint, int32 Page, int32 Limit, const TCHAR* FilterName, const FString& FilterValue, const FOnHTTPResponseBytes& OnComplete, UObject* Owner, TSharedPtr<FCarespaceJsonStreamDecoder> Decoder)
+{
 	TMap<FString, FString> QueryParams;
 	QueryParams.Add(TEXT("page"), FString::FromInt(Page));
 	QueryParams.Add(TEXT("limit"), FString::FromInt(Limit));
-	if (!Category.IsEmpty())
+	if (!FilterValue.IsEmpty())
 	{
-		QueryParams.Add(TEXT("category"), Category);
+		QueryParams.Add(FilterName, FilterValue);
 	}
 
-	HTTPClient->SendGETRequest(TEXT("/programs"), QueryParams, 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleProgramsResponse"), OnComplete));
+	return HTTPClient->SendPrepared(Endpoint, {}, QueryParams, TArray<uint8>(), OnComplete, Owner, MoveTemp(Decoder));
 }
 
-void UCarespaceAPI::GetProgram(const FString& ProgramId, const FOnCarespaceProgramsReceived& OnComplete)
+// Latest-wins queries
+void UCarespaceAPI::SetSearchDebounce(float Seconds)
+{
+	SearchDebounceSeconds = FMath::Max(0.0f, Seconds);
+}
+
+void UCarespaceAPI::SearchUsers(int32 Page, int32 Limit, const FString& Search, const FOnCarespaceUsersReceived& OnComplete)
 {
 	if (!HTTPClient)
 	{
 		UE_LOG(LogTemp, Error, TEXT("CarespaceAPI: Not initialized"));
-		OnComplete.ExecuteIfBound(false, TArray<FCarespaceProgram>());
+		OnComplete.ExecuteIfBound(false, TArray<FCarespaceUser>());
 		return;
 	}
 
-	FString Endpoint = FString::Printf(TEXT("/programs/%s"), *ProgramId);
-	HTTPClient->SendGETRequest(Endpoint, TMap<FString, FString>(), 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleSingleProgramResponse"), OnComplete));
+	IssueLatest(UserSearchChannel, [this, Page, Limit, Search, OnComplete](uint32 Generation)
+	{
+		TSharedRef<TCarespaceJsonListDecoder<FCarespaceUser>> Decoder = MakeShared<TCarespaceJsonListDecoder<FCarespaceUser>>();
+		return SendListRequest(CarespaceEndpoints::ListUsers, Page, Limit, TEXT("search"), Search,
+			FOnHTTPResponseBytes::CreateWeakLambda(this, [this, Generation, OnComplete, Decoder](bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error)
+			{
+				if (Generation != UserSearchChannel.Generation)
+				{
+					return;
+				}
+
+				if (!bWasSuccessful)
+				{
+					HandleUsersResponse(false, ResponseBody, Error, OnComplete, Decoder);
+					return;
+				}
+
+				DecodeList<FCarespaceUser>(ResponseBody, Decoder, &ParseUsersFromJson, [this, Generation, OnComplete](TArray<FCarespaceUser>&& Items)
+				{
+					// A newer query may have been issued while this page was being parsed
+					if (Generation == UserSearchChannel.Generation)
+					{
+						OnComplete.ExecuteIfBound(true, Items);
+					}
+				});
+			}), OnComplete.GetUObject());
+	});
 }
 
-void UCarespaceAPI::CreateProgram(const FCarespaceProgram& ProgramData, const FOnCarespaceProgramsReceived& OnComplete)
+void UCarespaceAPI::SearchClients(int32 Page, int32 Limit, const FString& Search, const FOnCarespaceClientsReceived& OnComplete)
+{
+	if (!HTTPClient)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CarespaceAPI: Not initialized"));
+		OnComplete.ExecuteIfBound(false, TArray<FCarespaceClient>());
+		return;
+	}
+
+	IssueLatest(ClientSearchChannel, [this, Page, Limit, Search, OnComplete](uint32 Generation)
+	{
+		TSharedRef<TCarespaceJsonListDecoder<FCarespaceClient>> Decoder = MakeShared<TCarespaceJsonListDecoder<FCarespaceClient>>();
+		return SendListRequest(CarespaceEndpoints::ListClients, Page, Limit, TEXT("search"), Search,
+			FOnHTTPResponseBytes::CreateWeakLambda(this, [this, Generation, OnComplete, Decoder](bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error)
+			{
+				if (Generation != ClientSearchChannel.Generation)
+				{
+					return;
+				}
+
+				if (!bWasSuccessful)
+				{
+					HandleClientsResponse(false, ResponseBody, Error, OnComplete, Decoder);
+					return;
+				}
+
+				DecodeList<FCarespaceClient>(ResponseBody, Decoder, &ParseClientsFromJson, [this, Generation, OnComplete](TArray<FCarespaceClient>&& Items)
+				{
+					// A newer query may have been issued while this page was being parsed
+					if (Generation == ClientSearchChannel.Generation)
+					{
+						OnComplete.ExecuteIfBound(true, Items);
+					}
+				});
+			}), OnComplete.GetUObject());
+	});
+}
+
+void UCarespaceAPI::SearchPrograms(int32 Page, int32 Limit, const FString& Category, const FOnCarespaceProgramsReceived& OnComplete)
 {
 	if (!HTTPClient)
 	{
@@ -203,13 +368,82 @@ void UCarespaceAPI::CreateProgram(const FCarespaceProgram& ProgramData, const FO
 		return;
 	}
 
-	FString JsonPayload = UCarespaceHTTPClient::StructToJsonString(FCarespaceProgram::StaticStruct(), &ProgramData);
-	HTTPClient->SendPOSTRequest(TEXT("/programs"), JsonPayload, 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleSingleProgramResponse"), OnComplete));
+	IssueLatest(ProgramSearchChannel, [this, Page, Limit, Category, OnComplete](uint32 Generation)
+	{
+		TSharedRef<TCarespaceJsonListDecoder<FCarespaceProgram>> Decoder = MakeShared<TCarespaceJsonListDecoder<FCarespaceProgram>>();
+		return SendListRequest(CarespaceEndpoints::ListPrograms, Page, Limit, TEXT("category"), Category,
+			FOnHTTPResponseBytes::CreateWeakLambda(this, [this, Generation, OnComplete, Decoder](bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error)
+			{
+				if (Generation != ProgramSearchChannel.Generation)
+				{
+					return;
+				}
+
+				if (!bWasSuccessful)
+				{
+					HandleProgramsResponse(false, ResponseBody, Error, OnComplete, Decoder);
+					return;
+				}
+
+				DecodeList<FCarespaceProgram>(ResponseBody, Decoder, &ParseProgramsFromJson, [this, Generation, OnComplete](TArray<FCarespaceProgram>&& Items)
+				{
+					// A newer query may have been issued while this page was being parsed
+					if (Generation == ProgramSearchChannel.Generation)
+					{
+						OnComplete.ExecuteIfBound(true, Items);
+					}
+				});
+			}), OnComplete.GetUObject());
+	});
+}
+
+void UCarespaceAPI::CancelPendingSearches()
+{
+	CancelChannel(UserSearchChannel);
+	CancelChannel(ClientSearchChannel);
+	CancelChannel(ProgramSearchChannel);
+}
+
+void UCarespaceAPI::IssueLatest(FSupersedeChannel& Channel, TFunction<FCarespaceRequestHandle(uint32)> Issue)
+{
+	CancelChannel(Channel);
+	const uint32 Generation = Channel.Generation;
+
+	if (SearchDebounceSeconds <= 0.0f)
+	{
+		Channel.InFlight = Issue(Generation);
+		return;
+	}
+
+	// Only the last call of a burst survives until the timer fires
+	Channel.DebounceHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [&Channel, Generation, Issue = MoveTemp(Issue)](float DeltaTime)
+	{
+		Channel.DebounceHandle.Reset();
+		if (Generation == Channel.Generation)
+		{
+			Channel.InFlight = Issue(Generation);
+		}
+		return false;
+	}), SearchDebounceSeconds);
+}
+
+void UCarespaceAPI::CancelChannel(FSupersedeChannel& Channel)
+{
+	// Bumping the generation also drops a response that is already being dispatched
+	++Channel.Generation;
+
+	if (Channel.DebounceHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(Channel.DebounceHandle);
+		Channel.DebounceHandle.Reset();
+	}
+
+	Channel.InFlight.Cancel();
+	Channel.InFlight = FCarespaceRequestHandle();
 }
 
 // Response handlers
-void UCarespaceAPI::HandleUsersResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceUsersReceived OnComplete)
+void UCarespaceAPI::HandleUsersResponse(bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error, FOnCarespaceUsersReceived OnComplete, TSharedRef<TCarespaceJsonListDecoder<FCarespaceUser>> Decoder)
 {
 	if (!bWasSuccessful)
 	{
@@ -218,11 +452,13 @@ void UCarespaceAPI::HandleUsersResponse(bool bWasSuccessful, const FString& Resp
 		return;
 	}
 
-	TArray<FCarespaceUser> Users = ParseUsersFromJson(ResponseContent);
-	OnComplete.ExecuteIfBound(true, Users);
+	DecodeList<FCarespaceUser>(ResponseBody, Decoder, &ParseUsersFromJson, [OnComplete](TArray<FCarespaceUser>&& Users)
+	{
+		OnComplete.ExecuteIfBound(true, Users);
+	});
 }
 
-void UCarespaceAPI::HandleSingleUserResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceUsersReceived OnComplete)
+void UCarespaceAPI::HandleSingleUserResponse(bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error, FOnCarespaceUsersReceived OnComplete)
 {
 	if (!bWasSuccessful)
 	{
@@ -231,13 +467,14 @@ void UCarespaceAPI::HandleSingleUserResponse(bool bWasSuccessful, const FString&
 		return;
 	}
 
-	FCarespaceUser User = ParseUserFromJson(ResponseContent);
-	TArray<FCarespaceUser> Users;
-	Users.Add(User);
-	OnComplete.ExecuteIfBound(true, Users);
+	ParseOffGameThread<FCarespaceUser>(ResponseBody, [](const TArray<uint8>& JsonBytes) { return TArray<FCarespaceUser>{ ParseUserFromJson(JsonBytes) }; },
+		[OnComplete](TArray<FCarespaceUser>&& Users)
+		{
+			OnComplete.ExecuteIfBound(true, Users);
+		});
 }
 
-void UCarespaceAPI::HandleClientsResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceClientsReceived OnComplete)
+void UCarespaceAPI::HandleClientsResponse(bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error, FOnCarespaceClientsReceived OnComplete, TSharedRef<TCarespaceJsonListDecoder<FCarespaceClient>> Decoder)
 {
 	if (!bWasSuccessful)
 	{
@@ -246,11 +483,13 @@ void UCarespaceAPI::HandleClientsResponse(bool bWasSuccessful, const FString& Re
 		return;
 	}
 
-	TArray<FCarespaceClient> Clients = ParseClientsFromJson(ResponseContent);
-	OnComplete.ExecuteIfBound(true, Clients);
+	DecodeList<FCarespaceClient>(ResponseBody, Decoder, &ParseClientsFromJson, [OnComplete](TArray<FCarespaceClient>&& Clients)
+	{
+		OnComplete.ExecuteIfBound(true, Clients);
+	});
 }
 
-void UCarespaceAPI::HandleSingleClientResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceClientsReceived OnComplete)
+void UCarespaceAPI::HandleSingleClientResponse(bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error, FOnCarespaceClientsReceived OnComplete)
 {
 	if (!bWasSuccessful)
 	{
@@ -259,13 +498,14 @@ void UCarespaceAPI::HandleSingleClientResponse(bool bWasSuccessful, const FStrin
 		return;
 	}
 
-	FCarespaceClient Client = ParseClientFromJson(ResponseContent);
-	TArray<FCarespaceClient> Clients;
-	Clients.Add(Client);
-	OnComplete.ExecuteIfBound(true, Clients);
+	ParseOffGameThread<FCarespaceClient>(ResponseBody, [](const TArray<uint8>& JsonBytes) { return TArray<FCarespaceClient>{ ParseClientFromJson(JsonBytes) }; },
+		[OnComplete](TArray<FCarespaceClient>&& Clients)
+		{
+			OnComplete.ExecuteIfBound(true, Clients);
+		});
 }
 
-void UCarespaceAPI::HandleProgramsResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceProgramsReceived OnComplete)
+void UCarespaceAPI::HandleProgramsResponse(bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error, FOnCarespaceProgramsReceived OnComplete, TSharedRef<TCarespaceJsonListDecoder<FCarespaceProgram>> Decoder)
 {
 	if (!bWasSuccessful)
 	{
@@ -274,11 +514,13 @@ void UCarespaceAPI::HandleProgramsResponse(bool bWasSuccessful, const FString& R
 		return;
 	}
 
-	TArray<FCarespaceProgram> Programs = ParseProgramsFromJson(ResponseContent);
-	OnComplete.ExecuteIfBound(true, Programs);
+	DecodeList<FCarespaceProgram>(ResponseBody, Decoder, &ParseProgramsFromJson, [OnComplete](TArray<FCarespaceProgram>&& Programs)
+	{
+		OnComplete.ExecuteIfBound(true, Programs);
+	});
 }
 
-void UCarespaceAPI::HandleSingleProgramResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceProgramsReceived OnComplete)
+void UCarespaceAPI::HandleSingleProgramResponse(bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error, FOnCarespaceProgramsReceived OnComplete)
 {
 	if (!bWasSuccessful)
 	{
@@ -287,108 +529,55 @@ void UCarespaceAPI::HandleSingleProgramResponse(bool bWasSuccessful, const FStri
 		return;
 	}
 
-	FCarespaceProgram Program = ParseProgramFromJson(ResponseContent);
-	TArray<FCarespaceProgram> Programs;
-	Programs.Add(Program);
-	OnComplete.ExecuteIfBound(true, Programs);
+	ParseOffGameThread<FCarespaceProgram>(ResponseBody, [](const TArray<uint8>& JsonBytes) { return TArray<FCarespaceProgram>{ ParseProgramFromJson(JsonBytes) }; },
+		[OnComplete](TArray<FCarespaceProgram>&& Programs)
+		{
+			OnComplete.ExecuteIfBound(true, Programs);
+		});
 }
 
 // Utility parsing methods
-TArray<FCarespaceUser> UCarespaceAPI::ParseUsersFromJson(const FString& JsonString)
+TArray<FCarespaceUser> UCarespaceAPI::ParseUsersFromJson(const TArray<uint8>& JsonBytes)
 {
+	// The whole body is at hand: index it once and let the typed decoders jump between its structural characters
 	TArray<FCarespaceUser> Users;
-	
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-
-	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
-	{
-		const TArray<TSharedPtr<FJsonValue>>* DataArray;
-		if (JsonObject->TryGetArrayField(TEXT("data"), DataArray))
-		{
-			for (const TSharedPtr<FJsonValue>& Value : *DataArray)
-			{
-				FCarespaceUser User;
-				if (FJsonObjectConverter::JsonObjectToUStruct(Value->AsObject().ToSharedRef(), FCarespaceUser::StaticStruct(), &User))
-				{
-					Users.Add(User);
-				}
-			}
-		}
-	}
-
+	CarespaceJson::FromJsonList(JsonBytes, "data", Users);
 	return Users;
 }
 
-TArray<FCarespaceClient> UCarespaceAPI::ParseClientsFromJson(const FString& JsonString)
+TArray<FCarespaceClient> UCarespaceAPI::ParseClientsFromJson(const TArray<uint8>& JsonBytes)
 {
+	// The whole body is at hand: index it once and let the typed decoders jump between its structural characters
 	TArray<FCarespaceClient> Clients;
-	
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-
-	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
-	{
-		const TArray<TSharedPtr<FJsonValue>>* DataArray;
-		if (JsonObject->TryGetArrayField(TEXT("data"), DataArray))
-		{
-			for (const TSharedPtr<FJsonValue>& Value : *DataArray)
-			{
-				FCarespaceClient Client;
-				if (FJsonObjectConverter::JsonObjectToUStruct(Value->AsObject().ToSharedRef(), FCarespaceClient::StaticStruct(), &Client))
-				{
-					Clients.Add(Client);
-				}
-			}
-		}
-	}
-
+	CarespaceJson::FromJsonList(JsonBytes, "data", Clients);
 	return Clients;
 }
 
-TArray<FCarespaceProgram> UCarespaceAPI::ParseProgramsFromJson(const FString& JsonString)
+TArray<FCarespaceProgram> UCarespaceAPI::ParseProgramsFromJson(const TArray<uint8>& JsonBytes)
 {
+	// The whole body is at hand: index it once and let the typed decoders jump between its structural characters
 	TArray<FCarespaceProgram> Programs;
-	
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-
-	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
-	{
-		const TArray<TSharedPtr<FJsonValue>>* DataArray;
-		if (JsonObject->TryGetArrayField(TEXT("data"), DataArray))
-		{
-			for (const TSharedPtr<FJsonValue>& Value : *DataArray)
-			{
-				FCarespaceProgram Program;
-				if (FJsonObjectConverter::JsonObjectToUStruct(Value->AsObject().ToSharedRef(), FCarespaceProgram::StaticStruct(), &Program))
-				{
-					Programs.Add(Program);
-				}
-			}
-		}
-	}
-
+	CarespaceJson::FromJsonList(JsonBytes, "data", Programs);
 	return Programs;
 }
 
-FCarespaceUser UCarespaceAPI::ParseUserFromJson(const FString& JsonString)
+FCarespaceUser UCarespaceAPI::ParseUserFromJson(const TArray<uint8>& JsonBytes)
 {
 	FCarespaceUser User;
-	UCarespaceHTTPClient::JsonStringToStruct(JsonString, FCarespaceUser::StaticStruct(), &User);
+	CarespaceJson::FromJson(JsonBytes, User);
 	return User;
 }
 
-FCarespaceClient UCarespaceAPI::ParseClientFromJson(const FString& JsonString)
+FCarespaceClient UCarespaceAPI::ParseClientFromJson(const TArray<uint8>& JsonBytes)
 {
 	FCarespaceClient Client;
-	UCarespaceHTTPClient::JsonStringToStruct(JsonString, FCarespaceClient::StaticStruct(), &Client);
+	CarespaceJson::FromJson(JsonBytes, Client);
 	return Client;
 }
 
-FCarespaceProgram UCarespaceAPI::ParseProgramFromJson(const FString& JsonString)
+FCarespaceProgram UCarespaceAPI::ParseProgramFromJson(const TArray<uint8>& JsonBytes)
 {
 	FCarespaceProgram Program;
-	UCarespaceHTTPClient::JsonStringToStruct(JsonString, FCarespaceProgram::StaticStruct(), &Program);
+	CarespaceJson::FromJson(JsonBytes, Program);
 	return Program;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "CarespaceAuthAPI.h"
-#include "Json.h"
+#include "CarespaceJsonDocument.h"
+#include "CarespaceJsonSchema.h"
 
 UCarespaceAuthAPI::UCarespaceAuthAPI()
 {
@@ -21,16 +22,8 @@ void UCarespaceAuthAPI::Login(const FCarespaceLoginRequest& LoginRequest, const
 	}
 
 	// Convert request to JSON
-	FString JsonPayload = UCarespaceHTTPClient::StructToJsonString(FCarespaceLoginRequest::StaticStruct(), &LoginRequest);
-
-	// Create delegate for handling response
-	FOnHTTPResponse ResponseDelegate;
-	ResponseDelegate.BindUFunction(this, FName("HandleLoginResponse"));
-	ResponseDelegate.BindUFunction(this, FName("HandleLoginResponse"));
-
-	// Add the OnComplete delegate as a parameter - we'll need to bind it differently
-	HTTPClient->SendPOSTRequest(TEXT("/auth/login"), JsonPayload, 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleLoginResponse"), OnComplete));
+	SendAuthRequest(TEXT("/auth/login"), CarespaceJson::ToJsonBytes(LoginRequest),
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAuthAPI::HandleLoginResponse, OnComplete));
 }
 
 void UCarespaceAuthAPI::Logout(const FOnCarespaceRequestComplete& OnComplete)
@@ -42,8 +35,8 @@ void UCarespaceAuthAPI::Logout(const FOnCarespaceRequestComplete& OnComplete)
 		return;
 	}
 
-	HTTPClient->SendPOSTRequest(TEXT("/auth/logout"), TEXT(""), 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleGenericResponse"), OnComplete));
+	SendAuthRequest(TEXT("/auth/logout"), TArray<uint8>(),
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAuthAPI::HandleGenericResponse, OnComplete));
 }
 
 void UCarespaceAuthAPI::RefreshToken(const FString& RefreshToken, const FOnCarespaceLoginComplete& OnComplete)
@@ -56,15 +49,15 @@ void UCarespaceAuthAPI::RefreshToken(const FString& RefreshToken, const FOnCares
 	}
 
 	// Create JSON payload
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-	JsonObject->SetStringField(TEXT("refresh_token"), RefreshToken);
-
-	FString JsonPayload;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonPayload);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-
-	HTTPClient->SendPOSTRequest(TEXT("/auth/refresh"), JsonPayload, 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleLoginResponse"), OnComplete));
+	TArray<uint8> JsonPayload;
+	FCarespaceJsonWriter Writer(JsonPayload);
+	Writer.BeginObject();
+	Writer.WriteKey("refresh_token");
+	Writer.WriteString(RefreshToken);
+	Writer.EndObject();
+
+	SendAuthRequest(TEXT("/auth/refresh"), MoveTemp(JsonPayload),
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAuthAPI::HandleLoginResponse, OnComplete));
 }
 
 void UCarespaceAuthAPI::ForgotPassword(const FString& Email, const FOnCarespaceRequestComplete& OnComplete)
@@ -77,15 +70,15 @@ void UCarespaceAuthAPI::ForgotPassword(const FString& Email, const FOnCarespaceR
 	}
 
 	// Create JSON payload
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-	JsonObject->SetStringField(TEXT("email"), Email);
-
-	FString JsonPayload;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonPayload);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-
-	HTTPClient->SendPOSTRequest(TEXT("/auth/forgot-password"), JsonPayload, 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleGenericResponse"), OnComplete));
+	TArray<uint8> JsonPayload;
+	FCarespaceJsonWriter Writer(JsonPayload);
+	Writer.BeginObject();
+	Writer.WriteKey("email");
+	Writer.WriteString(Email);
+	Writer.EndObject();
+
+	SendAuthRequest(TEXT("/auth/forgot-password"), MoveTemp(JsonPayload),
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAuthAPI::HandleGenericResponse, OnComplete));
 }
 
 void UCarespaceAuthAPI::ResetPassword(const FString& Token, const FString& NewPassword, const FOnCarespaceRequestComplete& OnComplete)
@@ -98,16 +91,17 @@ void UCarespaceAuthAPI::ResetPassword(const FString& Token, const FString& NewPa
 	}
 
 	// Create JSON payload
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-	JsonObject->SetStringField(TEXT("token"), Token);
-	JsonObject->SetStringField(TEXT("password"), NewPassword);
-
-	FString JsonPayload;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonPayload);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-
-	HTTPClient->SendPOSTRequest(TEXT("/auth/reset-password"), JsonPayload, 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleGenericResponse"), OnComplete));
+	TArray<uint8> JsonPayload;
+	FCarespaceJsonWriter Writer(JsonPayload);
+	Writer.BeginObject();
+	Writer.WriteKey("token");
+	Writer.WriteString(Token);
+	Writer.WriteKey("password");
+	Writer.WriteString(NewPassword);
+	Writer.EndObject();
+
+	SendAuthRequest(TEXT("/auth/reset-password"), MoveTemp(JsonPayload),
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAuthAPI::HandleGenericResponse, OnComplete));
 }
 
 void UCarespaceAuthAPI::ChangePassword(const FString& CurrentPassword, const FString& NewPassword, const FOnCarespaceRequestComplete& OnComplete)
@@ -120,19 +114,27 @@ void UCarespaceAuthAPI::ChangePassword(const FString& CurrentPassword, const FSt
 	}
 
 	// Create JSON payload
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-	JsonObject->SetStringField(TEXT("current_password"), CurrentPassword);
-	JsonObject->SetStringField(TEXT("new_password"), NewPassword);
-
-	FString JsonPayload;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonPayload);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	TArray<uint8> JsonPayload;
+	FCarespaceJsonWriter Writer(JsonPayload);
+	Writer.BeginObject();
+	Writer.WriteKey("current_password");
+	Writer.WriteString(CurrentPassword);
+	Writer.WriteKey("new_password");
+	Writer.WriteString(NewPassword);
+	Writer.EndObject();
+
+	SendAuthRequest(TEXT("/auth/change-password"), MoveTemp(JsonPayload),
+		FOnHTTPResponseBytes::CreateUObject(this, &UCarespaceAuthAPI::HandleGenericResponse, OnComplete));
+}
 
-	HTTPClient->SendPOSTRequest(TEXT("/auth/change-password"), JsonPayload, 
-		FOnHTTPResponse::CreateUFunction(this, FName("HandleGenericResponse"), OnComplete));
+void UCarespaceAuthAPI::SendAuthRequest(const TCHAR* Endpoint, TArray<uint8> JsonPayload, const FOnHTTPResponseBytes& OnComplete)
+{
+	FCarespaceRequestOptions Options;
+	Options.Priority = ECarespaceRequestPriority::Auth;
+	HTTPClient->SendRequestRaw(TEXT("POST"), Endpoint, TMap<FString, FString>(), MoveTemp(JsonPayload), Options, OnComplete);
 }
 
-void UCarespaceAuthAPI::HandleLoginResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceLoginComplete OnComplete)
+void UCarespaceAuthAPI::HandleLoginResponse(bool bWasSuccessful, const TArray<uint8>& ResponseContent, const FCarespaceError& Error, FOnCarespaceLoginComplete OnComplete)
 {
 	if (!bWasSuccessful)
 	{
@@ -142,13 +144,13 @@ void UCarespaceAuthAPI::HandleLoginResponse(bool bWasSuccessful, const FString&
 	}
 
 	// Parse access token from response
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseContent);
+	FCarespaceJsonDocument Document;
 
-	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+	if (Document.Parse(ResponseContent))
 	{
+		const FCarespaceJsonNode* AccessTokenNode = Document.GetRoot().FindField("access_token");
 		FString AccessToken;
-		if (JsonObject->TryGetStringField(TEXT("access_token"), AccessToken))
+		if (AccessTokenNode && AccessTokenNode->TryGetString(AccessToken))
 		{
 			UE_LOG(LogTemp, Log, TEXT("CarespaceAuthAPI: Login successful"));
 			OnComplete.ExecuteIfBound(true, AccessToken);
@@ -160,7 +162,7 @@ void UCarespaceAuthAPI::HandleLoginResponse(bool bWasSuccessful, const FString&
 	OnComplete.ExecuteIfBound(false, TEXT(""));
 }
 
-void UCarespaceAuthAPI::HandleGenericResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceRequestComplete OnComplete)
+void UCarespaceAuthAPI::HandleGenericResponse(bool bWasSuccessful, const TArray<uint8>& ResponseContent, const FCarespaceError& Error, FOnCarespaceRequestComplete OnComplete)
 {
 	if (!bWasSuccessful)
 	{
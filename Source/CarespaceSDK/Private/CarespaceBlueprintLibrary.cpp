@@ -1,4 +1,5 @@
 #include "CarespaceBlueprintLibrary.h"
+#include "CarespaceCompletionDispatcher.h"
 #include "Engine/Engine.h"
 
 UCarespaceAPI* UCarespaceBlueprintLibrary::CreateCarespaceAPI(const FString& BaseURL, const FString& APIKey)
@@ -168,6 +169,19 @@ bool UCarespaceBlueprintLibrary::IsNetworkError(const FCarespaceError& Error)
 	return Error.ErrorType == ECarespaceErrorType::NetworkError;
 }
 
+bool UCarespaceBlueprintLibrary::IsCircuitOpenError(const FCarespaceError& Error)
+{
+	return Error.ErrorType == ECarespaceErrorType::CircuitOpenError;
+}
+
+void UCarespaceBlueprintLibrary::SetCompletionFrameBudget(float Milliseconds)
+{
+	if (FCarespaceCompletionDispatcher* Dispatcher = FCarespaceCompletionDispatcher::Get())
+	{
+		Dispatcher->SetFrameBudgetMilliseconds(Milliseconds);
+	}
+}
+
 int32 UCarespaceBlueprintLibrary::GetUserCount(const TArray<FCarespaceUser>& Users)
 {
 	return Users.Num();
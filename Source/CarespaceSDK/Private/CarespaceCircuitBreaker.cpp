@@ -0,0 +1,193 @@
+#include "CarespaceCircuitBreaker.h"
+
+bool FCarespaceCircuitBreaker::IsRejecting(const FString& Key, double Now) const
+{
+	const FCircuit* Circuit = Circuits.Find(Key);
+	if (!Circuit)
+	{
+		return false;
+	}
+
+	switch (Circuit->State)
+	{
+	case ECarespaceCircuitState::Open:
+		return Now < Circuit->OpenUntil || Settings.HalfOpenProbes <= 0;
+	case ECarespaceCircuitState::HalfOpen:
+		return Circuit->ProbesInFlight >= Settings.HalfOpenProbes;
+	default:
+		return false;
+	}
+}
+
+bool FCarespaceCircuitBreaker::TryAdmit(const FString& Key, double Now, bool& bOutIsProbe)
+{
+	bOutIsProbe = false;
+
+	FCircuit* Circuit = Circuits.Find(Key);
+	if (!Circuit)
+	{
+		Circuit = &Circuits.Add(Key);
+	}
+
+	if (Circuit->State == ECarespaceCircuitState::Closed)
+	{
+		return true;
+	}
+
+	if (Circuit->State == ECarespaceCircuitState::Open)
+	{
+		if (Now < Circuit->OpenUntil)
+		{
+			return false;
+		}
+
+		Circuit->ProbeSuccesses = 0;
+		Circuit->ProbesInFlight = 0;
+		SetState(Key, *Circuit, ECarespaceCircuitState::HalfOpen);
+	}
+
+	if (Circuit->ProbesInFlight >= Settings.HalfOpenProbes)
+	{
+		return false;
+	}
+
+	++Circuit->ProbesInFlight;
+	bOutIsProbe = true;
+	return true;
+}
+
+void FCarespaceCircuitBreaker::RecordSuccess(const FString& Key, double Now, bool bWasProbe)
+{
+	FCircuit* Circuit = Circuits.Find(Key);
+	if (!Circuit)
+	{
+		return;
+	}
+
+	if (bWasProbe)
+	{
+		Circuit->ProbesInFlight = FMath::Max(0, Circuit->ProbesInFlight - 1);
+	}
+
+	switch (Circuit->State)
+	{
+	case ECarespaceCircuitState::Closed:
+		Circuit->ConsecutiveFailures = 0;
+		break;
+
+	case ECarespaceCircuitState::HalfOpen:
+		if (bWasProbe && ++Circuit->ProbeSuccesses >= Settings.SuccessesToClose)
+		{
+			Circuit->ConsecutiveFailures = 0;
+			Circuit->TimesOpened = 0;
+			SetState(Key, *Circuit, ECarespaceCircuitState::Closed);
+		}
+		break;
+
+	default:
+		// A late answer to a request sent before the circuit opened does not prove recovery
+		break;
+	}
+}
+
+void FCarespaceCircuitBreaker::RecordFailure(const FString& Key, double Now, bool bWasProbe)
+{
+	FCircuit* Circuit = Circuits.Find(Key);
+	if (!Circuit)
+	{
+		return;
+	}
+
+	if (bWasProbe)
+	{
+		Circuit->ProbesInFlight = FMath::Max(0, Circuit->ProbesInFlight - 1);
+	}
+
+	++Circuit->ConsecutiveFailures;
+
+	// Like a late success, a late failure of a request sent before the circuit opened says nothing about
+	// recovery; only a failed probe reopens a half-open circuit and doubles its open time
+	if ((Circuit->State == ECarespaceCircuitState::HalfOpen && bWasProbe)
+		|| (Circuit->State == ECarespaceCircuitState::Closed && Circuit->ConsecutiveFailures >= Settings.FailureThreshold))
+	{
+		Open(Key, *Circuit, Now);
+	}
+}
+
+void FCarespaceCircuitBreaker::ReleaseProbe(const FString& Key)
+{
+	if (FCircuit* Circuit = Circuits.Find(Key))
+	{
+		Circuit->ProbesInFlight = FMath::Max(0, Circuit->ProbesInFlight - 1);
+	}
+}
+
+ECarespaceCircuitState FCarespaceCircuitBreaker::GetState(const FString& Key) const
+{
+	const FCircuit* Circuit = Circuits.Find(Key);
+	return Circuit ? Circuit->State : ECarespaceCircuitState::Closed;
+}
+
+bool FCarespaceCircuitBreaker::HasOpenCircuits() const
+{
+	for (const TPair<FString, FCircuit>& Pair : Circuits)
+	{
+		if (Pair.Value.State != ECarespaceCircuitState::Closed)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+TArray<FCarespaceCircuitStatus> FCarespaceCircuitBreaker::GetStates(double Now) const
+{
+	TArray<FCarespaceCircuitStatus> States;
+	States.Reserve(Circuits.Num());
+
+	for (const TPair<FString, FCircuit>& Pair : Circuits)
+	{
+		FCarespaceCircuitStatus& Status = States.AddDefaulted_GetRef();
+		Status.Key = Pair.Key;
+		Status.State = Pair.Value.State;
+		Status.ConsecutiveFailures = Pair.Value.ConsecutiveFailures;
+		Status.SecondsUntilProbe = Pair.Value.State == ECarespaceCircuitState::Open ? static_cast<float>(FMath::Max(0.0, Pair.Value.OpenUntil - Now)) : 0.0f;
+	}
+
+	return States;
+}
+
+void FCarespaceCircuitBreaker::Reset()
+{
+	for (TPair<FString, FCircuit>& Pair : Circuits)
+	{
+		if (Pair.Value.State != ECarespaceCircuitState::Closed)
+		{
+			SetState(Pair.Key, Pair.Value, ECarespaceCircuitState::Closed);
+		}
+	}
+	Circuits.Empty();
+}
+
+void FCarespaceCircuitBreaker::Open(const FString& Key, FCircuit& Circuit, double Now)
+{
+	// Back off further every time a probe finds the backend still down
+	const double OpenSeconds = FMath::Min<double>(Settings.MaxOpenSeconds, Settings.OpenSeconds * FMath::Pow(2.0, FMath::Min(Circuit.TimesOpened, 16)));
+	++Circuit.TimesOpened;
+	Circuit.OpenUntil = Now + OpenSeconds;
+	Circuit.ProbeSuccesses = 0;
+
+	UE_LOG(LogTemp, Warning, TEXT("CarespaceCircuitBreaker: %s failing fast for %.1fs after %d consecutive failures"), *Key, OpenSeconds, Circuit.ConsecutiveFailures);
+
+	SetState(Key, Circuit, ECarespaceCircuitState::Open);
+}
+
+void FCarespaceCircuitBreaker::SetState(const FString& Key, FCircuit& Circuit, ECarespaceCircuitState State)
+{
+	Circuit.State = State;
+
+	if (StateChangedCallback)
+	{
+		StateChangedCallback(Key, State);
+	}
+}
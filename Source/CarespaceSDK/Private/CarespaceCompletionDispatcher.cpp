@@ -0,0 +1,109 @@
+#include "CarespaceCompletionDispatcher.h"
+#include "Async/Async.h"
+
+FCarespaceCompletionDispatcher* FCarespaceCompletionDispatcher::Instance = nullptr;
+
+FCarespaceCompletionDispatcher::FCarespaceCompletionDispatcher()
+	: NumPending(0)
+	, FrameBudgetMilliseconds(2.0f)
+{
+}
+
+FCarespaceCompletionDispatcher::~FCarespaceCompletionDispatcher()
+{
+	Stop();
+}
+
+void FCarespaceCompletionDispatcher::Dispatch(ECarespaceRequestPriority Priority, TUniqueFunction<void()> Completion)
+{
+	if (FCarespaceCompletionDispatcher* Dispatcher = Get())
+	{
+		Dispatcher->Enqueue(Priority, MoveTemp(Completion));
+		return;
+	}
+
+	AsyncTask(ENamedThreads::GameThread, MoveTemp(Completion));
+}
+
+FCarespaceCompletionDispatcher* FCarespaceCompletionDispatcher::Get()
+{
+	return Instance;
+}
+
+void FCarespaceCompletionDispatcher::Enqueue(ECarespaceRequestPriority Priority, TUniqueFunction<void()> Completion)
+{
+	const int32 Lane = FMath::Clamp(static_cast<int32>(Priority), 0, NumLanes - 1);
+	Lanes[Lane].Enqueue(MoveTemp(Completion));
+	NumPending.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FCarespaceCompletionDispatcher::SetFrameBudgetMilliseconds(float Milliseconds)
+{
+	FrameBudgetMilliseconds = FMath::Max(0.0f, Milliseconds);
+}
+
+int32 FCarespaceCompletionDispatcher::Drain(double BudgetSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumRun = 0;
+
+	for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+	{
+		TUniqueFunction<void()> Completion;
+		while (Lanes[Lane].Dequeue(Completion))
+		{
+			NumPending.fetch_sub(1, std::memory_order_relaxed);
+			Completion();
+			++NumRun;
+
+			if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+			{
+				return NumRun;
+			}
+
+			// A completion may have queued more urgent work; start over from the top lane
+			if (Lane > 0 && !Lanes[0].IsEmpty())
+			{
+				Lane = -1;
+				break;
+			}
+		}
+	}
+
+	return NumRun;
+}
+
+void FCarespaceCompletionDispatcher::Start()
+{
+	if (!TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCarespaceCompletionDispatcher::Tick));
+	}
+	Instance = this;
+}
+
+void FCarespaceCompletionDispatcher::Stop()
+{
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
+	// Nothing will tick anymore; don't leave callers waiting forever
+	Drain(TNumericLimits<double>::Max());
+}
+
+bool FCarespaceCompletionDispatcher::Tick(float DeltaTime)
+{
+	if (GetNumPending() > 0)
+	{
+		Drain(FrameBudgetMilliseconds / 1000.0);
+	}
+	return true;
+}
@@ -0,0 +1,229 @@
+#include "CarespaceDiskCache.h"
+#include "CarespaceTypes.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace CarespaceDiskCache
+{
+	static constexpr uint32 FileMagic = 0x43534443; // "CSDC"
+	static constexpr uint32 FileFormatVersion = 1;
+	static const TCHAR* FileExtension = TEXT(".cache");
+}
+
+FCarespaceDiskCache::FCarespaceDiskCache()
+	: WriteLock(MakeShared<FCriticalSection, ESPMode::ThreadSafe>())
+{
+	SetSettings(FCarespaceDiskCacheSettings());
+}
+
+void FCarespaceDiskCache::SetSettings(const FCarespaceDiskCacheSettings& InSettings)
+{
+	Settings = InSettings;
+	CacheDirectory = Settings.Directory.IsEmpty()
+		? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Carespace"), TEXT("ResponseCache"))
+		: Settings.Directory;
+}
+
+bool FCarespaceDiskCache::IsCacheable(const FString& Endpoint) const
+{
+	if (!Settings.bEnabled)
+	{
+		return false;
+	}
+
+	for (const FString& Prefix : Settings.EndpointPrefixes)
+	{
+		if (Endpoint.StartsWith(Prefix))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+TSharedPtr<FCarespaceCachedResponse> FCarespaceDiskCache::Load(const FString& Key, double& OutAgeSeconds) const
+{
+	return LoadEntry(GetEntryPath(Key), Key, OutAgeSeconds);
+}
+
+void FCarespaceDiskCache::LoadAsync(const FString& Key, TFunction<void(TSharedPtr<FCarespaceCachedResponse>, double)> OnLoaded) const
+{
+	// The path is resolved here, since the settings may change on the game thread while the read runs
+	Async(EAsyncExecution::ThreadPool, [Key, Path = GetEntryPath(Key), OnLoaded = MoveTemp(OnLoaded)]() mutable
+	{
+		double AgeSeconds = 0.0;
+		TSharedPtr<FCarespaceCachedResponse> Entry = FCarespaceDiskCache::LoadEntry(Path, Key, AgeSeconds);
+
+		AsyncTask(ENamedThreads::GameThread, [OnLoaded = MoveTemp(OnLoaded), Entry = MoveTemp(Entry), AgeSeconds]()
+		{
+			OnLoaded(Entry, AgeSeconds);
+		});
+	});
+}
+
+TSharedPtr<FCarespaceCachedResponse> FCarespaceDiskCache::LoadEntry(const FString& Path, const FString& Key, double& OutAgeSeconds)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *Path, FILEREAD_Silent))
+	{
+		return nullptr;
+	}
+
+	FMemoryReader Reader(FileData);
+	uint32 Magic = 0;
+	uint32 FormatVersion = 0;
+	uint32 SchemaVersion = 0;
+	Reader << Magic << FormatVersion << SchemaVersion;
+
+	if (Magic != CarespaceDiskCache::FileMagic || FormatVersion != CarespaceDiskCache::FileFormatVersion || SchemaVersion != CARESPACE_SDK_SCHEMA_VERSION)
+	{
+		// Written by another SDK version; the data types may no longer match
+		IFileManager::Get().Delete(*Path, false, false, true);
+		return nullptr;
+	}
+
+	FString StoredKey;
+	int32 UncompressedSize = 0;
+	TArray<uint8> CompressedBody;
+	TSharedRef<FCarespaceCachedResponse> Entry = MakeShared<FCarespaceCachedResponse>();
+	Reader << StoredKey << Entry->ETag << Entry->LastModified << UncompressedSize << CompressedBody;
+
+	// Guard against hash collisions and truncated files
+	if (Reader.IsError() || StoredKey != Key || UncompressedSize < 0)
+	{
+		return nullptr;
+	}
+
+	Entry->Body.SetNumUninitialized(UncompressedSize);
+	if (UncompressedSize > 0 && !FCompression::UncompressMemory(NAME_Zlib, Entry->Body.GetData(), UncompressedSize, CompressedBody.GetData(), CompressedBody.Num()))
+	{
+		return nullptr;
+	}
+
+	OutAgeSeconds = (FDateTime::UtcNow() - IFileManager::Get().GetTimeStamp(*Path)).GetTotalSeconds();
+	return Entry;
+}
+
+TFuture<void> FCarespaceDiskCache::StoreAsync(const FString& Key, TSharedRef<const FCarespaceCachedResponse> Entry) const
+{
+	const FString Path = GetEntryPath(Key);
+	const FString Directory = CacheDirectory;
+	const int64 MaxBytes = Settings.MaxBytes;
+	TSharedRef<FCriticalSection, ESPMode::ThreadSafe> Lock = WriteLock;
+
+	return Async(EAsyncExecution::ThreadPool, [Key, Entry, Path, Directory, MaxBytes, Lock]()
+	{
+		const int32 UncompressedSize = Entry->Body.Num();
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+
+		TArray<uint8> CompressedBody;
+		CompressedBody.SetNumUninitialized(CompressedSize);
+		if (!FCompression::CompressMemory(NAME_Zlib, CompressedBody.GetData(), CompressedSize, Entry->Body.GetData(), UncompressedSize))
+		{
+			return;
+		}
+		CompressedBody.SetNum(CompressedSize, false);
+
+		TArray<uint8> FileData;
+		FMemoryWriter Writer(FileData);
+		uint32 Magic = CarespaceDiskCache::FileMagic;
+		uint32 FormatVersion = CarespaceDiskCache::FileFormatVersion;
+		uint32 SchemaVersion = CARESPACE_SDK_SCHEMA_VERSION;
+		FString StoredKey = Key;
+		FString ETag = Entry->ETag;
+		FString LastModified = Entry->LastModified;
+		int32 StoredSize = UncompressedSize;
+		Writer << Magic << FormatVersion << SchemaVersion << StoredKey << ETag << LastModified << StoredSize << CompressedBody;
+
+		FScopeLock ScopeLock(&Lock.Get());
+
+		// Write to a temporary file first so that readers never observe a partial entry
+		const FString TempPath = Path + TEXT(".tmp");
+		if (FFileHelper::SaveArrayToFile(FileData, *TempPath))
+		{
+			IFileManager::Get().Move(*Path, *TempPath, true, true, false, true);
+		}
+
+		FCarespaceDiskCache::EnforceBudget(Directory, MaxBytes);
+	});
+}
+
+TFuture<void> FCarespaceDiskCache::Touch(const FString& Key) const
+{
+	// The time of the confirmation, not of the write, is what makes the entry fresh
+	const FDateTime Now = FDateTime::UtcNow();
+	TSharedRef<FCriticalSection, ESPMode::ThreadSafe> Lock = WriteLock;
+
+	return Async(EAsyncExecution::ThreadPool, [Path = GetEntryPath(Key), Now, Lock]()
+	{
+		FScopeLock ScopeLock(&Lock.Get());
+		IFileManager::Get().SetTimeStamp(*Path, Now);
+	});
+}
+
+TFuture<void> FCarespaceDiskCache::Clear() const
+{
+	TSharedRef<FCriticalSection, ESPMode::ThreadSafe> Lock = WriteLock;
+
+	return Async(EAsyncExecution::ThreadPool, [Directory = CacheDirectory, Lock]()
+	{
+		FScopeLock ScopeLock(&Lock.Get());
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	});
+}
+
+FString FCarespaceDiskCache::GetEntryPath(const FString& Key) const
+{
+	// Hashing keeps file names short and keeps credentials and query strings out of the file system
+	return FPaths::Combine(CacheDirectory, FMD5::HashAnsiString(*Key) + CarespaceDiskCache::FileExtension);
+}
+
+void FCarespaceDiskCache::EnforceBudget(const FString& Directory, int64 MaxBytes)
+{
+	struct FCacheFile
+	{
+		FString Path;
+		FDateTime TimeStamp;
+		int64 Size;
+	};
+
+	TArray<FCacheFile> Files;
+	int64 TotalBytes = 0;
+
+	IFileManager::Get().IterateDirectoryStat(*Directory, [&Files, &TotalBytes](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+	{
+		if (!StatData.bIsDirectory && FString(FilenameOrDirectory).EndsWith(CarespaceDiskCache::FileExtension))
+		{
+			Files.Add({ FilenameOrDirectory, StatData.ModificationTime, StatData.FileSize });
+			TotalBytes += StatData.FileSize;
+		}
+		return true;
+	});
+
+	if (TotalBytes <= MaxBytes)
+	{
+		return;
+	}
+
+	// Least recently written or revalidated entries go first
+	Files.Sort([](const FCacheFile& A, const FCacheFile& B) { return A.TimeStamp < B.TimeStamp; });
+
+	for (const FCacheFile& File : Files)
+	{
+		if (TotalBytes <= MaxBytes)
+		{
+			break;
+		}
+
+		if (IFileManager::Get().Delete(*File.Path, false, false, true))
+		{
+			TotalBytes -= File.Size;
+		}
+	}
+}
@@ -1,137 +1,1962 @@
 #include "CarespaceHTTPClient.h"
+#include "CarespacePreparedEndpoint.h"
+#include "CarespaceCompletionDispatcher.h"
+#include "CarespaceJsonDocument.h"
+#include "CarespaceJsonStream.h"
+#include "CarespaceStructPlan.h"
 #include "HttpModule.h"
+#include "Async/Async.h"
 #include "JsonObjectConverter.h"
+#include "Misc/Base64.h"
+#include "Misc/Compression.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryWriter.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+// Engines without IHttpRequest::SetResponseBodyReceiveStream decode list responses once the body is complete
+#define CARESPACE_WITH_RESPONSE_STREAM (ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3))
+
+/**
+ * Receives a response body from the HTTP thread in place of the response's own content buffer.
+ * The bytes are kept for caching, coalesced callers and error reporting, and fed to the caller's
+ * decoder as they arrive so that list elements are decoded while the rest is still downloading.
+ */
+class FCarespaceResponseStream : public FArchive
+{
+public:
+	explicit FCarespaceResponseStream(TSharedRef<FCarespaceJsonStreamDecoder> InDecoder)
+		: Decoder(InDecoder)
+	{
+		SetIsSaving(true);
+	}
+
+	virtual void Serialize(void* Data, int64 Length) override
+	{
+		const TArrayView<const uint8> Bytes(static_cast<const uint8*>(Data), static_cast<int32>(Length));
+		Body.Append(Bytes.GetData(), Bytes.Num());
+
+		FScopeLock Lock(&DecoderLock);
+		if (Decoder.IsValid())
+		{
+			Decoder->Feed(Bytes);
+		}
+	}
+
+	void Reset()
+	{
+		Body.Reset();
+
+		FScopeLock Lock(&DecoderLock);
+		if (Decoder.IsValid())
+		{
+			Decoder->Reset();
+		}
+	}
+
+	/**
+	 * Hands the decoder back to its caller, e.g. once the caller was answered from the disk cache. The body
+	 * is still collected for the caches, but the HTTP thread no longer touches the decoder.
+	 */
+	void DetachDecoder()
+	{
+		FScopeLock Lock(&DecoderLock);
+		if (Decoder.IsValid())
+		{
+			// Whatever was fed so far belongs to a body the caller will not receive
+			Decoder->Reset();
+			Decoder.Reset();
+		}
+	}
+
+	const TArray<uint8>& GetBody() const { return Body; }
+
+	bool IsDecoderComplete() const
+	{
+		FScopeLock Lock(&DecoderLock);
+		return Decoder.IsValid() && Decoder->IsComplete();
+	}
+
+private:
+	TArray<uint8> Body;
+	TSharedPtr<FCarespaceJsonStreamDecoder> Decoder;
+	mutable FCriticalSection DecoderLock;
+};
+
+namespace
+{
+	// Extra time the HTTP module gives a request beyond its attempt timer, so that the timer always fires first
+	constexpr float AttemptTimeoutGraceSeconds = 5.0f;
+
+	// Responses are JSON documents; a body that inflates past this is refused rather than buffered
+	constexpr int32 MaxDecodedBodyBytes = 64 * 1024 * 1024;
+
+	/**
+	 * Inflates a gzip or zlib stream into a buffer that grows as output arrives, so that neither a missing
+	 * nor a lying size field costs more than doubling the buffer a few times.
+	 *
+	 * @return False if the stream is corrupt or truncated, or inflates past MaxDecodedBodyBytes
+	 */
+	bool InflateBody(const TArray<uint8>& Content, bool bIsGzip, int64 SizeHint, TArray<uint8>& OutBody)
+	{
+		z_stream Stream;
+		FMemory::Memzero(Stream);
+
+		// Window bits plus 16 selects the gzip wrapper instead of the zlib one
+		if (inflateInit2(&Stream, bIsGzip ? MAX_WBITS + 16 : MAX_WBITS) != Z_OK)
+		{
+			return false;
+		}
+		Stream.next_in = const_cast<Bytef*>(Content.GetData());
+		Stream.avail_in = static_cast<uInt>(Content.Num());
+
+		OutBody.SetNumUninitialized(static_cast<int32>(FMath::Clamp<int64>(SizeHint, 256, MaxDecodedBodyBytes)), false);
+		int32 Written = 0;
+		int Result = Z_OK;
+		while (Result == Z_OK)
+		{
+			if (Written == OutBody.Num())
+			{
+				if (OutBody.Num() >= MaxDecodedBodyBytes)
+				{
+					break;
+				}
+				OutBody.SetNumUninitialized(FMath::Min(OutBody.Num() * 2, MaxDecodedBodyBytes), false);
+			}
+
+			Stream.next_out = OutBody.GetData() + Written;
+			Stream.avail_out = static_cast<uInt>(OutBody.Num() - Written);
+			Result = inflate(&Stream, Z_NO_FLUSH);
+			Written = OutBody.Num() - static_cast<int32>(Stream.avail_out);
+		}
+		inflateEnd(&Stream);
+
+		// Truncated input ends in Z_BUF_ERROR, corrupt input in Z_DATA_ERROR, an oversized body with Z_OK
+		if (Result != Z_STREAM_END)
+		{
+			OutBody.Reset();
+			return false;
+		}
+
+		OutBody.SetNum(Written, false);
+		return true;
+	}
+
+	FString HashToHex(const FString& Text)
+	{
+		const FTCHARToUTF8 Utf8(*Text, Text.Len());
+		FSHAHash Hash;
+		FSHA1::HashBuffer(Utf8.Get(), Utf8.Length(), Hash.Hash);
+		return Hash.ToString();
+	}
+}
 
 UCarespaceHTTPClient::UCarespaceHTTPClient()
 {
 	BaseURL = TEXT("https://api-dev.carespace.ai");
 	APIKey = TEXT("");
 	TimeoutSeconds = 30.0f;
+	bCoalesceRequests = true;
+	MaxConcurrentRequests = 6;
+	MaxConcurrentRequestsPerHost = 4;
+	ActiveRequestCount = 0;
+	bRateLimitingEnabled = true;
+	QueueWakeUpTime = 0.0;
+	NextRequestId = 0;
+	KeepAliveIntervalSeconds = 0.0f;
+	DispatchPriority = ECarespaceRequestPriority::Interactive;
+	DispatchingId = 0;
+	LastRequestTime = 0.0;
+	Transport = ICarespaceHttpTransport::CreateDefault();
+
+	// POST is not idempotent; only retry it when the server explicitly refused to process it
+	FCarespaceRetryPolicy PostPolicy;
+	PostPolicy.bRetryOnNetworkError = false;
+	PostPolicy.bRetryOnServerError = false;
+
+	RetryPolicies.Add(TEXT("GET"), FCarespaceRetryPolicy());
+	RetryPolicies.Add(TEXT("PUT"), FCarespaceRetryPolicy());
+	RetryPolicies.Add(TEXT("DELETE"), FCarespaceRetryPolicy());
+	RetryPolicies.Add(TEXT("POST"), PostPolicy);
+
+	HedgeBudgetTokens = HedgingPolicy.MaxBudgetTokens;
+
+	CircuitBreaker.SetStateChangedCallback([this](const FString& Key, ECarespaceCircuitState State)
+	{
+		OnCircuitStateChanged.Broadcast(Key, State);
+	});
+
+	RequestCompression = ECarespaceContentEncoding::None;
+	MinCompressedRequestBytes = 1024;
+
+	bResponseCacheEnabled = true;
+
+	RetryBudgetRatio = 0.2f;
+	RetryBudgetMaxTokens = 10.0f;
+	RetryBudgetTokens = RetryBudgetMaxTokens;
+
+	RebuildCommonHeaders();
+}
+
+void UCarespaceHTTPClient::BeginDestroy()
+{
+	if (QueueWakeUpHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(QueueWakeUpHandle);
+		QueueWakeUpHandle.Reset();
+	}
+
+	if (OwnerSweepHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(OwnerSweepHandle);
+		OwnerSweepHandle.Reset();
+	}
+
+	if (KeepAliveHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(KeepAliveHandle);
+		KeepAliveHandle.Reset();
+	}
+
+	Super::BeginDestroy();
+}
+
+void UCarespaceHTTPClient::SetBaseURL(const FString& InBaseURL)
+{
+	BaseURL = InBaseURL;
+}
+
+void UCarespaceHTTPClient::SetAPIKey(const FString& InAPIKey)
+{
+	APIKey = InAPIKey;
+	RebuildCommonHeaders();
+}
+
+void UCarespaceHTTPClient::RebuildCommonHeaders()
+{
+	CommonHeaders.Reset();
+	CommonHeaders.Emplace(TEXT("Content-Type"), TEXT("application/json"));
+	CommonHeaders.Emplace(TEXT("Accept"), TEXT("application/json"));
+	CommonHeaders.Emplace(TEXT("Accept-Encoding"), TEXT("gzip, deflate"));
+
+	if (!APIKey.IsEmpty())
+	{
+		CommonHeaders.Emplace(TEXT("Authorization"), TEXT("Bearer ") + APIKey);
+	}
+
+	// A cryptographic digest, unlike a checksum, keeps two tokens from sharing a key and does not give the token away
+	APIKeyHash = HashToHex(APIKey);
+
+	// Tokens are refreshed, the account behind them is not
+	const FString Identity = CacheIdentity.IsEmpty() ? GetCredentialSubject(APIKey) : CacheIdentity;
+	CacheIdentityHash = Identity.IsEmpty() ? APIKeyHash : HashToHex(TEXT("sub:") + Identity);
+}
+
+FString UCarespaceHTTPClient::GetCredentialSubject(const FString& Credential)
+{
+	// A JWT is header.payload.signature, with a base64url-encoded JSON payload
+	int32 FirstDot = INDEX_NONE;
+	int32 LastDot = INDEX_NONE;
+	if (!Credential.FindChar(TEXT('.'), FirstDot) || !Credential.FindLastChar(TEXT('.'), LastDot) || LastDot <= FirstDot + 1)
+	{
+		return FString();
+	}
+
+	FString Payload = Credential.Mid(FirstDot + 1, LastDot - FirstDot - 1);
+	Payload.ReplaceCharInline(TEXT('-'), TEXT('+'));
+	Payload.ReplaceCharInline(TEXT('_'), TEXT('/'));
+	while (Payload.Len() % 4 != 0)
+	{
+		Payload.AppendChar(TEXT('='));
+	}
+
+	TArray<uint8> Json;
+	FCarespaceJsonDocument Document;
+	FString Subject;
+	if (!FBase64::Decode(Payload, Json) || !Document.Parse(Json))
+	{
+		return FString();
+	}
+
+	const FCarespaceJsonNode* SubjectNode = Document.GetRoot().FindField("sub");
+	return SubjectNode && SubjectNode->TryGetString(Subject) ? Subject : FString();
+}
+
+void UCarespaceHTTPClient::SetCacheIdentity(const FString& Identity)
+{
+	CacheIdentity = Identity;
+	RebuildCommonHeaders();
+}
+
+void UCarespaceHTTPClient::SetTimeout(float InTimeoutSeconds)
+{
+	TimeoutSeconds = InTimeoutSeconds;
+}
+
+void UCarespaceHTTPClient::SetEndpointTimeout(const FString& EndpointPrefix, float InTimeoutSeconds)
+{
+	if (InTimeoutSeconds > 0.0f)
+	{
+		EndpointTimeouts.Add(EndpointPrefix, InTimeoutSeconds);
+	}
+	else
+	{
+		EndpointTimeouts.Remove(EndpointPrefix);
+	}
+}
+
+float UCarespaceHTTPClient::GetAttemptTimeout(const FString& Endpoint, const FCarespaceRequestOptions& Options) const
+{
+	if (Options.TimeoutSeconds > 0.0f)
+	{
+		return Options.TimeoutSeconds;
+	}
+
+	float Timeout = TimeoutSeconds;
+	int32 LongestPrefix = -1;
+	for (const TPair<FString, float>& Pair : EndpointTimeouts)
+	{
+		if (Pair.Key.Len() > LongestPrefix && Endpoint.StartsWith(Pair.Key))
+		{
+			Timeout = Pair.Value;
+			LongestPrefix = Pair.Key.Len();
+		}
+	}
+	return Timeout;
+}
+
+void UCarespaceHTTPClient::SetRequestCoalescingEnabled(bool bEnabled)
+{
+	bCoalesceRequests = bEnabled;
+}
+
+void UCarespaceHTTPClient::SetTransport(TSharedPtr<ICarespaceHttpTransport> InTransport)
+{
+	Transport = InTransport.IsValid() ? InTransport : ICarespaceHttpTransport::CreateDefault();
+}
+
+void UCarespaceHTTPClient::ResetStats()
+{
+	Stats = FCarespaceHTTPStats();
+}
+
+void UCarespaceHTTPClient::SetMaxConcurrentRequests(int32 InMaxConcurrentRequests)
+{
+	MaxConcurrentRequests = FMath::Max(0, InMaxConcurrentRequests);
+	PumpRequestQueue();
+}
+
+void UCarespaceHTTPClient::SetMaxConcurrentRequestsPerHost(int32 InMaxConcurrentRequestsPerHost)
+{
+	MaxConcurrentRequestsPerHost = FMath::Max(0, InMaxConcurrentRequestsPerHost);
+	PumpRequestQueue();
+}
+
+void UCarespaceHTTPClient::SetRateLimitingEnabled(bool bEnabled)
+{
+	bRateLimitingEnabled = bEnabled;
+	PumpRequestQueue();
+}
+
+TArray<FCarespaceRateLimitState> UCarespaceHTTPClient::GetRateLimitStates()
+{
+	return RateLimiter.GetStates(FPlatformTime::Seconds());
+}
+
+void UCarespaceHTTPClient::SetHedgingPolicy(const FCarespaceHedgingPolicy& Policy)
+{
+	HedgingPolicy = Policy;
+	HedgeBudgetTokens = FMath::Min(HedgeBudgetTokens, HedgingPolicy.MaxBudgetTokens);
+}
+
+void UCarespaceHTTPClient::WarmUpConnection()
+{
+	SendConnectionProbe(true);
+}
+
+void UCarespaceHTTPClient::SetKeepAliveInterval(float IntervalSeconds)
+{
+	KeepAliveIntervalSeconds = FMath::Max(0.0f, IntervalSeconds);
+
+	if (KeepAliveHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(KeepAliveHandle);
+		KeepAliveHandle.Reset();
+	}
+
+	if (KeepAliveIntervalSeconds > 0.0f)
+	{
+		// Check twice per interval so an idle connection is refreshed at most half an interval late
+		KeepAliveHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UCarespaceHTTPClient::TickKeepAlive), KeepAliveIntervalSeconds * 0.5f);
+	}
+}
+
+bool UCarespaceHTTPClient::TickKeepAlive(float DeltaTime)
+{
+	if (ActiveRequestCount == 0 && FPlatformTime::Seconds() - LastRequestTime >= KeepAliveIntervalSeconds)
+	{
+		SendConnectionProbe(false);
+	}
+	return true;
+}
+
+void UCarespaceHTTPClient::SendConnectionProbe(bool bIsWarmUp)
+{
+	// The HEAD only has to reach the server, so it needs no credentials and yields to every real request
+	FCarespaceRequestOptions Options;
+	Options.Priority = ECarespaceRequestPriority::Background;
+	Options.TimeoutSeconds = FMath::Min(TimeoutSeconds, 10.0f);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FOnHTTPResponseBytes OnProbeComplete = FOnHTTPResponseBytes::CreateLambda([WeakThis = TWeakObjectPtr<UCarespaceHTTPClient>(this), StartTime, bIsWarmUp, URL = BaseURL](bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error)
+	{
+		UCarespaceHTTPClient* Client = WeakThis.Get();
+		if (!Client)
+		{
+			return;
+		}
+
+		// Any status code means the connection is open
+		if (!bWasSuccessful && Error.StatusCode == 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("CarespaceHTTPClient: Could not reach %s to open a connection ahead of time"), *URL);
+			return;
+		}
+
+		if (bIsWarmUp)
+		{
+			Client->Stats.WarmUpSeconds = static_cast<float>(FPlatformTime::Seconds() - StartTime);
+			UE_LOG(LogTemp, Log, TEXT("CarespaceHTTPClient: Connection to %s warmed up in %.0f ms"), *URL, Client->Stats.WarmUpSeconds * 1000.0f);
+		}
+	});
+
+	SubmitRequest(TEXT("HEAD"), TEXT("/"), BaseURL, TArray<uint8>(), Options, { FOnHTTPResponse(), OnProbeComplete }, nullptr, false);
+}
+
+void UCarespaceHTTPClient::SetCircuitBreakerSettings(const FCarespaceCircuitBreakerSettings& Settings)
+{
+	CircuitBreaker.SetSettings(Settings);
+}
+
+ECarespaceCircuitState UCarespaceHTTPClient::GetCircuitState(const FString& Endpoint) const
+{
+	const FString Host = FGenericPlatformHttp::GetUrlDomain(BaseURL);
+	const ECarespaceCircuitState HostState = CircuitBreaker.GetState(Host);
+	const ECarespaceCircuitState FamilyState = CircuitBreaker.GetState(Host + FCarespaceLatencyTracker::GetEndpointFamily(Endpoint));
+
+	if (HostState == ECarespaceCircuitState::Open || FamilyState == ECarespaceCircuitState::Open)
+	{
+		return ECarespaceCircuitState::Open;
+	}
+	if (HostState == ECarespaceCircuitState::HalfOpen || FamilyState == ECarespaceCircuitState::HalfOpen)
+	{
+		return ECarespaceCircuitState::HalfOpen;
+	}
+	return ECarespaceCircuitState::Closed;
+}
+
+TArray<FCarespaceCircuitStatus> UCarespaceHTTPClient::GetCircuitStates() const
+{
+	return CircuitBreaker.GetStates(FPlatformTime::Seconds());
+}
+
+void UCarespaceHTTPClient::ResetCircuits()
+{
+	CircuitBreaker.Reset();
+	PumpRequestQueue();
+}
+
+void UCarespaceHTTPClient::SetRequestCompression(ECarespaceContentEncoding Encoding, int32 MinBytes)
+{
+	RequestCompression = Encoding;
+	MinCompressedRequestBytes = FMath::Max(0, MinBytes);
+}
+
+void UCarespaceHTTPClient::SetResponseCacheEnabled(bool bEnabled)
+{
+	bResponseCacheEnabled = bEnabled;
+	if (!bEnabled)
+	{
+		ResponseCache.Empty();
+	}
+}
+
+void UCarespaceHTTPClient::SetResponseCacheBudget(int64 MaxBytes)
+{
+	ResponseCache.SetMaxBytes(MaxBytes);
+}
+
+void UCarespaceHTTPClient::ClearResponseCache()
+{
+	ResponseCache.Empty();
+}
+
+void UCarespaceHTTPClient::SetDiskCacheSettings(const FCarespaceDiskCacheSettings& Settings)
+{
+	DiskCache.SetSettings(Settings);
+}
+
+void UCarespaceHTTPClient::ClearDiskCache()
+{
+	DiskCache.Clear();
+}
+
+void UCarespaceHTTPClient::SetRetryPolicy(const FString& Verb, const FCarespaceRetryPolicy& Policy)
+{
+	RetryPolicies.Add(Verb.ToUpper(), Policy);
+}
+
+FCarespaceRetryPolicy UCarespaceHTTPClient::GetRetryPolicy(const FString& Verb) const
+{
+	const FCarespaceRetryPolicy* Policy = RetryPolicies.Find(Verb.ToUpper());
+	return Policy ? *Policy : FCarespaceRetryPolicy();
+}
+
+void UCarespaceHTTPClient::SetMaxRetries(int32 MaxRetries)
+{
+	for (TPair<FString, FCarespaceRetryPolicy>& Pair : RetryPolicies)
+	{
+		Pair.Value.MaxRetries = FMath::Max(0, MaxRetries);
+	}
+}
+
+void UCarespaceHTTPClient::SetRetryDelay(float BaseDelaySeconds)
+{
+	for (TPair<FString, FCarespaceRetryPolicy>& Pair : RetryPolicies)
+	{
+		Pair.Value.BaseDelaySeconds = FMath::Max(0.0f, BaseDelaySeconds);
+	}
+}
+
+void UCarespaceHTTPClient::SetRetryBudget(float RetryRatio, float MaxTokens)
+{
+	RetryBudgetRatio = FMath::Max(0.0f, RetryRatio);
+	RetryBudgetMaxTokens = FMath::Max(0.0f, MaxTokens);
+	RetryBudgetTokens = FMath::Min(RetryBudgetTokens, RetryBudgetMaxTokens);
+}
+
+int32 UCarespaceHTTPClient::GetQueueDepth(ECarespaceRequestPriority Priority) const
+{
+	const int32 Lane = static_cast<int32>(Priority);
+	return Lane < NumPriorityLanes ? PendingRequests[Lane].Num() : 0;
+}
+
+int32 UCarespaceHTTPClient::GetTotalQueueDepth() const
+{
+	int32 Total = 0;
+	for (const TArray<TSharedRef<FCarespaceRequestContext>>& Lane : PendingRequests)
+	{
+		Total += Lane.Num();
+	}
+	return Total;
+}
+
+FCarespaceRequestHandle UCarespaceHTTPClient::SendGETRequest(const FString& Endpoint, const TMap<FString, FString>& QueryParameters, const FOnHTTPResponse& OnComplete)
+{
+	return SubmitRequest(TEXT("GET"), Endpoint, BuildURL(Endpoint, QueryParameters), TArray<uint8>(), MakeDefaultOptions(Endpoint), { OnComplete, FOnHTTPResponseBytes() });
+}
+
+FCarespaceRequestHandle UCarespaceHTTPClient::SendPOSTRequest(const FString& Endpoint, const FString& JsonPayload, const FOnHTTPResponse& OnComplete)
+{
+	return SubmitRequest(TEXT("POST"), Endpoint, BuildURL(Endpoint), StringToBytes(JsonPayload), MakeDefaultOptions(Endpoint), { OnComplete, FOnHTTPResponseBytes() });
+}
+
+FCarespaceRequestHandle UCarespaceHTTPClient::SendPUTRequest(const FString& Endpoint, const FString& JsonPayload, const FOnHTTPResponse& OnComplete)
+{
+	return SubmitRequest(TEXT("PUT"), Endpoint, BuildURL(Endpoint), StringToBytes(JsonPayload), MakeDefaultOptions(Endpoint), { OnComplete, FOnHTTPResponseBytes() });
+}
+
+FCarespaceRequestHandle UCarespaceHTTPClient::SendDELETERequest(const FString& Endpoint, const FOnHTTPResponse& OnComplete)
+{
+	return SubmitRequest(TEXT("DELETE"), Endpoint, BuildURL(Endpoint), TArray<uint8>(), MakeDefaultOptions(Endpoint), { OnComplete, FOnHTTPResponseBytes() });
+}
+
+FCarespaceRequestHandle UCarespaceHTTPClient::SendRequest(const FString& Verb, const FString& Endpoint, const TMap<FString, FString>& QueryParameters, const FString& JsonPayload, const FCarespaceRequestOptions& Options, const FOnHTTPResponse& OnComplete)
+{
+	return SubmitRequest(Verb.ToUpper(), Endpoint, BuildURL(Endpoint, QueryParameters), StringToBytes(JsonPayload), Options, { OnComplete, FOnHTTPResponseBytes() });
+}
+
+FCarespaceRequestHandle UCarespaceHTTPClient::SendRequestRaw(const FString& Verb, const FString& Endpoint, const TMap<FString, FString>& QueryParameters, const FString& JsonPayload, const FCarespaceRequestOptions& Options, const FOnHTTPResponseBytes& OnComplete)
+{
+	return SendRequestRaw(Verb, Endpoint, QueryParameters, StringToBytes(JsonPayload), Options, OnComplete);
+}
+
+FCarespaceRequestHandle UCarespaceHTTPClient::SendRequestRaw(const FString& Verb, const FString& Endpoint, const TMap<FString, FString>& QueryParameters, TArray<uint8> JsonPayload, const FCarespaceRequestOptions& Options, const FOnHTTPResponseBytes& OnComplete)
+{
+	return SubmitRequest(Verb.ToUpper(), Endpoint, BuildURL(Endpoint, QueryParameters), MoveTemp(JsonPayload), Options, { FOnHTTPResponse(), OnComplete });
+}
+
+FCarespaceRequestHandle UCarespaceHTTPClient::SendPrepared(const FCarespacePreparedEndpoint& Endpoint, TArrayView<const FStringView> PathArguments, const TMap<FString, FString>& QueryParameters, TArray<uint8> JsonPayload, const FOnHTTPResponseBytes& OnComplete, UObject* Owner, TSharedPtr<FCarespaceJsonStreamDecoder> ResponseDecoder)
+{
+	FCarespaceRequestOptions Options = Endpoint.GetOptions();
+	if (Owner)
+	{
+		Options.Owner = Owner;
+	}
+
+	FString Path;
+	FString URL;
+	if (!BuildPreparedURL(Endpoint, PathArguments, QueryParameters, Path, URL))
+	{
+		return RejectPathArguments(Endpoint, Options, OnComplete);
+	}
+
+	return SubmitRequest(Endpoint.GetVerb(), Path, URL, MoveTemp(JsonPayload), Options, { FOnHTTPResponse(), OnComplete }, MoveTemp(ResponseDecoder));
+}
+
+FCarespaceRequestHandle UCarespaceHTTPClient::SendPreparedDeferred(const FCarespacePreparedEndpoint& Endpoint, TArrayView<const FStringView> PathArguments, const TMap<FString, FString>& QueryParameters, TUniqueFunction<TArray<uint8>()> SerializePayload, const FOnHTTPResponseBytes& OnComplete, UObject* Owner)
+{
+	FCarespaceRequestOptions Options = Endpoint.GetOptions();
+	if (Owner)
+	{
+		Options.Owner = Owner;
+	}
+
+	FString Path;
+	FString URL;
+	if (!BuildPreparedURL(Endpoint, PathArguments, QueryParameters, Path, URL))
+	{
+		return RejectPathArguments(Endpoint, Options, OnComplete);
+	}
+
+	// Hold the caller's place with a subscription that has no request yet, so the handle is pending and cancellable
+	FCarespaceResponseCallback Callback{ FOnHTTPResponse(), OnComplete, ++NextRequestId };
+	const uint64 Id = Callback.Id;
+	const UObject* SubscriptionOwner = Options.Owner.IsValid() ? Options.Owner.Get() : OnComplete.GetUObject();
+	Subscriptions.Add(Id, FSubscription{ nullptr, SubscriptionOwner });
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis = TWeakObjectPtr<UCarespaceHTTPClient>(this), Verb = Endpoint.GetVerb(), Path = MoveTemp(Path), URL = MoveTemp(URL), Options, Callback = MoveTemp(Callback), SerializePayload = MoveTemp(SerializePayload)]() mutable
+	{
+		TArray<uint8> Payload = SerializePayload();
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Verb = MoveTemp(Verb), Path = MoveTemp(Path), URL = MoveTemp(URL), Options, Callback = MoveTemp(Callback), Payload = MoveTemp(Payload)]() mutable
+		{
+			UCarespaceHTTPClient* Client = WeakThis.Get();
+			if (!Client)
+			{
+				return;
+			}
+
+			// The caller may have cancelled, or its owner been destroyed, while the payload was serialized
+			FSubscription Subscription;
+			if (!Client->Subscriptions.RemoveAndCopyValue(Callback.Id, Subscription) || Subscription.Owner.IsStale())
+			{
+				return;
+			}
+
+			Client->SubmitRequest(Verb, Path, URL, MoveTemp(Payload), Options, MoveTemp(Callback));
+		});
+	});
+
+	return FCarespaceRequestHandle(this, Id);
+}
+
+FCarespaceRequestHandle UCarespaceHTTPClient::RejectPathArguments(const FCarespacePreparedEndpoint& Endpoint, const FCarespaceRequestOptions& Options, const FOnHTTPResponseBytes& OnComplete)
+{
+	// The caller gets a pending, cancellable handle like for any other request
+	TArray<FCarespaceResponseCallback> Callbacks{ FCarespaceResponseCallback{ FOnHTTPResponse(), OnComplete, ++NextRequestId } };
+	const uint64 Id = Callbacks[0].Id;
+	const UObject* Owner = Options.Owner.IsValid() ? Options.Owner.Get() : OnComplete.GetUObject();
+	Subscriptions.Add(Id, FSubscription{ nullptr, Owner });
+
+	const FCarespaceError Error(ECarespaceErrorType::ValidationError,
+		FString::Printf(TEXT("Wrong number of path arguments for %s"), *Endpoint.GetPathTemplate()));
+
+	// Report later, like any other response, so callers never run inside their own send call
+	FCarespaceCompletionDispatcher::Dispatch(Options.Priority, [WeakThis = TWeakObjectPtr<UCarespaceHTTPClient>(this), Callbacks = MoveTemp(Callbacks), Priority = Options.Priority, Error]()
+	{
+		if (UCarespaceHTTPClient* Client = WeakThis.Get())
+		{
+			Client->DispatchResponse(Callbacks, Priority, false, TArray<uint8>(), Error);
+		}
+	});
+	return FCarespaceRequestHandle(this, Id);
+}
+
+bool UCarespaceHTTPClient::BuildPreparedURL(const FCarespacePreparedEndpoint& Endpoint, TArrayView<const FStringView> PathArguments, const TMap<FString, FString>& QueryParameters, FString& OutPath, FString& OutURL) const
+{
+	TStringBuilder<512> URL;
+	URL << BaseURL;
+	const int32 PathStart = URL.Len();
+
+	if (!Endpoint.AppendPath(URL, PathArguments))
+	{
+		return false;
+	}
+
+	OutPath = FString(URL.ToView().Mid(PathStart));
+	AppendQueryString(URL, QueryParameters);
+	OutURL = FString(URL.ToView());
+	return true;
+}
+
+FCarespaceRequestOptions UCarespaceHTTPClient::MakeDefaultOptions(const FString& Endpoint) const
+{
+	FCarespaceRequestOptions Options;
+	Options.Priority = Endpoint.StartsWith(TEXT("/auth/")) ? ECarespaceRequestPriority::Auth : ECarespaceRequestPriority::Interactive;
+	return Options;
+}
+
+FCarespaceRequestHandle UCarespaceHTTPClient::SubmitRequest(const FString& Verb, const FString& Endpoint, const FString& URL, TArray<uint8> Payload, const FCarespaceRequestOptions& Options, FCarespaceResponseCallback OnComplete, TSharedPtr<FCarespaceJsonStreamDecoder> ResponseDecoder, bool bSendCredentials)
+{
+	// Deferred requests reserved their id when the caller received its handle
+	if (OnComplete.Id == 0)
+	{
+		OnComplete.Id = ++NextRequestId;
+	}
+	const FCarespaceRequestHandle Handle(this, OnComplete.Id);
+
+	if (Options.DeadlineSeconds > 0.0f)
+	{
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, Id = OnComplete.Id, DeadlineSeconds = Options.DeadlineSeconds](float DeltaTime)
+		{
+			ExpireSubscription(Id, DeadlineSeconds);
+			return false;
+		}), Options.DeadlineSeconds);
+	}
+
+	// Without an explicit owner the request lives as long as whoever receives the result
+	const UObject* Owner = Options.Owner.Get();
+	if (!Owner)
+	{
+		Owner = OnComplete.OnCompleteBytes.IsBound() ? OnComplete.OnCompleteBytes.GetUObject() : OnComplete.OnComplete.GetUObject();
+	}
+
+	if (Owner && !OwnerSweepHandle.IsValid())
+	{
+		OwnerSweepHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UCarespaceHTTPClient::SweepDestroyedOwners), 0.5f);
+	}
+
+	// Only GETs are safe to share or cache: they are idempotent and carry no body
+	const bool bIsGET = Verb == TEXT("GET");
+	const bool bCanCoalesce = bCoalesceRequests && bIsGET;
+	const ECarespaceRequestPriority Priority = PriorityOverride.Get(Options.Priority);
+	FString CoalescingKey;
+
+	if (bCanCoalesce)
+	{
+		CoalescingKey = MakeRequestKey(Verb, URL);
+		if (TSharedPtr<FCarespaceRequestContext>* Existing = InFlightGETRequests.Find(CoalescingKey))
+		{
+			TSharedRef<FCarespaceRequestContext> ExistingContext = (*Existing).ToSharedRef();
+			ExistingContext->Callbacks.Add(OnComplete);
+			Subscriptions.Add(OnComplete.Id, FSubscription{ ExistingContext, Owner });
+			ExistingContext->DeadlineTime = (ExistingContext->DeadlineTime > 0.0 && Options.DeadlineSeconds > 0.0f)
+				? FMath::Max(ExistingContext->DeadlineTime, FPlatformTime::Seconds() + Options.DeadlineSeconds)
+				: 0.0;
+			++Stats.RequestsCoalesced;
+
+			// A still-queued request inherits the most urgent lane of the callers waiting on it
+			if (Priority < ExistingContext->Priority && PendingRequests[static_cast<int32>(ExistingContext->Priority)].Remove(ExistingContext) > 0)
+			{
+				ExistingContext->Priority = Priority;
+				EnqueueRequest(ExistingContext);
+			}
+			return Handle;
+		}
+	}
+
+	TSharedRef<FCarespaceRequestContext> Context = MakeShared<FCarespaceRequestContext>();
+	Context->Verb = Verb;
+	Context->Endpoint = Endpoint;
+	Context->URL = URL;
+	Context->Payload = MoveTemp(Payload);
+	Context->CoalescingKey = CoalescingKey;
+	Context->CacheKey = bIsGET ? MakeCacheKey(URL) : FString();
+	Context->Host = FGenericPlatformHttp::GetUrlDomain(URL);
+	Context->Priority = Priority;
+	Context->bSendCredentials = bSendCredentials;
+	Context->RateLimitClass = FCarespaceRateLimiter::GetEndpointClass(Endpoint);
+	Context->LatencyKey = Context->Host + FCarespaceLatencyTracker::GetEndpointFamily(Endpoint);
+	Context->AttemptTimeoutSeconds = GetAttemptTimeout(Endpoint, Options);
+	Context->DeadlineTime = Options.DeadlineSeconds > 0.0f ? FPlatformTime::Seconds() + Options.DeadlineSeconds : 0.0;
+	Context->Callbacks.Add(OnComplete);
+	Subscriptions.Add(OnComplete.Id, FSubscription{ Context, Owner });
+	CompressPayload(*Context);
+
+#if CARESPACE_WITH_RESPONSE_STREAM
+	if (ResponseDecoder.IsValid())
+	{
+		Context->ResponseStream = MakeShared<FCarespaceResponseStream>(ResponseDecoder.ToSharedRef());
+	}
+#endif
+
+	if (bCanCoalesce)
+	{
+		InFlightGETRequests.Add(CoalescingKey, Context);
+	}
+
+	// Once an entry is in memory the regular revalidation path is just as fast as the disk
+	const bool bLoadingFromDisk = bIsGET && bResponseCacheEnabled && DiskCache.IsCacheable(Endpoint) && !ResponseCache.Find(Context->CacheKey).IsValid();
+	if (bLoadingFromDisk)
+	{
+		LoadFromDiskCache(Context);
+	}
+
+	// Don't let the call wait for a slot only to be rejected, but give a persisted copy the chance to answer it
+	if (IsCircuitRejecting(*Context, FPlatformTime::Seconds()))
+	{
+		if (bLoadingFromDisk)
+		{
+			Context->bCircuitRejectionPending = true;
+		}
+		else
+		{
+			RejectOpenCircuit(Context);
+		}
+		return Handle;
+	}
+
+	EnqueueRequest(Context);
+	return Handle;
+}
+
+bool UCarespaceHTTPClient::CancelRequest(const FCarespaceRequestHandle& Handle)
+{
+	return CancelSubscription(Handle.GetId());
+}
+
+bool UCarespaceHTTPClient::IsRequestPending(const FCarespaceRequestHandle& Handle) const
+{
+	return Subscriptions.Contains(Handle.GetId());
+}
+
+int32 UCarespaceHTTPClient::CancelAllRequestsForOwner(const UObject* Owner)
+{
+	TArray<uint64> Ids;
+	for (const TPair<uint64, FSubscription>& Pair : Subscriptions)
+	{
+		if (Owner && Pair.Value.Owner.Get() == Owner)
+		{
+			Ids.Add(Pair.Key);
+		}
+	}
+
+	for (uint64 Id : Ids)
+	{
+		CancelSubscription(Id);
+	}
+	return Ids.Num();
+}
+
+bool UCarespaceHTTPClient::CancelSubscription(uint64 Id)
+{
+	FSubscription Subscription;
+	if (!Subscriptions.RemoveAndCopyValue(Id, Subscription))
+	{
+		return false;
+	}
+	++Stats.RequestsCancelled;
+
+	// A deferred request whose payload is still being serialized, or whose response is already being
+	// processed, has nothing to abort
+	if (!Subscription.Context.IsValid())
+	{
+		return true;
+	}
+
+	// Callbacks already handed to a dispatch are skipped there, since the subscription is gone
+	TSharedRef<FCarespaceRequestContext> Context = Subscription.Context.ToSharedRef();
+	const int32 NumRemoved = Context->Callbacks.RemoveAll([Id](const FCarespaceResponseCallback& Callback) { return Callback.Id == Id; });
+	if (NumRemoved > 0 && Context->Callbacks.Num() == 0)
+	{
+		AbortRequest(Context);
+	}
+	return true;
+}
+
+void UCarespaceHTTPClient::AbortRequest(TSharedRef<FCarespaceRequestContext> Context)
+{
+	Context->bCancelled = true;
+	++Stats.RequestsAborted;
+
+	const TSharedPtr<FCarespaceRequestContext>* Registered = Context->CoalescingKey.IsEmpty() ? nullptr : InFlightGETRequests.Find(Context->CoalescingKey);
+	if (Registered && *Registered == Context)
+	{
+		InFlightGETRequests.Remove(Context->CoalescingKey);
+	}
+
+	// A queued request just leaves its lane; an in-flight one completes through HandleResponse,
+	// which releases its slot. A request waiting to be retried is dropped when its timer fires.
+	PendingRequests[static_cast<int32>(Context->Priority)].Remove(Context);
+
+	// Only one completion may release the slot, so a hedge racing the original request is detached first
+	if (Context->HttpRequest.IsValid() && Context->HedgeRequest.IsValid())
+	{
+		FHttpRequestPtr Hedge = MoveTemp(Context->HedgeRequest);
+		Context->HedgeRequest.Reset();
+		Transport->CancelRequest(Hedge.ToSharedRef());
+	}
+
+	const FHttpRequestPtr InFlightRequest = Context->HttpRequest.IsValid() ? Context->HttpRequest : Context->HedgeRequest;
+	if (InFlightRequest.IsValid())
+	{
+		Transport->CancelRequest(InFlightRequest.ToSharedRef());
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("CarespaceHTTPClient: Aborted %s %s, no callers left"), *Context->Verb, *Context->Endpoint);
+}
+
+void UCarespaceHTTPClient::ExpireSubscription(uint64 Id, float DeadlineSeconds)
+{
+	// Requests that completed or were cancelled in time have no subscription left, and those whose
+	// response is already being processed have no request left to wait for
+	const FSubscription* Subscription = Subscriptions.Find(Id);
+	if (!Subscription || !Subscription->Context.IsValid())
+	{
+		return;
+	}
+
+	TSharedRef<FCarespaceRequestContext> Context = Subscription->Context.ToSharedRef();
+	const int32 Index = Context->Callbacks.IndexOfByPredicate([Id](const FCarespaceResponseCallback& Callback) { return Callback.Id == Id; });
+	if (Index == INDEX_NONE)
+	{
+		// Already handed to a dispatch that is about to run
+		return;
+	}
+
+	TArray<FCarespaceResponseCallback> Expired;
+	Expired.Add(Context->Callbacks[Index]);
+	Context->Callbacks.RemoveAt(Index);
+	++Stats.RequestsTimedOut;
+
+	UE_LOG(LogTemp, Warning, TEXT("CarespaceHTTPClient: %s %s exceeded its %.1fs deadline"), *Context->Verb, *Context->Endpoint, DeadlineSeconds);
+
+	if (Context->Callbacks.Num() == 0)
+	{
+		AbortRequest(Context);
+	}
+
+	FCarespaceError Error;
+	Error.ErrorType = ECarespaceErrorType::TimeoutError;
+	Error.ErrorMessage = FString::Printf(TEXT("Request did not complete within its %.1fs deadline"), DeadlineSeconds);
+	DispatchResponse(Expired, Context->Priority, false, TArray<uint8>(), Error);
+}
+
+bool UCarespaceHTTPClient::SweepDestroyedOwners(float DeltaTime)
+{
+	TArray<uint64> Ids;
+	bool bHasOwners = false;
+	for (const TPair<uint64, FSubscription>& Pair : Subscriptions)
+	{
+		if (Pair.Value.Owner.IsStale())
+		{
+			Ids.Add(Pair.Key);
+		}
+		else if (Pair.Value.Owner.IsValid())
+		{
+			bHasOwners = true;
+		}
+	}
+
+	for (uint64 Id : Ids)
+	{
+		CancelSubscription(Id);
+	}
+
+	if (!bHasOwners)
+	{
+		OwnerSweepHandle.Reset();
+	}
+	return bHasOwners;
+}
+
+void UCarespaceHTTPClient::CompressPayload(FCarespaceRequestContext& Context)
+{
+	if (RequestCompression == ECarespaceContentEncoding::None || Context.Payload.Num() < MinCompressedRequestBytes
+		|| HostsRejectingCompression.Contains(Context.Host))
+	{
+		return;
+	}
+
+	// HTTP "deflate" is the zlib format
+	const FName FormatName = RequestCompression == ECarespaceContentEncoding::Gzip ? NAME_Gzip : NAME_Zlib;
+	const int32 UncompressedSize = Context.Payload.Num();
+	int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, UncompressedSize);
+
+	TArray<uint8> Compressed;
+	Compressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(FormatName, Compressed.GetData(), CompressedSize, Context.Payload.GetData(), UncompressedSize)
+		|| CompressedSize >= UncompressedSize)
+	{
+		return;
+	}
+	Compressed.SetNum(CompressedSize, false);
+
+	Context.Payload = MoveTemp(Compressed);
+	Context.ContentEncoding = RequestCompression == ECarespaceContentEncoding::Gzip ? TEXT("gzip") : TEXT("deflate");
+	Context.UncompressedPayloadSize = UncompressedSize;
+
+	++Stats.RequestsCompressed;
+	Stats.RequestBytesBeforeCompression += UncompressedSize;
+	Stats.RequestBytesAfterCompression += CompressedSize;
+	Stats.RequestCompressionRatio = static_cast<float>(static_cast<double>(Stats.RequestBytesAfterCompression) / Stats.RequestBytesBeforeCompression);
+}
+
+bool UCarespaceHTTPClient::TryResendUncompressed(TSharedRef<FCarespaceRequestContext> Context, int32 ResponseCode)
+{
+	if (ResponseCode != 415 || Context->ContentEncoding.IsEmpty())
+	{
+		return false;
+	}
+
+	const FName FormatName = Context->ContentEncoding == TEXT("gzip") ? NAME_Gzip : NAME_Zlib;
+	TArray<uint8> Uncompressed;
+	Uncompressed.SetNumUninitialized(Context->UncompressedPayloadSize);
+	if (!FCompression::UncompressMemory(FormatName, Uncompressed.GetData(), Uncompressed.Num(), Context->Payload.GetData(), Context->Payload.Num()))
+	{
+		return false;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("CarespaceHTTPClient: %s does not accept %s request bodies, sending uncompressed"), *Context->Host, *Context->ContentEncoding);
+
+	HostsRejectingCompression.Add(Context->Host);
+	Context->Payload = MoveTemp(Uncompressed);
+	Context->ContentEncoding.Reset();
+	Context->UncompressedPayloadSize = 0;
+
+	EnqueueRequest(Context);
+	return true;
+}
+
+void UCarespaceHTTPClient::LoadFromDiskCache(TSharedRef<FCarespaceRequestContext> Context)
+{
+	// The file is read and decompressed on a worker while the request goes to the network; whichever
+	// answers first serves the callers
+	DiskCache.LoadAsync(Context->CacheKey, [WeakThis = TWeakObjectPtr<UCarespaceHTTPClient>(this), Context](TSharedPtr<FCarespaceCachedResponse> Entry, double AgeSeconds)
+	{
+		if (UCarespaceHTTPClient* Client = WeakThis.Get())
+		{
+			Client->ServeFromDiskCache(Context, MoveTemp(Entry), AgeSeconds);
+		}
+	});
+}
+
+void UCarespaceHTTPClient::ServeFromDiskCache(TSharedRef<FCarespaceRequestContext> Context, TSharedPtr<FCarespaceCachedResponse> Entry, double AgeSeconds)
+{
+	// No callers are left once the network answered first or every caller cancelled
+	TArray<FCarespaceResponseCallback> Callbacks;
+	const ECarespaceRequestPriority CallerPriority = Context->Priority;
+
+	if (Entry.IsValid() && !Context->bCancelled && Context->Callbacks.Num() > 0)
+	{
+		// Even a too-old entry is useful as a validator, if the request has not been sent yet
+		if (!ResponseCache.Find(Context->CacheKey).IsValid())
+		{
+			ResponseCache.Store(Context->CacheKey, Entry.ToSharedRef());
+		}
+
+		if (AgeSeconds <= DiskCache.GetSettings().MaxStaleSeconds)
+		{
+			// Answer the current callers now; the request continues as a background refresh whose result
+			// only updates the caches (and any caller that attaches to it later)
+			Callbacks = MoveTemp(Context->Callbacks);
+			const bool bQueued = PendingRequests[static_cast<int32>(Context->Priority)].Remove(Context) > 0;
+			Context->Priority = ECarespaceRequestPriority::Background;
+			if (bQueued)
+			{
+				EnqueueRequest(Context);
+			}
+
+			// The caller's decoder leaves with its callback; the refresh must not write into it while it is being read
+			if (Context->ResponseStream.IsValid())
+			{
+				Context->ResponseStream->DetachDecoder();
+			}
+			++Stats.ResponsesServedFromDisk;
+		}
+	}
+
+	// Callers the persisted copy could not answer fail fast now
+	if (Context->bCircuitRejectionPending)
+	{
+		Context->bCircuitRejectionPending = false;
+		if (!Context->bCancelled)
+		{
+			RejectOpenCircuit(Context);
+		}
+	}
+
+	if (Callbacks.Num() > 0)
+	{
+		DispatchResponse(Callbacks, CallerPriority, true, Entry->Body, FCarespaceError());
+	}
+}
+
+void UCarespaceHTTPClient::EnqueueRequest(TSharedRef<FCarespaceRequestContext> Context)
+{
+	PendingRequests[static_cast<int32>(Context->Priority)].Add(Context);
+	PumpRequestQueue();
+
+	Stats.PeakQueueDepth = FMath::Max(Stats.PeakQueueDepth, GetTotalQueueDepth());
+}
+
+void UCarespaceHTTPClient::PumpRequestQueue()
+{
+	const double Now = FPlatformTime::Seconds();
+	double ShortestWait = TNumericLimits<double>::Max();
+
+	// Queued calls behind an open circuit fail now instead of waiting for a slot
+	if (CircuitBreaker.HasOpenCircuits())
+	{
+		TArray<TSharedRef<FCarespaceRequestContext>> Rejected;
+		for (TArray<TSharedRef<FCarespaceRequestContext>>& Lane : PendingRequests)
+		{
+			for (int32 Index = Lane.Num() - 1; Index >= 0; --Index)
+			{
+				if (IsCircuitRejecting(*Lane[Index], Now))
+				{
+					Rejected.Add(Lane[Index]);
+					Lane.RemoveAt(Index);
+				}
+			}
+		}
+
+		for (const TSharedRef<FCarespaceRequestContext>& Context : Rejected)
+		{
+			RejectOpenCircuit(Context);
+		}
+	}
+
+	while (MaxConcurrentRequests <= 0 || ActiveRequestCount < MaxConcurrentRequests)
+	{
+		// Take the oldest request of the highest-priority lane whose host and rate limit bucket allow it
+		TSharedPtr<FCarespaceRequestContext> NextRequest;
+		for (TArray<TSharedRef<FCarespaceRequestContext>>& Lane : PendingRequests)
+		{
+			const int32 Index = Lane.IndexOfByPredicate([this, Now, &ShortestWait](const TSharedRef<FCarespaceRequestContext>& Pending)
+			{
+				double WaitSeconds = 0.0;
+				const bool bCanStart = CanStartRequest(*Pending, Now, WaitSeconds);
+				if (WaitSeconds > 0.0)
+				{
+					ShortestWait = FMath::Min(ShortestWait, WaitSeconds);
+				}
+				return bCanStart;
+			});
+
+			if (Index != INDEX_NONE)
+			{
+				NextRequest = Lane[Index];
+				Lane.RemoveAt(Index);
+				break;
+			}
+		}
+
+		if (!NextRequest.IsValid())
+		{
+			break;
+		}
+
+		// The last probe slot of a half-open circuit may have been taken by an earlier request of this pass
+		if (!AdmitThroughCircuits(*NextRequest, Now))
+		{
+			RejectOpenCircuit(NextRequest.ToSharedRef());
+			continue;
+		}
+
+		StartRequest(NextRequest.ToSharedRef());
+	}
+
+	if (ShortestWait < TNumericLimits<double>::Max() && GetTotalQueueDepth() > 0)
+	{
+		ScheduleQueueWakeUp(ShortestWait);
+	}
+}
+
+bool UCarespaceHTTPClient::CanStartRequest(FCarespaceRequestContext& Context, double Now, double& OutWaitSeconds)
+{
+	OutWaitSeconds = 0.0;
+
+	if (MaxConcurrentRequestsPerHost > 0)
+	{
+		const int32* HostCount = ActiveRequestsPerHost.Find(Context.Host);
+		if (HostCount && *HostCount >= MaxConcurrentRequestsPerHost)
+		{
+			// A completing request will pump the queue again, no timed wake-up needed
+			return false;
+		}
+	}
+
+	if (bRateLimitingEnabled)
+	{
+		OutWaitSeconds = RateLimiter.GetWaitTime(Context.RateLimitClass, Now);
+		if (OutWaitSeconds > 0.0)
+		{
+			if (!Context.bWasRateLimited)
+			{
+				Context.bWasRateLimited = true;
+				++Stats.RequestsRateLimited;
+			}
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UCarespaceHTTPClient::ScheduleQueueWakeUp(double DelaySeconds)
+{
+	const double WakeUpTime = FPlatformTime::Seconds() + DelaySeconds;
+
+	// Keep an earlier wake-up if one is already pending
+	if (QueueWakeUpHandle.IsValid())
+	{
+		if (QueueWakeUpTime <= WakeUpTime)
+		{
+			return;
+		}
+		FTSTicker::GetCoreTicker().RemoveTicker(QueueWakeUpHandle);
+	}
+
+	QueueWakeUpTime = WakeUpTime;
+	QueueWakeUpHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float DeltaTime)
+	{
+		QueueWakeUpHandle.Reset();
+		PumpRequestQueue();
+		return false;
+	}), static_cast<float>(DelaySeconds));
+}
+
+bool UCarespaceHTTPClient::IsCircuitRejecting(const FCarespaceRequestContext& Context, double Now) const
+{
+	return CircuitBreaker.GetSettings().bEnabled
+		&& (CircuitBreaker.IsRejecting(Context.Host, Now) || CircuitBreaker.IsRejecting(Context.LatencyKey, Now));
+}
+
+bool UCarespaceHTTPClient::AdmitThroughCircuits(FCarespaceRequestContext& Context, double Now)
+{
+	if (!CircuitBreaker.GetSettings().bEnabled)
+	{
+		return true;
+	}
+
+	if (!CircuitBreaker.TryAdmit(Context.Host, Now, Context.bHostCircuitProbe))
+	{
+		return false;
+	}
+
+	if (!CircuitBreaker.TryAdmit(Context.LatencyKey, Now, Context.bFamilyCircuitProbe))
+	{
+		ReleaseCircuitProbes(Context);
+		return false;
+	}
+
+	return true;
+}
+
+void UCarespaceHTTPClient::RecordCircuitOutcome(FCarespaceRequestContext& Context, int32 ResponseCode)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// No answer at all says the host is unreachable; a 5xx only says this part of the API is failing.
+	// Anything else, including 4xx, comes from a healthy backend.
+	if (ResponseCode == 0)
+	{
+		CircuitBreaker.RecordFailure(Context.Host, Now, Context.bHostCircuitProbe);
+		CircuitBreaker.RecordFailure(Context.LatencyKey, Now, Context.bFamilyCircuitProbe);
+	}
+	else if (ResponseCode >= 500)
+	{
+		CircuitBreaker.RecordSuccess(Context.Host, Now, Context.bHostCircuitProbe);
+		CircuitBreaker.RecordFailure(Context.LatencyKey, Now, Context.bFamilyCircuitProbe);
+	}
+	else
+	{
+		CircuitBreaker.RecordSuccess(Context.Host, Now, Context.bHostCircuitProbe);
+		CircuitBreaker.RecordSuccess(Context.LatencyKey, Now, Context.bFamilyCircuitProbe);
+	}
+
+	Context.bHostCircuitProbe = false;
+	Context.bFamilyCircuitProbe = false;
+}
+
+void UCarespaceHTTPClient::ReleaseCircuitProbes(FCarespaceRequestContext& Context)
+{
+	if (Context.bHostCircuitProbe)
+	{
+		CircuitBreaker.ReleaseProbe(Context.Host);
+	}
+	if (Context.bFamilyCircuitProbe)
+	{
+		CircuitBreaker.ReleaseProbe(Context.LatencyKey);
+	}
+
+	Context.bHostCircuitProbe = false;
+	Context.bFamilyCircuitProbe = false;
+}
+
+void UCarespaceHTTPClient::RejectOpenCircuit(TSharedRef<FCarespaceRequestContext> Context)
+{
+	Context->bCancelled = true;
+
+	const TSharedPtr<FCarespaceRequestContext>* Registered = Context->CoalescingKey.IsEmpty() ? nullptr : InFlightGETRequests.Find(Context->CoalescingKey);
+	if (Registered && *Registered == Context)
+	{
+		InFlightGETRequests.Remove(Context->CoalescingKey);
+	}
+
+	TArray<FCarespaceResponseCallback> Callbacks = MoveTemp(Context->Callbacks);
+	Stats.RequestsRejectedByCircuit += Callbacks.Num();
+
+	UE_LOG(LogTemp, Verbose, TEXT("CarespaceHTTPClient: Circuit open, failing %s %s fast"), *Context->Verb, *Context->Endpoint);
+
+	const FCarespaceError Error(ECarespaceErrorType::CircuitOpenError,
+		FString::Printf(TEXT("%s is unavailable; failing fast until it recovers"), *Context->LatencyKey));
+
+	// Report later, like any other response, so callers never run inside their own send call
+	FCarespaceCompletionDispatcher::Dispatch(Context->Priority, [WeakThis = TWeakObjectPtr<UCarespaceHTTPClient>(this), Callbacks = MoveTemp(Callbacks), Priority = Context->Priority, Error]()
+	{
+		if (UCarespaceHTTPClient* Client = WeakThis.Get())
+		{
+			Client->DispatchResponse(Callbacks, Priority, false, TArray<uint8>(), Error);
+		}
+	});
+}
+
+void UCarespaceHTTPClient::ReleaseRequestSlot(const FCarespaceRequestContext& Context)
+{
+	ActiveRequestCount = FMath::Max(0, ActiveRequestCount - 1);
+
+	if (int32* HostCount = ActiveRequestsPerHost.Find(Context.Host))
+	{
+		if (--(*HostCount) <= 0)
+		{
+			ActiveRequestsPerHost.Remove(Context.Host);
+		}
+	}
+}
+
+void UCarespaceHTTPClient::StartRequest(TSharedRef<FCarespaceRequestContext> Context)
+{
+	++ActiveRequestCount;
+	++ActiveRequestsPerHost.FindOrAdd(Context->Host);
+
+	if (bRateLimitingEnabled)
+	{
+		RateLimiter.ConsumeToken(Context->RateLimitClass, FPlatformTime::Seconds());
+	}
+
+	// An attempt never outlives the deadline of the callers waiting on it
+	const double Now = FPlatformTime::Seconds();
+	float Timeout = Context->AttemptTimeoutSeconds;
+	if (Context->DeadlineTime > 0.0)
+	{
+		Timeout = FMath::Min(Timeout, static_cast<float>(FMath::Max(Context->DeadlineTime - Now, 0.1)));
+	}
+	Context->AttemptStartTime = Now;
+	Context->CurrentAttemptTimeout = Timeout;
+	Context->bAttemptTimedOut = false;
+	++Context->AttemptNumber;
+
+	// Revalidate a cached copy instead of downloading the body again
+	Context->RevalidatedResponse = (bResponseCacheEnabled && !Context->CacheKey.IsEmpty()) ? ResponseCache.Find(Context->CacheKey) : nullptr;
+
+	// A retry starts decoding from scratch; the previous attempt's HTTP thread is done with the stream
+	if (Context->ResponseStream.IsValid())
+	{
+		Context->ResponseStream->Reset();
+	}
+
+	TSharedRef<IHttpRequest> Request = CreateHttpRequest(Context, Timeout);
+	Context->HttpRequest = Request;
+
+	// The HTTP module reports its own timeout as a plain failure, so the attempt is timed here
+	Context->AttemptTimerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, Context, AttemptNumber = Context->AttemptNumber](float DeltaTime)
+	{
+		TimeOutAttempt(Context, AttemptNumber);
+		return false;
+	}), Timeout);
+
+	Transport->ProcessRequest(Request, FOnCarespaceTransportComplete::CreateUObject(this, &UCarespaceHTTPClient::HandleResponse, Context));
+	LastRequestTime = Now;
+	++Stats.RequestsSent;
+
+	// Two transfers cannot feed one decoder, so streamed requests are never hedged
+	if (HedgingPolicy.bEnabled && Context->Verb == TEXT("GET") && !Context->ResponseStream.IsValid())
+	{
+		ScheduleHedge(Context);
+	}
+}
+
+void UCarespaceHTTPClient::TimeOutAttempt(TSharedRef<FCarespaceRequestContext> Context, int32 AttemptNumber)
+{
+	// The attempt may have completed, or been followed by a retry, while the timer was pending
+	if (Context->bCancelled || Context->AttemptNumber != AttemptNumber || (!Context->HttpRequest.IsValid() && !Context->HedgeRequest.IsValid()))
+	{
+		return;
+	}
+
+	Context->AttemptTimerHandle.Reset();
+	Context->bAttemptTimedOut = true;
+	UE_LOG(LogTemp, Verbose, TEXT("CarespaceHTTPClient: %s %s timed out after %.1fs"), *Context->Verb, *Context->Endpoint, Context->CurrentAttemptTimeout);
+
+	// Only one completion may release the slot, so a hedge racing the original request is detached first
+	if (Context->HttpRequest.IsValid() && Context->HedgeRequest.IsValid())
+	{
+		FHttpRequestPtr Hedge = MoveTemp(Context->HedgeRequest);
+		Context->HedgeRequest.Reset();
+		Transport->CancelRequest(Hedge.ToSharedRef());
+	}
+
+	// The cancelled request completes through HandleResponse, which reports the timeout or retries
+	const FHttpRequestPtr InFlightRequest = Context->HttpRequest.IsValid() ? Context->HttpRequest : Context->HedgeRequest;
+	Transport->CancelRequest(InFlightRequest.ToSharedRef());
+}
+
+TSharedRef<IHttpRequest> UCarespaceHTTPClient::CreateHttpRequest(TSharedRef<FCarespaceRequestContext> Context, float Timeout)
+{
+	// The attempt timer cancels the request on time; the module's own timeout only backs it up
+	TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
+	ConfigureRequest(Request, Context->Verb, Context->URL, Timeout + AttemptTimeoutGraceSeconds, Context->bSendCredentials);
+
+	if (Context->Payload.Num() > 0)
+	{
+		Request->SetContent(Context->Payload);
+
+		if (!Context->ContentEncoding.IsEmpty())
+		{
+			Request->SetHeader(TEXT("Content-Encoding"), Context->ContentEncoding);
+		}
+	}
+
+	if (Context->RevalidatedResponse.IsValid())
+	{
+		if (!Context->RevalidatedResponse->ETag.IsEmpty())
+		{
+			Request->SetHeader(TEXT("If-None-Match"), Context->RevalidatedResponse->ETag);
+		}
+		if (!Context->RevalidatedResponse->LastModified.IsEmpty())
+		{
+			Request->SetHeader(TEXT("If-Modified-Since"), Context->RevalidatedResponse->LastModified);
+		}
+	}
+
+#if CARESPACE_WITH_RESPONSE_STREAM
+	if (Context->ResponseStream.IsValid())
+	{
+		Request->SetResponseBodyReceiveStream(Context->ResponseStream.ToSharedRef());
+	}
+#endif
+
+	return Request;
+}
+
+void UCarespaceHTTPClient::ScheduleHedge(TSharedRef<FCarespaceRequestContext> Context)
+{
+	HedgeBudgetTokens = FMath::Min(HedgingPolicy.MaxBudgetTokens, HedgeBudgetTokens + HedgingPolicy.BudgetRatio);
+
+	// Families without enough history are never hedged; there is no basis for calling a response slow
+	double HedgeDelay = 0.0;
+	if (!LatencyTracker.GetPercentile(Context->LatencyKey, HedgingPolicy.LatencyPercentile, HedgingPolicy.MinSamples, HedgeDelay))
+	{
+		return;
+	}
+	HedgeDelay = FMath::Max<double>(HedgeDelay, HedgingPolicy.MinDelaySeconds);
+
+	if (HedgeDelay >= Context->CurrentAttemptTimeout)
+	{
+		return;
+	}
+
+	TWeakPtr<IHttpRequest, ESPMode::ThreadSafe> Attempt = Context->HttpRequest;
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, Context, Attempt](float DeltaTime)
+	{
+		// Only hedge the attempt the timer was started for, and only while it is still outstanding
+		if (!Context->bCancelled && Context->HttpRequest.IsValid() && Context->HttpRequest == Attempt.Pin() && !Context->HedgeRequest.IsValid())
+		{
+			SendHedge(Context);
+		}
+		return false;
+	}), static_cast<float>(HedgeDelay));
 }
 
-void UCarespaceHTTPClient::SetBaseURL(const FString& InBaseURL)
+void UCarespaceHTTPClient::SendHedge(TSharedRef<FCarespaceRequestContext> Context)
 {
-	BaseURL = InBaseURL;
+	// Doubling traffic to a backend that is already failing only makes things worse
+	if (CircuitBreaker.GetState(Context->Host) != ECarespaceCircuitState::Closed || CircuitBreaker.GetState(Context->LatencyKey) != ECarespaceCircuitState::Closed)
+	{
+		return;
+	}
+
+	if (HedgeBudgetTokens < 1.0f)
+	{
+		++Stats.HedgesDroppedByBudget;
+		return;
+	}
+
+	// A hedge must not push the client over its rate limit
+	const double Now = FPlatformTime::Seconds();
+	if (bRateLimitingEnabled)
+	{
+		if (RateLimiter.GetWaitTime(Context->RateLimitClass, Now) > 0.0)
+		{
+			return;
+		}
+		RateLimiter.ConsumeToken(Context->RateLimitClass, Now);
+	}
+
+	HedgeBudgetTokens -= 1.0f;
+	const float Timeout = FMath::Max(0.1f, Context->CurrentAttemptTimeout - static_cast<float>(Now - Context->AttemptStartTime));
+
+	TSharedRef<IHttpRequest> Request = CreateHttpRequest(Context, Timeout);
+	Context->HedgeRequest = Request;
+	Context->HedgeStartTime = Now;
+	Transport->ProcessRequest(Request, FOnCarespaceTransportComplete::CreateUObject(this, &UCarespaceHTTPClient::HandleResponse, Context));
+	++Stats.HedgesSent;
+
+	UE_LOG(LogTemp, Verbose, TEXT("CarespaceHTTPClient: Hedging %s %s after %.2fs"), *Context->Verb, *Context->Endpoint, Now - Context->AttemptStartTime);
 }
 
-void UCarespaceHTTPClient::SetAPIKey(const FString& InAPIKey)
+FString UCarespaceHTTPClient::MakeRequestKey(const FString& Verb, const FString& URL) const
 {
-	APIKey = InAPIKey;
+	// The credential is hashed so that requests made on behalf of different users never share a
+	// response, without keeping another copy of the raw key around
+	TStringBuilder<512> Key;
+	Key << Verb << TEXT(' ') << URL;
+	Key << TEXT(" #") << APIKeyHash;
+	return FString(Key.ToView());
 }
 
-void UCarespaceHTTPClient::SetTimeout(float InTimeoutSeconds)
+FString UCarespaceHTTPClient::MakeCacheKey(const FString& URL) const
 {
-	TimeoutSeconds = InTimeoutSeconds;
+	// Cached responses are shared by every token of the same account
+	TStringBuilder<512> Key;
+	Key << TEXT("GET ") << URL << TEXT(" @") << CacheIdentityHash;
+	return FString(Key.ToView());
 }
 
-void UCarespaceHTTPClient::SendGETRequest(const FString& Endpoint, const TMap<FString, FString>& QueryParameters, const FOnHTTPResponse& OnComplete)
+void UCarespaceHTTPClient::ConfigureRequest(TSharedRef<IHttpRequest> Request, const FString& Verb, const FString& URL, float Timeout, bool bSendCredentials)
 {
-	TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
-	ConfigureRequest(Request, TEXT("GET"), BuildURL(Endpoint, QueryParameters));
+	Request->SetURL(URL);
+	Request->SetVerb(Verb);
+	Request->SetTimeout(Timeout);
 	
-	Request->OnProcessRequestComplete().BindUObject(this, &UCarespaceHTTPClient::HandleResponse, OnComplete);
-	Request->ProcessRequest();
+	// Set common headers, including authorization if an API key is provided and the request may carry it
+	for (const TPair<FString, FString>& Header : CommonHeaders)
+	{
+		if (bSendCredentials || Header.Key != TEXT("Authorization"))
+		{
+			Request->SetHeader(Header.Key, Header.Value);
+		}
+	}
 }
 
-void UCarespaceHTTPClient::SendPOSTRequest(const FString& Endpoint, const FString& JsonPayload, const FOnHTTPResponse& OnComplete)
+void UCarespaceHTTPClient::HandleResponse(FHttpRequestPtr Request, TSharedPtr<const ICarespaceHttpResponse> Response, TSharedRef<FCarespaceRequestContext> Context)
 {
-	TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
-	ConfigureRequest(Request, TEXT("POST"), BuildURL(Endpoint));
-	
-	if (!JsonPayload.IsEmpty())
+	// Completions of a request that lost a hedging race, or was detached from it, are ignored
+	if (Request != Context->HttpRequest && Request != Context->HedgeRequest)
 	{
-		Request->SetContentAsString(JsonPayload);
+		return;
 	}
-	
-	Request->OnProcessRequestComplete().BindUObject(this, &UCarespaceHTTPClient::HandleResponse, OnComplete);
-	Request->ProcessRequest();
+
+	const bool bIsHedge = Request == Context->HedgeRequest;
+	FHttpRequestPtr& OtherRequest = bIsHedge ? Context->HttpRequest : Context->HedgeRequest;
+	const bool bFailed = !Response.IsValid() || Response->GetResponseCode() >= 500;
+
+	// While the other request of a hedged pair is still running, a failure is not final
+	if (bFailed && OtherRequest.IsValid() && !Context->bCancelled)
+	{
+		(bIsHedge ? Context->HedgeRequest : Context->HttpRequest).Reset();
+		return;
+	}
+
+	FHttpRequestPtr LosingRequest = MoveTemp(OtherRequest);
+	Context->HttpRequest.Reset();
+	Context->HedgeRequest.Reset();
+
+	if (Context->AttemptTimerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(Context->AttemptTimerHandle);
+		Context->AttemptTimerHandle.Reset();
+	}
+	if (LosingRequest.IsValid())
+	{
+		Transport->CancelRequest(LosingRequest.ToSharedRef());
+		Stats.HedgesWon += bIsHedge ? 1 : 0;
+	}
+
+	ReleaseRequestSlot(*Context);
+
+	if (Context->bCancelled)
+	{
+		ReleaseCircuitProbes(*Context);
+		PumpRequestQueue();
+		return;
+	}
+
+	if (Response.IsValid())
+	{
+		UpdateRateLimits(*Context, *Response);
+	}
+
+	const int32 ResponseCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+	RecordCircuitOutcome(*Context, ResponseCode);
+	const bool bNotModified = ResponseCode == 304 && Context->RevalidatedResponse.IsValid();
+	const bool bSucceeded = (ResponseCode >= 200 && ResponseCode < 300) || bNotModified;
+
+	if (bSucceeded && Context->Verb == TEXT("GET"))
+	{
+		LatencyTracker.AddSample(Context->LatencyKey, FPlatformTime::Seconds() - (bIsHedge ? Context->HedgeStartTime : Context->AttemptStartTime));
+	}
+
+	// A retried request stays registered for coalescing so that new callers keep attaching to it
+	if (!bSucceeded && (TryResendUncompressed(Context, ResponseCode) || TryScheduleRetry(Context, Response.Get())))
+	{
+		PumpRequestQueue();
+		return;
+	}
+
+	if (bSucceeded && Context->RetryCount == 0)
+	{
+		RetryBudgetTokens = FMath::Min(RetryBudgetMaxTokens, RetryBudgetTokens + RetryBudgetRatio);
+	}
+
+	// Unregister before dispatching so that a callback issuing the same GET starts a fresh request
+	if (!Context->CoalescingKey.IsEmpty())
+	{
+		InFlightGETRequests.Remove(Context->CoalescingKey);
+	}
+
+	// Keep the cached entry alive while callers read its body
+	TSharedPtr<const FCarespaceCachedResponse> RevalidatedResponse = MoveTemp(Context->RevalidatedResponse);
+	TArray<uint8> DecodedBody;
+	const TArray<uint8>* Body = &DecodedBody;
+	FCarespaceError Error;
+	bool bDecodeFailed = false;
+
+	if (bNotModified)
+	{
+		if (DiskCache.IsCacheable(Context->Endpoint))
+		{
+			DiskCache.Touch(Context->CacheKey);
+		}
+
+		Body = &RevalidatedResponse->Body;
+		++Stats.ResponsesNotModified;
+		Stats.BytesSavedByRevalidation += Body->Num();
+	}
+	else if (Response.IsValid())
+	{
+		// Uncompressed bodies are read in place; only decoded bodies need a buffer of their own.
+		// A streamed body never reaches the response's content buffer; transports that cannot stream leave the stream empty.
+		const TArray<uint8>& Content = (Context->ResponseStream.IsValid() && Response->GetContent().Num() == 0) ? Context->ResponseStream->GetBody() : Response->GetContent();
+		bool bDecoded = false;
+		bDecodeFailed = !DecodeResponseBody(*Response, Content, DecodedBody, bDecoded);
+		Body = bDecoded || bDecodeFailed ? &DecodedBody : &Content;
+
+		if (bSucceeded && Context->ResponseStream.IsValid() && Context->ResponseStream->IsDecoderComplete())
+		{
+			++Stats.ResponsesStreamed;
+		}
+
+		if (bSucceeded && !bDecodeFailed && bResponseCacheEnabled && !Context->CacheKey.IsEmpty())
+		{
+			StoreInResponseCache(*Context, *Response, *Body);
+		}
+	}
+
+	if (!bSucceeded)
+	{
+		Error = ProcessError(Response.Get(), *Body);
+
+		// One request timed out, however many callers were waiting on it
+		if (!Response.IsValid() && Context->bAttemptTimedOut)
+		{
+			Error.ErrorType = ECarespaceErrorType::TimeoutError;
+			Error.ErrorMessage = FString::Printf(TEXT("Request timed out after %.1fs"), Context->CurrentAttemptTimeout);
+			++Stats.RequestsTimedOut;
+		}
+	}
+	else if (bDecodeFailed)
+	{
+		// The body was compressed because we asked for it; passing the raw bytes on would only fail later in the parser
+		Error = FCarespaceError(ECarespaceErrorType::NetworkError, TEXT("Response body could not be decoded"), ResponseCode);
+	}
+
+	// Move the callbacks out so that a callback cancelling another request cannot modify the array being dispatched
+	const TArray<FCarespaceResponseCallback> Callbacks = MoveTemp(Context->Callbacks);
+	DispatchResponse(Callbacks, Context->Priority, bSucceeded && !bDecodeFailed, *Body, Error);
+
+	PumpRequestQueue();
 }
 
-void UCarespaceHTTPClient::SendPUTRequest(const FString& Endpoint, const FString& JsonPayload, const FOnHTTPResponse& OnComplete)
+void UCarespaceHTTPClient::StoreInResponseCache(const FCarespaceRequestContext& Context, const ICarespaceHttpResponse& Response, const TArray<uint8>& Body)
 {
-	TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
-	ConfigureRequest(Request, TEXT("PUT"), BuildURL(Endpoint));
-	
-	if (!JsonPayload.IsEmpty())
+	const FString ETag = Response.GetHeader(TEXT("ETag"));
+	const FString LastModified = Response.GetHeader(TEXT("Last-Modified"));
+	const FString CacheControl = Response.GetHeader(TEXT("Cache-Control"));
+
+	// Without a validator there is nothing to revalidate against
+	if ((ETag.IsEmpty() && LastModified.IsEmpty()) || CacheControl.Contains(TEXT("no-store")))
 	{
-		Request->SetContentAsString(JsonPayload);
+		ResponseCache.Remove(Context.CacheKey);
+		return;
+	}
+
+	TSharedRef<FCarespaceCachedResponse> Entry = MakeShared<FCarespaceCachedResponse>();
+	Entry->ETag = ETag;
+	Entry->LastModified = LastModified;
+	Entry->Body = Body;
+	ResponseCache.Store(Context.CacheKey, Entry);
+
+	if (DiskCache.IsCacheable(Context.Endpoint))
+	{
+		DiskCache.StoreAsync(Context.CacheKey, Entry);
 	}
-	
-	Request->OnProcessRequestComplete().BindUObject(this, &UCarespaceHTTPClient::HandleResponse, OnComplete);
-	Request->ProcessRequest();
 }
 
-void UCarespaceHTTPClient::SendDELETERequest(const FString& Endpoint, const FOnHTTPResponse& OnComplete)
+FString UCarespaceHTTPClient::BytesToString(const TArray<uint8>& Bytes)
 {
-	TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
-	ConfigureRequest(Request, TEXT("DELETE"), BuildURL(Endpoint));
-	
-	Request->OnProcessRequestComplete().BindUObject(this, &UCarespaceHTTPClient::HandleResponse, OnComplete);
-	Request->ProcessRequest();
+	// Same conversion as IHttpResponse::GetContentAsString, usable on bodies we hold ourselves
+	const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+	return FString(Converter.Length(), Converter.Get());
 }
 
-void UCarespaceHTTPClient::ConfigureRequest(TSharedRef<IHttpRequest> Request, const FString& Verb, const FString& URL)
+TArray<uint8> UCarespaceHTTPClient::StringToBytes(const FString& String)
 {
-	Request->SetURL(URL);
-	Request->SetVerb(Verb);
-	Request->SetTimeout(TimeoutSeconds);
-	
-	// Set common headers
-	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	Request->SetHeader(TEXT("Accept"), TEXT("application/json"));
-	
-	// Set authorization header if API key is provided
-	if (!APIKey.IsEmpty())
+	TArray<uint8> Bytes;
+	if (!String.IsEmpty())
 	{
-		Request->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *APIKey));
+		const FTCHARToUTF8 Converter(*String, String.Len());
+		Bytes.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
 	}
+	return Bytes;
 }
 
-void UCarespaceHTTPClient::HandleResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FOnHTTPResponse OnComplete)
+bool UCarespaceHTTPClient::DecodeResponseBody(const ICarespaceHttpResponse& Response, const TArray<uint8>& Content, TArray<uint8>& OutBody, bool& bOutDecoded)
 {
-	FString ResponseContent;
-	FCarespaceError Error;
+	bOutDecoded = false;
+
+	const FString ContentEncoding = Response.GetHeader(TEXT("Content-Encoding")).TrimStartAndEnd();
+	if (ContentEncoding.IsEmpty() || ContentEncoding.Equals(TEXT("identity"), ESearchCase::IgnoreCase) || Content.Num() == 0)
+	{
+		return true;
+	}
+
+	// Some platform HTTP stacks already decode the body but keep the header, so check the stream itself
+	const bool bIsGzip = Content.Num() >= 18 && Content[0] == 0x1f && Content[1] == 0x8b;
+	const bool bIsZlib = Content.Num() >= 6 && (Content[0] & 0x0f) == 8 && ((Content[0] << 8) | Content[1]) % 31 == 0;
+	if (!(bIsGzip && ContentEncoding.Equals(TEXT("gzip"), ESearchCase::IgnoreCase))
+		&& !(bIsZlib && ContentEncoding.Equals(TEXT("deflate"), ESearchCase::IgnoreCase)))
+	{
+		return true;
+	}
 
-	if (bWasSuccessful && Response.IsValid())
+	// The gzip trailer records the uncompressed size modulo 2^32: the real size is at least that large,
+	// so a value over the cap is refused, while a smaller one is only used to size the first buffer
+	int64 SizeHint = static_cast<int64>(Content.Num()) * 4;
+	if (bIsGzip)
 	{
-		ResponseContent = Response->GetContentAsString();
-		
-		// Check for HTTP errors
-		int32 ResponseCode = Response->GetResponseCode();
-		if (ResponseCode >= 200 && ResponseCode < 300)
+		const uint8* Trailer = Content.GetData() + Content.Num() - 4;
+		const uint32 StoredSize = Trailer[0] | (Trailer[1] << 8) | (Trailer[2] << 16) | (static_cast<uint32>(Trailer[3]) << 24);
+		if (StoredSize > static_cast<uint32>(MaxDecodedBodyBytes))
 		{
-			// Success
-			OnComplete.ExecuteIfBound(true, ResponseContent, Error);
-			return;
+			UE_LOG(LogTemp, Warning, TEXT("CarespaceHTTPClient: Refusing %s response body from %s that inflates to %u bytes"), *ContentEncoding, *Response.GetURL(), StoredSize);
+			return false;
 		}
-		else
+		SizeHint = StoredSize;
+	}
+
+	if (!InflateBody(Content, bIsGzip, SizeHint, OutBody))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CarespaceHTTPClient: Failed to decode %s response body from %s"), *ContentEncoding, *Response.GetURL());
+		return false;
+	}
+
+	bOutDecoded = true;
+	++Stats.ResponsesDecompressed;
+	Stats.ResponseBytesSavedByCompression += OutBody.Num() - Content.Num();
+	return true;
+}
+
+void UCarespaceHTTPClient::DispatchResponse(const TArray<FCarespaceResponseCallback>& Callbacks, ECarespaceRequestPriority Priority, bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error)
+{
+	TGuardValue<ECarespaceRequestPriority> PriorityGuard(DispatchPriority, Priority);
+	TGuardValue<uint64> IdGuard(DispatchingId, 0);
+	TGuardValue<TWeakObjectPtr<const UObject>> OwnerGuard(DispatchingOwner, nullptr);
+
+	// Only callers of the FString API pay for the UTF-16 conversion, and only once
+	TOptional<FString> BodyString;
+
+	for (const FCarespaceResponseCallback& Callback : Callbacks)
+	{
+		// Skip callers that cancelled, including those whose owner was destroyed since the last sweep
+		FSubscription Subscription;
+		if (!Subscriptions.RemoveAndCopyValue(Callback.Id, Subscription) || Subscription.Owner.IsStale())
+		{
+			continue;
+		}
+		DispatchingId = Callback.Id;
+		DispatchingOwner = Subscription.Owner;
+
+		if (Callback.OnCompleteBytes.IsBound())
 		{
-			Error = ProcessError(Response, bWasSuccessful);
+			Callback.OnCompleteBytes.Execute(bWasSuccessful, Body, Error);
+		}
+		else if (Callback.OnComplete.IsBound())
+		{
+			if (!BodyString.IsSet())
+			{
+				BodyString = BytesToString(Body);
+			}
+			Callback.OnComplete.Execute(bWasSuccessful, BodyString.GetValue(), Error);
 		}
 	}
-	else
+}
+
+uint64 UCarespaceHTTPClient::BeginDeferredCompletion()
+{
+	if (DispatchingId != 0)
 	{
-		Error = ProcessError(Response, bWasSuccessful);
+		Subscriptions.Add(DispatchingId, FSubscription{ nullptr, DispatchingOwner });
+	}
+	return DispatchingId;
+}
+
+bool UCarespaceHTTPClient::EndDeferredCompletion(uint64 Token)
+{
+	if (Token == 0)
+	{
+		return true;
 	}
 
-	OnComplete.ExecuteIfBound(false, ResponseContent, Error);
+	FSubscription Subscription;
+	return Subscriptions.RemoveAndCopyValue(Token, Subscription) && !Subscription.Owner.IsStale();
 }
 
-FCarespaceError UCarespaceHTTPClient::ProcessError(FHttpResponsePtr Response, bool bWasSuccessful)
+bool UCarespaceHTTPClient::TryScheduleRetry(TSharedRef<FCarespaceRequestContext> Context, const ICarespaceHttpResponse* Response)
 {
-	FCarespaceError Error;
+	const FCarespaceRetryPolicy* Policy = RetryPolicies.Find(Context->Verb);
+	if (!Policy || Context->RetryCount >= Policy->MaxRetries)
+	{
+		return false;
+	}
 
-	if (!bWasSuccessful)
+	// Classify the failure; 4xx responses other than 429 will fail the same way again
+	const int32 ResponseCode = Response ? Response->GetResponseCode() : 0;
+	const bool bShouldRetry = ResponseCode == 0 ? Policy->bRetryOnNetworkError
+		: ResponseCode == 429 ? Policy->bRetryOnRateLimited
+		: ResponseCode >= 500 ? Policy->bRetryOnServerError
+		: false;
+
+	if (!bShouldRetry)
 	{
-		Error.ErrorType = ECarespaceErrorType::NetworkError;
-		Error.ErrorMessage = TEXT("Network request failed");
-		return Error;
+		return false;
 	}
 
-	if (!Response.IsValid())
+	// Once the failures opened the circuit, report the real error now rather than a CircuitOpenError later
+	if (IsCircuitRejecting(*Context, FPlatformTime::Seconds()))
 	{
-		Error.ErrorType = ECarespaceErrorType::UnknownError;
-		Error.ErrorMessage = TEXT("Invalid response");
+		return false;
+	}
+
+	if (RetryBudgetTokens < 1.0f)
+	{
+		++Stats.RetriesDroppedByBudget;
+		UE_LOG(LogTemp, Warning, TEXT("CarespaceHTTPClient: Retry budget exhausted, not retrying %s %s"), *Context->Verb, *Context->Endpoint);
+		return false;
+	}
+
+	double Delay = Policy->GetNextDelay(Context->LastRetryDelay);
+
+	const double RetryAfter = ParseRetryAfter(Response);
+	if (RetryAfter >= 0.0)
+	{
+		if (RetryAfter > Policy->MaxDelaySeconds)
+		{
+			return false;
+		}
+		Delay = RetryAfter;
+	}
+
+	// A retry that cannot even start before the deadline would only delay the error
+	if (Context->DeadlineTime > 0.0 && FPlatformTime::Seconds() + Delay >= Context->DeadlineTime)
+	{
+		return false;
+	}
+
+	RetryBudgetTokens -= 1.0f;
+	Context->LastRetryDelay = Delay;
+	++Context->RetryCount;
+	++Stats.RetriesAttempted;
+
+	UE_LOG(LogTemp, Log, TEXT("CarespaceHTTPClient: Retrying %s %s in %.2fs (attempt %d)"), *Context->Verb, *Context->Endpoint, Delay, Context->RetryCount + 1);
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, Context](float DeltaTime)
+	{
+		if (!Context->bCancelled)
+		{
+			EnqueueRequest(Context);
+		}
+		return false;
+	}), static_cast<float>(Delay));
+
+	return true;
+}
+
+void UCarespaceHTTPClient::UpdateRateLimits(const FCarespaceRequestContext& Context, const ICarespaceHttpResponse& Response)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	const FString LimitHeader = Response.GetHeader(TEXT("X-RateLimit-Limit"));
+	const FString RemainingHeader = Response.GetHeader(TEXT("X-RateLimit-Remaining"));
+	const FString ResetHeader = Response.GetHeader(TEXT("X-RateLimit-Reset"));
+
+	if (!LimitHeader.IsEmpty() || !RemainingHeader.IsEmpty() || !ResetHeader.IsEmpty())
+	{
+		RateLimiter.UpdateFromHeaders(Context.RateLimitClass,
+			LimitHeader.IsEmpty() ? -1 : FCString::Atoi(*LimitHeader),
+			RemainingHeader.IsEmpty() ? -1 : FCString::Atoi(*RemainingHeader),
+			ResetHeader.IsEmpty() ? -1 : FCString::Atoi64(*ResetHeader),
+			Now);
+	}
+
+	if (Response.GetResponseCode() == 429)
+	{
+		RateLimiter.HandleRateLimited(Context.RateLimitClass, ParseRetryAfter(&Response), Now);
+	}
+}
+
+double UCarespaceHTTPClient::ParseRetryAfter(const ICarespaceHttpResponse* Response)
+{
+	if (!Response)
+	{
+		return -1.0;
+	}
+
+	const FString RetryAfter = Response->GetHeader(TEXT("Retry-After")).TrimStartAndEnd();
+	if (RetryAfter.IsEmpty())
+	{
+		return -1.0;
+	}
+
+	// Retry-After is either a number of seconds or an HTTP date
+	if (RetryAfter.IsNumeric())
+	{
+		return FMath::Max(0.0, FCString::Atod(*RetryAfter));
+	}
+
+	FDateTime RetryTime;
+	if (FDateTime::ParseHttpDate(RetryAfter, RetryTime))
+	{
+		return FMath::Max(0.0, (RetryTime - FDateTime::UtcNow()).GetTotalSeconds());
+	}
+
+	return -1.0;
+}
+
+FCarespaceError UCarespaceHTTPClient::ProcessError(const ICarespaceHttpResponse* Response, const TArray<uint8>& Body)
+{
+	FCarespaceError Error;
+
+	if (!Response)
+	{
+		Error.ErrorType = ECarespaceErrorType::NetworkError;
+		Error.ErrorMessage = TEXT("Network request failed");
 		return Error;
 	}
 
@@ -139,19 +1964,18 @@ FCarespaceError UCarespaceHTTPClient::ProcessError(FHttpResponsePtr Response, bo
 	Error.StatusCode = ResponseCode;
 
 	// Try to parse error message from response
-	FString ResponseContent = Response->GetContentAsString();
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseContent);
-
-	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+	FCarespaceJsonDocument Document;
+	if (Document.Parse(Body))
 	{
-		if (JsonObject->HasField(TEXT("message")))
+		const FCarespaceJsonNode* Message = Document.GetRoot().FindField("message");
+		if (!Message)
 		{
-			Error.ErrorMessage = JsonObject->GetStringField(TEXT("message"));
+			Message = Document.GetRoot().FindField("error");
 		}
-		else if (JsonObject->HasField(TEXT("error")))
+
+		if (Message)
 		{
-			Error.ErrorMessage = JsonObject->GetStringField(TEXT("error"));
+			Error.ErrorMessage = Message->AsString();
 		}
 	}
 
@@ -194,38 +2018,149 @@ FCarespaceError UCarespaceHTTPClient::ProcessError(FHttpResponsePtr Response, bo
 
 FString UCarespaceHTTPClient::BuildURL(const FString& Endpoint, const TMap<FString, FString>& QueryParameters)
 {
-	FString URL = BaseURL + Endpoint;
+	TStringBuilder<512> URL;
+	URL << BaseURL << Endpoint;
+	AppendQueryString(URL, QueryParameters);
+	return FString(URL.ToView());
+}
 
-	if (QueryParameters.Num() > 0)
+void UCarespaceHTTPClient::AppendQueryString(FStringBuilderBase& Out, const TMap<FString, FString>& QueryParameters)
+{
+	if (QueryParameters.Num() == 0)
 	{
-		TArray<FString> QueryPairs;
-		for (const auto& Param : QueryParameters)
-		{
-			if (!Param.Value.IsEmpty())
-			{
-				QueryPairs.Add(FString::Printf(TEXT("%s=%s"), 
-					*FGenericPlatformHttp::UrlEncode(Param.Key), 
-					*FGenericPlatformHttp::UrlEncode(Param.Value)));
-			}
-		}
+		return;
+	}
 
-		if (QueryPairs.Num() > 0)
+	// TMap iteration order is unspecified; sort the keys so that equivalent requests
+	// always produce the same URL and can be coalesced
+	TArray<const TPair<FString, FString>*, TInlineAllocator<8>> Pairs;
+	for (const TPair<FString, FString>& Pair : QueryParameters)
+	{
+		if (!Pair.Value.IsEmpty())
 		{
-			URL += TEXT("?") + FString::Join(QueryPairs, TEXT("&"));
+			Pairs.Add(&Pair);
 		}
 	}
+	Pairs.Sort([](const TPair<FString, FString>& A, const TPair<FString, FString>& B) { return A.Key.Compare(B.Key, ESearchCase::CaseSensitive) < 0; });
 
-	return URL;
+	TCHAR Separator = TEXT('?');
+	for (const TPair<FString, FString>* Pair : Pairs)
+	{
+		Out.AppendChar(Separator);
+		FCarespacePreparedEndpoint::AppendUrlEncoded(Out, Pair->Key);
+		Out.AppendChar(TEXT('='));
+		FCarespacePreparedEndpoint::AppendUrlEncoded(Out, Pair->Value);
+		Separator = TEXT('&');
+	}
 }
 
 FString UCarespaceHTTPClient::StructToJsonString(const UStruct* StructDefinition, const void* Struct)
 {
-	FString OutputString;
-	FJsonObjectConverter::UStructToJsonObjectString(StructDefinition, Struct, OutputString, 0, 0);
-	return OutputString;
+	return BytesToString(StructToJsonBytes(StructDefinition, Struct));
+}
+
+TArray<uint8> UCarespaceHTTPClient::StructToJsonBytes(const UStruct* StructDefinition, const void* Struct)
+{
+	TArray<uint8> Json;
+	const TSharedRef<const FCarespaceStructPlan> Plan = FCarespaceStructPlan::Get(StructDefinition);
+	if (Plan->IsSupported())
+	{
+		FCarespaceJsonWriter Writer(Json);
+		Plan->Write(Writer, Struct);
+		return Json;
+	}
+
+	// Structs the plan can't handle still go through the converter, printed as UTF-8 rather than as an FString
+	const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	if (FJsonObjectConverter::UStructToJsonObject(StructDefinition, Struct, JsonObject, 0, 0))
+	{
+#if CARESPACE_WITH_UTF8_JSON
+		FMemoryWriter Archive(Json);
+		TSharedRef<TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>> Writer = TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>::Create(&Archive);
+		FJsonSerializer::Serialize(JsonObject, Writer);
+#else
+		FString JsonString;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+		FJsonSerializer::Serialize(JsonObject, Writer);
+		const FTCHARToUTF8 Converted(*JsonString, JsonString.Len());
+		Json.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+#endif
+	}
+	return Json;
 }
 
 bool UCarespaceHTTPClient::JsonStringToStruct(const FString& JsonString, const UStruct* StructDefinition, void* OutStruct)
 {
-	return FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, StructDefinition, OutStruct, 0, 0);
-}
\ No newline at end of file
+	const FTCHARToUTF8 Utf8(*JsonString, JsonString.Len());
+	return JsonBytesToStruct(TArrayView<const uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()), StructDefinition, OutStruct);
+}
+
+bool UCarespaceHTTPClient::JsonBytesToStruct(TArrayView<const uint8> JsonBytes, const UStruct* StructDefinition, void* OutStruct)
+{
+	const TSharedRef<const FCarespaceStructPlan> Plan = FCarespaceStructPlan::Get(StructDefinition);
+	if (Plan->IsSupported())
+	{
+		FCarespaceJsonReader Reader(JsonBytes);
+		return Plan->Read(Reader, OutStruct);
+	}
+
+	TSharedPtr<FJsonObject> JsonObject = JsonBytesToObject(JsonBytes);
+	return JsonObject.IsValid() && FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), StructDefinition, OutStruct, 0, 0);
+}
+
+TSharedPtr<FJsonObject> UCarespaceHTTPClient::JsonBytesToObject(TArrayView<const uint8> JsonBytes)
+{
+#if CARESPACE_WITH_UTF8_JSON
+	// Read the UTF-8 body in place instead of widening it to an FString first
+	const FUtf8StringView JsonView(reinterpret_cast<const UTF8CHAR*>(JsonBytes.GetData()), JsonBytes.Num());
+	TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(JsonView);
+#else
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(JsonBytes.GetData()), JsonBytes.Num());
+	TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(FString(Converted.Length(), Converted.Get()));
+#endif
+
+	TSharedPtr<FJsonObject> JsonObject;
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+	{
+		return nullptr;
+	}
+	return JsonObject;
+}
+
+double FCarespaceRetryPolicy::GetNextDelay(double PreviousDelay) const
+{
+	// Decorrelated jitter: sleep = min(cap, random_between(base, previous * 3))
+	const double BaseDelay = BaseDelaySeconds;
+	const double Previous = FMath::Max(BaseDelay, PreviousDelay);
+	return FMath::Min<double>(MaxDelaySeconds, FMath::FRandRange(BaseDelay, Previous * 3.0));
+}
+
+bool FCarespaceRequestHandle::IsPending() const
+{
+	const UCarespaceHTTPClient* PinnedClient = Client.Get();
+	return PinnedClient && PinnedClient->IsRequestPending(*this);
+}
+
+bool FCarespaceRequestHandle::Cancel() const
+{
+	UCarespaceHTTPClient* PinnedClient = Client.Get();
+	return PinnedClient && PinnedClient->CancelRequest(*this);
+}
+
+FCarespaceScopedRequestPriority::FCarespaceScopedRequestPriority(UCarespaceHTTPClient* InClient, ECarespaceRequestPriority Priority)
+	: Client(InClient)
+{
+	if (InClient)
+	{
+		PreviousOverride = InClient->PriorityOverride;
+		InClient->PriorityOverride = Priority;
+	}
+}
+
+FCarespaceScopedRequestPriority::~FCarespaceScopedRequestPriority()
+{
+	if (UCarespaceHTTPClient* PinnedClient = Client.Get())
+	{
+		PinnedClient->PriorityOverride = PreviousOverride;
+	}
+}
@@ -0,0 +1,52 @@
+#include "CarespaceHttpTransport.h"
+#include "Interfaces/IHttpResponse.h"
+
+namespace
+{
+	/** Response of the HTTP module */
+	class FCarespaceModuleResponse final : public ICarespaceHttpResponse
+	{
+	public:
+		explicit FCarespaceModuleResponse(FHttpResponsePtr InResponse)
+			: Response(MoveTemp(InResponse))
+		{
+		}
+
+		virtual int32 GetResponseCode() const override { return Response->GetResponseCode(); }
+		virtual FString GetHeader(const FString& HeaderName) const override { return Response->GetHeader(HeaderName); }
+		virtual const TArray<uint8>& GetContent() const override { return Response->GetContent(); }
+		virtual FString GetURL() const override { return Response->GetURL(); }
+
+	private:
+		FHttpResponsePtr Response;
+	};
+
+	class FCarespaceModuleTransport final : public ICarespaceHttpTransport
+	{
+	public:
+		virtual void ProcessRequest(const TSharedRef<IHttpRequest>& Request, const FOnCarespaceTransportComplete& OnComplete) override
+		{
+			Request->OnProcessRequestComplete().BindLambda([OnComplete](FHttpRequestPtr CompletedRequest, FHttpResponsePtr Response, bool bWasSuccessful)
+			{
+				// A failed request may still carry a partial response; only a complete one is passed on
+				TSharedPtr<const ICarespaceHttpResponse> Received;
+				if (bWasSuccessful && Response.IsValid())
+				{
+					Received = MakeShared<FCarespaceModuleResponse>(Response);
+				}
+				OnComplete.ExecuteIfBound(CompletedRequest, Received);
+			});
+			Request->ProcessRequest();
+		}
+
+		virtual void CancelRequest(const TSharedRef<IHttpRequest>& Request) override
+		{
+			Request->CancelRequest();
+		}
+	};
+}
+
+TSharedRef<ICarespaceHttpTransport> ICarespaceHttpTransport::CreateDefault()
+{
+	return MakeShared<FCarespaceModuleTransport>();
+}
@@ -0,0 +1,788 @@
+#include "CarespaceJsonCodec.h"
+#include "CarespaceJsonIndex.h"
+#include "Algo/BinarySearch.h"
+
+namespace
+{
+	bool IsDigit(uint8 Char)
+	{
+		return Char >= '0' && Char <= '9';
+	}
+
+	/** Skips one or more digits; @return False if there was none */
+	bool SkipDigits(const uint8*& Cursor, const uint8* End)
+	{
+		const uint8* Start = Cursor;
+		while (Cursor < End && IsDigit(*Cursor))
+		{
+			++Cursor;
+		}
+		return Cursor != Start;
+	}
+
+	bool ParseHex4(const uint8* Hex, const uint8* End, uint32& OutValue)
+	{
+		if (End - Hex < 4)
+		{
+			return false;
+		}
+
+		OutValue = 0;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			const uint8 Char = Hex[Index];
+			uint32 Digit;
+			if (Char >= '0' && Char <= '9')
+			{
+				Digit = Char - '0';
+			}
+			else if (Char >= 'a' && Char <= 'f')
+			{
+				Digit = Char - 'a' + 10;
+			}
+			else if (Char >= 'A' && Char <= 'F')
+			{
+				Digit = Char - 'A' + 10;
+			}
+			else
+			{
+				return false;
+			}
+			OutValue = (OutValue << 4) | Digit;
+		}
+		return true;
+	}
+
+	template <typename AllocatorType>
+	void AppendCodePoint(TArray<UTF8CHAR, AllocatorType>& Out, uint32 CodePoint)
+	{
+		if (CodePoint < 0x80)
+		{
+			Out.Add(static_cast<UTF8CHAR>(CodePoint));
+		}
+		else if (CodePoint < 0x800)
+		{
+			Out.Add(static_cast<UTF8CHAR>(0xC0 | (CodePoint >> 6)));
+			Out.Add(static_cast<UTF8CHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Out.Add(static_cast<UTF8CHAR>(0xE0 | (CodePoint >> 12)));
+			Out.Add(static_cast<UTF8CHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add(static_cast<UTF8CHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Out.Add(static_cast<UTF8CHAR>(0xF0 | (CodePoint >> 18)));
+			Out.Add(static_cast<UTF8CHAR>(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Out.Add(static_cast<UTF8CHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add(static_cast<UTF8CHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+}
+
+FCarespaceJsonReader::FCarespaceJsonReader(TArrayView<const uint8> InJson)
+	: Cursor(InJson.GetData())
+	, End(InJson.GetData() + InJson.Num())
+	, Index(nullptr)
+	, IndexCursor(0)
+	, bFirstInContainer(false)
+	, bError(false)
+{
+}
+
+FCarespaceJsonReader::FCarespaceJsonReader(TArrayView<const uint8> InJson, const FCarespaceJsonIndex& InIndex)
+	: FCarespaceJsonReader(InJson)
+{
+	Index = &InIndex;
+	IndexCursor = Algo::LowerBound(InIndex.GetStructurals(), static_cast<uint32>(InJson.GetData() - InIndex.GetJson().GetData()));
+}
+
+const uint8* FCarespaceJsonReader::SeekIndexed()
+{
+	const TConstArrayView<uint32> Structurals = Index->GetStructurals();
+	const uint8* Document = Index->GetJson().GetData();
+	while (IndexCursor < Structurals.Num() && Document + Structurals[IndexCursor] < Cursor)
+	{
+		++IndexCursor;
+	}
+
+	const uint8* Next = IndexCursor < Structurals.Num() ? Document + Structurals[IndexCursor] : nullptr;
+	return Next && Next < End ? Next : nullptr;
+}
+
+void FCarespaceJsonReader::SkipWhitespace()
+{
+	while (Cursor < End && (*Cursor == ' ' || *Cursor == '\n' || *Cursor == '\r' || *Cursor == '\t'))
+	{
+		++Cursor;
+	}
+}
+
+bool FCarespaceJsonReader::Fail()
+{
+	bError = true;
+	return false;
+}
+
+bool FCarespaceJsonReader::IsAtEnd()
+{
+	SkipWhitespace();
+	return Cursor == End;
+}
+
+ECarespaceJsonValueType FCarespaceJsonReader::PeekType()
+{
+	SkipWhitespace();
+	if (Cursor == End)
+	{
+		return ECarespaceJsonValueType::None;
+	}
+
+	switch (*Cursor)
+	{
+	case '{':
+		return ECarespaceJsonValueType::Object;
+	case '[':
+		return ECarespaceJsonValueType::Array;
+	case '"':
+		return ECarespaceJsonValueType::String;
+	case 't':
+	case 'f':
+		return ECarespaceJsonValueType::Bool;
+	case 'n':
+		return ECarespaceJsonValueType::Null;
+	default:
+		return (*Cursor == '-' || (*Cursor >= '0' && *Cursor <= '9')) ? ECarespaceJsonValueType::Number : ECarespaceJsonValueType::None;
+	}
+}
+
+bool FCarespaceJsonReader::ReadObjectStart()
+{
+	SkipWhitespace();
+	if (Cursor == End || *Cursor != '{')
+	{
+		return Fail();
+	}
+	++Cursor;
+	bFirstInContainer = true;
+	return true;
+}
+
+bool FCarespaceJsonReader::ReadArrayStart()
+{
+	SkipWhitespace();
+	if (Cursor == End || *Cursor != '[')
+	{
+		return Fail();
+	}
+	++Cursor;
+	bFirstInContainer = true;
+	return true;
+}
+
+bool FCarespaceJsonReader::ReadSeparator(uint8 Close)
+{
+	SkipWhitespace();
+	if (Cursor == End)
+	{
+		return Fail();
+	}
+
+	if (*Cursor == Close)
+	{
+		++Cursor;
+		bFirstInContainer = false;
+		return false;
+	}
+
+	if (!bFirstInContainer)
+	{
+		if (*Cursor != ',')
+		{
+			return Fail();
+		}
+		++Cursor;
+	}
+
+	bFirstInContainer = false;
+	return true;
+}
+
+bool FCarespaceJsonReader::ReadNextKey(TArrayView<const uint8>& OutKey)
+{
+	if (!ReadSeparator('}'))
+	{
+		return false;
+	}
+
+	bool bHasEscapes = false;
+	if (!ReadRawString(OutKey, bHasEscapes))
+	{
+		return false;
+	}
+
+	SkipWhitespace();
+	if (Cursor == End || *Cursor != ':')
+	{
+		return Fail();
+	}
+	++Cursor;
+	return true;
+}
+
+bool FCarespaceJsonReader::ReadNextElement()
+{
+	return ReadSeparator(']');
+}
+
+bool FCarespaceJsonReader::ReadRawString(TArrayView<const uint8>& OutRaw, bool& bOutHasEscapes)
+{
+	SkipWhitespace();
+	if (Cursor == End || *Cursor != '"')
+	{
+		return Fail();
+	}
+
+	const uint8* Start = ++Cursor;
+	bOutHasEscapes = false;
+
+	// Nothing is indexed inside a string, so the next indexed character is its closing quote
+	if (Index)
+	{
+		const uint8* Close = SeekIndexed();
+		if (!Close || *Close != '"')
+		{
+			return Fail();
+		}
+
+		const uint8* Document = Index->GetJson().GetData();
+		bOutHasEscapes = Index->HasBackslash(static_cast<int32>(Start - Document), static_cast<int32>(Close - Document));
+		OutRaw = TArrayView<const uint8>(Start, static_cast<int32>(Close - Start));
+		Cursor = Close + 1;
+		++IndexCursor;
+		return true;
+	}
+
+	while (Cursor < End)
+	{
+		const uint8 Char = *Cursor;
+		if (Char == '"')
+		{
+			OutRaw = TArrayView<const uint8>(Start, static_cast<int32>(Cursor - Start));
+			++Cursor;
+			return true;
+		}
+
+		if (Char == '\\')
+		{
+			if (End - Cursor < 2)
+			{
+				break;
+			}
+			bOutHasEscapes = true;
+			Cursor += 2;
+			continue;
+		}
+
+		if (Char < 0x20)
+		{
+			return Fail();
+		}
+		++Cursor;
+	}
+
+	return Fail();
+}
+
+bool FCarespaceJsonReader::ReadString(FString& OutValue)
+{
+	TArrayView<const uint8> Raw;
+	bool bHasEscapes = false;
+	if (!ReadRawString(Raw, bHasEscapes))
+	{
+		return false;
+	}
+
+	OutValue = RawStringToString(Raw, bHasEscapes);
+	return true;
+}
+
+FString FCarespaceJsonReader::RawStringToString(TArrayView<const uint8> Raw, bool bHasEscapes)
+{
+	if (!bHasEscapes)
+	{
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Raw.GetData()), Raw.Num());
+		return FString(Converter.Length(), Converter.Get());
+	}
+
+	TArray<UTF8CHAR, TInlineAllocator<256>> Utf8;
+	Unescape(Raw, Utf8);
+	const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Utf8.GetData()), Utf8.Num());
+	return FString(Converter.Length(), Converter.Get());
+}
+
+void FCarespaceJsonReader::Unescape(TArrayView<const uint8> Raw, TArray<UTF8CHAR, TInlineAllocator<256>>& OutUtf8)
+{
+	OutUtf8.Reserve(OutUtf8.Num() + Raw.Num());
+
+	const uint8* It = Raw.GetData();
+	const uint8* RawEnd = It + Raw.Num();
+	while (It < RawEnd)
+	{
+		if (*It != '\\')
+		{
+			OutUtf8.Add(static_cast<UTF8CHAR>(*It++));
+			continue;
+		}
+
+		if (++It == RawEnd)
+		{
+			break;
+		}
+
+		const uint8 Escape = *It++;
+		switch (Escape)
+		{
+		case 'b': OutUtf8.Add(static_cast<UTF8CHAR>('\b')); break;
+		case 'f': OutUtf8.Add(static_cast<UTF8CHAR>('\f')); break;
+		case 'n': OutUtf8.Add(static_cast<UTF8CHAR>('\n')); break;
+		case 'r': OutUtf8.Add(static_cast<UTF8CHAR>('\r')); break;
+		case 't': OutUtf8.Add(static_cast<UTF8CHAR>('\t')); break;
+
+		case 'u':
+		{
+			uint32 CodePoint = 0;
+			if (!ParseHex4(It, RawEnd, CodePoint))
+			{
+				AppendCodePoint(OutUtf8, 0xFFFD);
+				break;
+			}
+			It += 4;
+
+			// Characters outside the BMP arrive as a surrogate pair of two escapes
+			uint32 LowSurrogate = 0;
+			if (CodePoint >= 0xD800 && CodePoint < 0xDC00 && RawEnd - It >= 6 && It[0] == '\\' && It[1] == 'u'
+				&& ParseHex4(It + 2, RawEnd, LowSurrogate) && LowSurrogate >= 0xDC00 && LowSurrogate < 0xE000)
+			{
+				CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+				It += 6;
+			}
+			else if (CodePoint >= 0xD800 && CodePoint < 0xE000)
+			{
+				CodePoint = 0xFFFD;
+			}
+
+			AppendCodePoint(OutUtf8, CodePoint);
+			break;
+		}
+
+		default:
+			// \" \\ \/ and anything unknown stand for themselves
+			OutUtf8.Add(static_cast<UTF8CHAR>(Escape));
+			break;
+		}
+	}
+}
+
+bool FCarespaceJsonReader::ReadNumberToken(TArrayView<const uint8>& OutToken)
+{
+	SkipWhitespace();
+
+	// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+	const uint8* Start = Cursor;
+	const uint8* Scan = Cursor;
+	if (Scan < End && *Scan == '-')
+	{
+		++Scan;
+	}
+
+	if (Scan < End && *Scan == '0')
+	{
+		++Scan;
+	}
+	else if (!SkipDigits(Scan, End))
+	{
+		return Fail();
+	}
+
+	if (Scan < End && *Scan == '.')
+	{
+		++Scan;
+		if (!SkipDigits(Scan, End))
+		{
+			return Fail();
+		}
+	}
+
+	if (Scan < End && (*Scan == 'e' || *Scan == 'E'))
+	{
+		++Scan;
+		if (Scan < End && (*Scan == '+' || *Scan == '-'))
+		{
+			++Scan;
+		}
+		if (!SkipDigits(Scan, End))
+		{
+			return Fail();
+		}
+	}
+
+	// A leading zero cannot be followed by more digits
+	if (Scan < End && IsDigit(*Scan))
+	{
+		return Fail();
+	}
+
+	Cursor = Scan;
+	OutToken = TArrayView<const uint8>(Start, static_cast<int32>(Cursor - Start));
+	return true;
+}
+
+double FCarespaceJsonReader::ParseNumberToken(TArrayView<const uint8> Token)
+{
+	// Atod needs a terminator; the inline buffer covers all but unusually long tokens, which still parse
+	TAnsiStringBuilder<64> Buffer;
+	Buffer.Append(reinterpret_cast<const ANSICHAR*>(Token.GetData()), Token.Num());
+	return FCStringAnsi::Atod(*Buffer);
+}
+
+bool FCarespaceJsonReader::ReadNumber(double& OutValue)
+{
+	TArrayView<const uint8> Token;
+	if (!ReadNumberToken(Token))
+	{
+		return false;
+	}
+
+	OutValue = ParseNumberToken(Token);
+	return true;
+}
+
+bool FCarespaceJsonReader::ReadInteger(int64& OutValue)
+{
+	const uint8* Start = Cursor;
+	TArrayView<const uint8> Token;
+	if (!ReadNumberToken(Token))
+	{
+		return false;
+	}
+
+	// Plain integers, by far the most common case, are parsed directly
+	const bool bNegative = Token[0] == '-';
+	const int32 FirstDigit = bNegative ? 1 : 0;
+	if (Token.Num() > FirstDigit && Token.Num() - FirstDigit <= 18)
+	{
+		int64 Value = 0;
+		int32 Index = FirstDigit;
+		for (; Index < Token.Num() && Token[Index] >= '0' && Token[Index] <= '9'; ++Index)
+		{
+			Value = Value * 10 + (Token[Index] - '0');
+		}
+
+		if (Index == Token.Num())
+		{
+			OutValue = bNegative ? -Value : Value;
+			return true;
+		}
+	}
+
+	Cursor = Start;
+	double Value = 0.0;
+	if (!ReadNumber(Value))
+	{
+		return false;
+	}
+	OutValue = static_cast<int64>(Value);
+	return true;
+}
+
+bool FCarespaceJsonReader::ReadLiteral(const ANSICHAR* Literal, int32 Length)
+{
+	if (End - Cursor >= Length && FMemory::Memcmp(Cursor, Literal, Length) == 0)
+	{
+		Cursor += Length;
+		return true;
+	}
+	return false;
+}
+
+bool FCarespaceJsonReader::ReadBool(bool& OutValue)
+{
+	SkipWhitespace();
+	if (ReadLiteral("true", 4))
+	{
+		OutValue = true;
+		return true;
+	}
+	if (ReadLiteral("false", 5))
+	{
+		OutValue = false;
+		return true;
+	}
+	return Fail();
+}
+
+bool FCarespaceJsonReader::ReadNull()
+{
+	SkipWhitespace();
+	return ReadLiteral("null", 4);
+}
+
+bool FCarespaceJsonReader::SkipValue()
+{
+	switch (PeekType())
+	{
+	case ECarespaceJsonValueType::Object:
+	case ECarespaceJsonValueType::Array:
+	{
+		int32 Depth = 0;
+		if (Index)
+		{
+			// Strings inside the value are indexed as quote pairs; only brackets change the depth
+			for (const uint8* Char = SeekIndexed(); Char; ++IndexCursor, Char = SeekIndexed())
+			{
+				if (*Char == '{' || *Char == '[')
+				{
+					++Depth;
+				}
+				else if ((*Char == '}' || *Char == ']') && --Depth == 0)
+				{
+					Cursor = Char + 1;
+					++IndexCursor;
+					return true;
+				}
+			}
+			return Fail();
+		}
+
+		while (Cursor < End)
+		{
+			const uint8 Char = *Cursor;
+			if (Char == '"')
+			{
+				TArrayView<const uint8> Raw;
+				bool bHasEscapes = false;
+				if (!ReadRawString(Raw, bHasEscapes))
+				{
+					return false;
+				}
+				continue;
+			}
+
+			++Cursor;
+			if (Char == '{' || Char == '[')
+			{
+				++Depth;
+			}
+			else if ((Char == '}' || Char == ']') && --Depth == 0)
+			{
+				return true;
+			}
+		}
+		return Fail();
+	}
+
+	case ECarespaceJsonValueType::String:
+	{
+		TArrayView<const uint8> Raw;
+		bool bHasEscapes = false;
+		return ReadRawString(Raw, bHasEscapes);
+	}
+
+	case ECarespaceJsonValueType::Number:
+	{
+		TArrayView<const uint8> Token;
+		return ReadNumberToken(Token);
+	}
+
+	case ECarespaceJsonValueType::Bool:
+	{
+		bool bValue = false;
+		return ReadBool(bValue);
+	}
+
+	case ECarespaceJsonValueType::Null:
+		return ReadNull() || Fail();
+
+	default:
+		return Fail();
+	}
+}
+
+bool FCarespaceJsonReader::ReadRawValue(TArrayView<const uint8>& OutValue)
+{
+	SkipWhitespace();
+	const uint8* Start = Cursor;
+	if (!SkipValue())
+	{
+		return false;
+	}
+
+	OutValue = TArrayView<const uint8>(Start, static_cast<int32>(Cursor - Start));
+	return true;
+}
+
+FCarespaceJsonWriter::FCarespaceJsonWriter(TArray<uint8>& InOutput)
+	: Output(InOutput)
+	, bNeedsComma(false)
+{
+}
+
+void FCarespaceJsonWriter::BeginValue()
+{
+	if (bNeedsComma)
+	{
+		Output.Add(',');
+	}
+}
+
+void FCarespaceJsonWriter::Append(const ANSICHAR* Text, int32 Length)
+{
+	Output.Append(reinterpret_cast<const uint8*>(Text), Length);
+}
+
+void FCarespaceJsonWriter::BeginObject()
+{
+	BeginValue();
+	Output.Add('{');
+	bNeedsComma = false;
+}
+
+void FCarespaceJsonWriter::EndObject()
+{
+	Output.Add('}');
+	bNeedsComma = true;
+}
+
+void FCarespaceJsonWriter::BeginArray()
+{
+	BeginValue();
+	Output.Add('[');
+	bNeedsComma = false;
+}
+
+void FCarespaceJsonWriter::EndArray()
+{
+	Output.Add(']');
+	bNeedsComma = true;
+}
+
+void FCarespaceJsonWriter::WriteKey(const ANSICHAR* Key, int32 Length)
+{
+	BeginValue();
+	Output.Add('"');
+	Append(Key, Length);
+	Output.Add('"');
+	Output.Add(':');
+	bNeedsComma = false;
+}
+
+void FCarespaceJsonWriter::WriteString(FStringView Value)
+{
+	const FTCHARToUTF8 Utf8(Value.GetData(), Value.Len());
+	WriteUtf8String(TArrayView<const uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()));
+}
+
+void FCarespaceJsonWriter::WriteUtf8String(TArrayView<const uint8> Utf8)
+{
+	BeginValue();
+	Output.Reserve(Output.Num() + Utf8.Num() + 2);
+	Output.Add('"');
+
+	// Copy runs of plain characters at once; multi-byte sequences never contain bytes that need escaping
+	int32 RunStart = 0;
+	for (int32 Index = 0; Index < Utf8.Num(); ++Index)
+	{
+		const uint8 Char = Utf8[Index];
+		if (Char >= 0x20 && Char != '"' && Char != '\\')
+		{
+			continue;
+		}
+
+		Output.Append(Utf8.GetData() + RunStart, Index - RunStart);
+		RunStart = Index + 1;
+
+		switch (Char)
+		{
+		case '"': Append("\\\"", 2); break;
+		case '\\': Append("\\\\", 2); break;
+		case '\n': Append("\\n", 2); break;
+		case '\r': Append("\\r", 2); break;
+		case '\t': Append("\\t", 2); break;
+		case '\b': Append("\\b", 2); break;
+		case '\f': Append("\\f", 2); break;
+		default:
+		{
+			static const ANSICHAR HexDigits[] = "0123456789abcdef";
+			const ANSICHAR Escaped[6] = { '\\', 'u', '0', '0', HexDigits[Char >> 4], HexDigits[Char & 0xF] };
+			Append(Escaped, 6);
+			break;
+		}
+		}
+	}
+
+	Output.Append(Utf8.GetData() + RunStart, Utf8.Num() - RunStart);
+	Output.Add('"');
+	bNeedsComma = true;
+}
+
+void FCarespaceJsonWriter::WriteInteger(int64 Value)
+{
+	BeginValue();
+
+	ANSICHAR Buffer[24];
+	int32 Start = UE_ARRAY_COUNT(Buffer);
+	uint64 Magnitude = Value < 0 ? static_cast<uint64>(-(Value + 1)) + 1 : static_cast<uint64>(Value);
+	do
+	{
+		Buffer[--Start] = static_cast<ANSICHAR>('0' + Magnitude % 10);
+		Magnitude /= 10;
+	}
+	while (Magnitude > 0);
+
+	if (Value < 0)
+	{
+		Buffer[--Start] = '-';
+	}
+
+	Append(Buffer + Start, UE_ARRAY_COUNT(Buffer) - Start);
+	bNeedsComma = true;
+}
+
+void FCarespaceJsonWriter::WriteNumber(double Value)
+{
+	// Integral values are written without a fraction, like TJsonWriter does
+	if (FMath::IsFinite(Value) && FMath::Abs(Value) < 9007199254740992.0 && Value == FMath::TruncToDouble(Value))
+	{
+		WriteInteger(static_cast<int64>(Value));
+		return;
+	}
+
+	BeginValue();
+	const FString Text = FMath::IsFinite(Value) ? FString::Printf(TEXT("%.17g"), Value) : FString(TEXT("null"));
+	const FTCHARToUTF8 Utf8(*Text, Text.Len());
+	Append(Utf8.Get(), Utf8.Length());
+	bNeedsComma = true;
+}
+
+void FCarespaceJsonWriter::WriteBool(bool Value)
+{
+	BeginValue();
+	if (Value)
+	{
+		Append("true", 4);
+	}
+	else
+	{
+		Append("false", 5);
+	}
+	bNeedsComma = true;
+}
+
+void FCarespaceJsonWriter::WriteNull()
+{
+	BeginValue();
+	Append("null", 4);
+	bNeedsComma = true;
+}
@@ -0,0 +1,276 @@
+#include "CarespaceJsonDocument.h"
+
+namespace
+{
+	// Deeper documents are rejected instead of exhausting the stack
+	constexpr int32 MaxDepth = 512;
+
+	bool KeyEquals(const FCarespaceJsonMember& Member, FAnsiStringView Key)
+	{
+		if (Member.KeyLength != Key.Len())
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < Key.Len(); ++Index)
+		{
+			const uint8 A = Member.Key[Index];
+			const uint8 B = static_cast<uint8>(Key[Index]);
+			if (A != B && ((A | 0x20) != (B | 0x20) || (A | 0x20) < 'a' || (A | 0x20) > 'z'))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+FCarespaceJsonArena::FCarespaceJsonArena(int32 InBlockSize)
+	: BlockSize(InBlockSize)
+{
+}
+
+FCarespaceJsonArena::~FCarespaceJsonArena()
+{
+	Reset();
+}
+
+void* FCarespaceJsonArena::Allocate(SIZE_T Size, SIZE_T Alignment)
+{
+	uint8* Aligned = Align(Cursor, Alignment);
+	if (!Cursor || Aligned + Size > BlockEnd)
+	{
+		const SIZE_T NewBlockSize = FMath::Max<SIZE_T>(BlockSize, Size + Alignment);
+		Cursor = static_cast<uint8*>(FMemory::Malloc(NewBlockSize));
+		BlockEnd = Cursor + NewBlockSize;
+		Blocks.Add(Cursor);
+		Aligned = Align(Cursor, Alignment);
+	}
+
+	Cursor = Aligned + Size;
+	BytesUsed += Size;
+	return Aligned;
+}
+
+void FCarespaceJsonArena::Reset()
+{
+	for (void* Block : Blocks)
+	{
+		FMemory::Free(Block);
+	}
+	Blocks.Reset();
+	Cursor = nullptr;
+	BlockEnd = nullptr;
+	BytesUsed = 0;
+}
+
+const FCarespaceJsonNode* FCarespaceJsonNode::FindField(FAnsiStringView Key) const
+{
+	for (const FCarespaceJsonMember& Member : GetMembers())
+	{
+		if (KeyEquals(Member, Key))
+		{
+			return &Member.Value;
+		}
+	}
+	return nullptr;
+}
+
+TConstArrayView<FCarespaceJsonMember> FCarespaceJsonNode::GetMembers() const
+{
+	return Type == ECarespaceJsonValueType::Object ? TConstArrayView<FCarespaceJsonMember>(Members, Count) : TConstArrayView<FCarespaceJsonMember>();
+}
+
+TConstArrayView<FCarespaceJsonNode> FCarespaceJsonNode::GetElements() const
+{
+	return Type == ECarespaceJsonValueType::Array ? TConstArrayView<FCarespaceJsonNode>(Elements, Count) : TConstArrayView<FCarespaceJsonNode>();
+}
+
+bool FCarespaceJsonNode::TryGetString(FString& OutValue) const
+{
+	switch (Type)
+	{
+	case ECarespaceJsonValueType::String:
+	case ECarespaceJsonValueType::Number:
+		OutValue = FCarespaceJsonReader::RawStringToString(TArrayView<const uint8>(Text, Count), bHasEscapes);
+		return true;
+
+	case ECarespaceJsonValueType::Bool:
+		OutValue = bValue ? TEXT("true") : TEXT("false");
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+FString FCarespaceJsonNode::AsString() const
+{
+	FString Value;
+	TryGetString(Value);
+	return Value;
+}
+
+double FCarespaceJsonNode::AsNumber() const
+{
+	switch (Type)
+	{
+	case ECarespaceJsonValueType::Number:
+		return FCarespaceJsonReader::ParseNumberToken(TArrayView<const uint8>(Text, Count));
+
+	case ECarespaceJsonValueType::String:
+		return bHasEscapes ? FCString::Atod(*AsString()) : FCarespaceJsonReader::ParseNumberToken(TArrayView<const uint8>(Text, Count));
+
+	case ECarespaceJsonValueType::Bool:
+		return bValue ? 1.0 : 0.0;
+
+	default:
+		return 0.0;
+	}
+}
+
+bool FCarespaceJsonNode::AsBool() const
+{
+	switch (Type)
+	{
+	case ECarespaceJsonValueType::Bool:
+		return bValue;
+
+	case ECarespaceJsonValueType::Number:
+		return AsNumber() != 0.0;
+
+	case ECarespaceJsonValueType::String:
+		return AsString().Equals(TEXT("true"), ESearchCase::IgnoreCase);
+
+	default:
+		return false;
+	}
+}
+
+bool FCarespaceJsonDocument::Parse(TArrayView<const uint8> Json)
+{
+	Arena.Reset();
+	ElementStack.Reset();
+	MemberStack.Reset();
+	Root = FCarespaceJsonNode();
+
+	FCarespaceJsonReader Reader(Json);
+	if (ParseValue(Reader, Root, 0) && Reader.IsAtEnd())
+	{
+		return true;
+	}
+
+	Root = FCarespaceJsonNode();
+	return false;
+}
+
+bool FCarespaceJsonDocument::ParseValue(FCarespaceJsonReader& Reader, FCarespaceJsonNode& OutNode, int32 Depth)
+{
+	OutNode.Type = Reader.PeekType();
+	switch (OutNode.Type)
+	{
+	case ECarespaceJsonValueType::String:
+	{
+		TArrayView<const uint8> Raw;
+		if (!Reader.ReadRawString(Raw, OutNode.bHasEscapes))
+		{
+			return false;
+		}
+		OutNode.Text = Raw.GetData();
+		OutNode.Count = Raw.Num();
+		return true;
+	}
+
+	case ECarespaceJsonValueType::Number:
+	{
+		TArrayView<const uint8> Token;
+		if (!Reader.ReadNumberToken(Token))
+		{
+			return false;
+		}
+		OutNode.Text = Token.GetData();
+		OutNode.Count = Token.Num();
+		return true;
+	}
+
+	case ECarespaceJsonValueType::Bool:
+		return Reader.ReadBool(OutNode.bValue);
+
+	case ECarespaceJsonValueType::Null:
+		return Reader.ReadNull();
+
+	case ECarespaceJsonValueType::Array:
+	{
+		if (Depth >= MaxDepth || !Reader.ReadArrayStart())
+		{
+			return false;
+		}
+
+		const int32 First = ElementStack.Num();
+		while (Reader.ReadNextElement())
+		{
+			FCarespaceJsonNode Element;
+			if (!ParseValue(Reader, Element, Depth + 1))
+			{
+				return false;
+			}
+			ElementStack.Add(Element);
+		}
+
+		if (Reader.HasError())
+		{
+			return false;
+		}
+
+		OutNode.Count = ElementStack.Num() - First;
+		FCarespaceJsonNode* Elements = Arena.AllocateArray<FCarespaceJsonNode>(OutNode.Count);
+		if (Elements)
+		{
+			FMemory::Memcpy(Elements, ElementStack.GetData() + First, OutNode.Count * sizeof(FCarespaceJsonNode));
+		}
+		OutNode.Elements = Elements;
+		ElementStack.SetNum(First, false);
+		return true;
+	}
+
+	case ECarespaceJsonValueType::Object:
+	{
+		if (Depth >= MaxDepth || !Reader.ReadObjectStart())
+		{
+			return false;
+		}
+
+		const int32 First = MemberStack.Num();
+		TArrayView<const uint8> Key;
+		while (Reader.ReadNextKey(Key))
+		{
+			FCarespaceJsonMember Member;
+			Member.Key = Key.GetData();
+			Member.KeyLength = Key.Num();
+			if (!ParseValue(Reader, Member.Value, Depth + 1))
+			{
+				return false;
+			}
+			MemberStack.Add(Member);
+		}
+
+		if (Reader.HasError())
+		{
+			return false;
+		}
+
+		OutNode.Count = MemberStack.Num() - First;
+		FCarespaceJsonMember* Members = Arena.AllocateArray<FCarespaceJsonMember>(OutNode.Count);
+		if (Members)
+		{
+			FMemory::Memcpy(Members, MemberStack.GetData() + First, OutNode.Count * sizeof(FCarespaceJsonMember));
+		}
+		OutNode.Members = Members;
+		MemberStack.SetNum(First, false);
+		return true;
+	}
+
+	default:
+		return false;
+	}
+}
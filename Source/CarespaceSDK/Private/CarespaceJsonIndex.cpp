@@ -0,0 +1,286 @@
+#include "CarespaceJsonIndex.h"
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif PLATFORM_CPU_X86_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS
+	#include <emmintrin.h>
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS_NEON && PLATFORM_64BITS
+	#include <arm_neon.h>
+#endif
+
+namespace
+{
+	constexpr int32 BytesPerBlock = 64;
+	constexpr uint64 EvenBits = 0x5555555555555555ULL;
+
+	/** One bit per byte of a 64-byte block. */
+	struct FBlockMasks
+	{
+		uint64 Quote;
+		uint64 Backslash;
+		uint64 Structural;
+		uint64 Control;
+	};
+
+#if defined(__AVX2__)
+	const TCHAR* const KernelName = TEXT("AVX2");
+
+	void ClassifyBlock(const uint8* Block, FBlockMasks& Out)
+	{
+		const __m256i Quote = _mm256_set1_epi8('"');
+		const __m256i Backslash = _mm256_set1_epi8('\\');
+		const __m256i CaseBit = _mm256_set1_epi8(0x20);
+		const __m256i OpenBrace = _mm256_set1_epi8('{');
+		const __m256i CloseBrace = _mm256_set1_epi8('}');
+		const __m256i Colon = _mm256_set1_epi8(':');
+		const __m256i Comma = _mm256_set1_epi8(',');
+		const __m256i LastControl = _mm256_set1_epi8(0x1F);
+		const __m256i Zero = _mm256_setzero_si256();
+
+		Out = FBlockMasks{};
+		for (int32 Lane = 0; Lane < 2; ++Lane)
+		{
+			const __m256i Bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Block + Lane * 32));
+
+			// '[' and ']' differ from '{' and '}' only in the 0x20 bit
+			const __m256i Folded = _mm256_or_si256(Bytes, CaseBit);
+			const __m256i Structural = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(Folded, OpenBrace), _mm256_cmpeq_epi8(Folded, CloseBrace)),
+				_mm256_or_si256(_mm256_cmpeq_epi8(Bytes, Colon), _mm256_cmpeq_epi8(Bytes, Comma)));
+
+			const int32 Shift = Lane * 32;
+			Out.Quote |= static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Bytes, Quote)))) << Shift;
+			Out.Backslash |= static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Bytes, Backslash)))) << Shift;
+			Out.Structural |= static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(Structural))) << Shift;
+			Out.Control |= static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_subs_epu8(Bytes, LastControl), Zero)))) << Shift;
+		}
+	}
+
+#elif PLATFORM_CPU_X86_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS
+	const TCHAR* const KernelName = TEXT("SSE2");
+
+	void ClassifyBlock(const uint8* Block, FBlockMasks& Out)
+	{
+		const __m128i Quote = _mm_set1_epi8('"');
+		const __m128i Backslash = _mm_set1_epi8('\\');
+		const __m128i CaseBit = _mm_set1_epi8(0x20);
+		const __m128i OpenBrace = _mm_set1_epi8('{');
+		const __m128i CloseBrace = _mm_set1_epi8('}');
+		const __m128i Colon = _mm_set1_epi8(':');
+		const __m128i Comma = _mm_set1_epi8(',');
+		const __m128i LastControl = _mm_set1_epi8(0x1F);
+		const __m128i Zero = _mm_setzero_si128();
+
+		Out = FBlockMasks{};
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + Lane * 16));
+
+			// '[' and ']' differ from '{' and '}' only in the 0x20 bit
+			const __m128i Folded = _mm_or_si128(Bytes, CaseBit);
+			const __m128i Structural = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(Folded, OpenBrace), _mm_cmpeq_epi8(Folded, CloseBrace)),
+				_mm_or_si128(_mm_cmpeq_epi8(Bytes, Colon), _mm_cmpeq_epi8(Bytes, Comma)));
+
+			const int32 Shift = Lane * 16;
+			Out.Quote |= static_cast<uint64>(_mm_movemask_epi8(_mm_cmpeq_epi8(Bytes, Quote))) << Shift;
+			Out.Backslash |= static_cast<uint64>(_mm_movemask_epi8(_mm_cmpeq_epi8(Bytes, Backslash))) << Shift;
+			Out.Structural |= static_cast<uint64>(_mm_movemask_epi8(Structural)) << Shift;
+			Out.Control |= static_cast<uint64>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(Bytes, LastControl), Zero))) << Shift;
+		}
+	}
+
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS_NEON && PLATFORM_64BITS
+	const TCHAR* const KernelName = TEXT("NEON");
+
+	/** Packs four compare results of 16 lanes each into a 64-bit mask; NEON has no movemask. */
+	uint64 ToBitmask(uint8x16_t Mask0, uint8x16_t Mask1, uint8x16_t Mask2, uint8x16_t Mask3)
+	{
+		static const uint8 LaneBits[16] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+		const uint8x16_t Bits = vld1q_u8(LaneBits);
+
+		uint8x16_t Sum0 = vpaddq_u8(vandq_u8(Mask0, Bits), vandq_u8(Mask1, Bits));
+		const uint8x16_t Sum1 = vpaddq_u8(vandq_u8(Mask2, Bits), vandq_u8(Mask3, Bits));
+		Sum0 = vpaddq_u8(Sum0, Sum1);
+		Sum0 = vpaddq_u8(Sum0, Sum0);
+		return vgetq_lane_u64(vreinterpretq_u64_u8(Sum0), 0);
+	}
+
+	void ClassifyBlock(const uint8* Block, FBlockMasks& Out)
+	{
+		const uint8x16_t Quote = vdupq_n_u8('"');
+		const uint8x16_t Backslash = vdupq_n_u8('\\');
+		const uint8x16_t CaseBit = vdupq_n_u8(0x20);
+		const uint8x16_t OpenBrace = vdupq_n_u8('{');
+		const uint8x16_t CloseBrace = vdupq_n_u8('}');
+		const uint8x16_t Colon = vdupq_n_u8(':');
+		const uint8x16_t Comma = vdupq_n_u8(',');
+
+		uint8x16_t Quotes[4];
+		uint8x16_t Backslashes[4];
+		uint8x16_t Structurals[4];
+		uint8x16_t Controls[4];
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const uint8x16_t Bytes = vld1q_u8(Block + Lane * 16);
+
+			// '[' and ']' differ from '{' and '}' only in the 0x20 bit
+			const uint8x16_t Folded = vorrq_u8(Bytes, CaseBit);
+			Structurals[Lane] = vorrq_u8(
+				vorrq_u8(vceqq_u8(Folded, OpenBrace), vceqq_u8(Folded, CloseBrace)),
+				vorrq_u8(vceqq_u8(Bytes, Colon), vceqq_u8(Bytes, Comma)));
+			Quotes[Lane] = vceqq_u8(Bytes, Quote);
+			Backslashes[Lane] = vceqq_u8(Bytes, Backslash);
+			Controls[Lane] = vcltq_u8(Bytes, CaseBit);
+		}
+
+		Out.Quote = ToBitmask(Quotes[0], Quotes[1], Quotes[2], Quotes[3]);
+		Out.Backslash = ToBitmask(Backslashes[0], Backslashes[1], Backslashes[2], Backslashes[3]);
+		Out.Structural = ToBitmask(Structurals[0], Structurals[1], Structurals[2], Structurals[3]);
+		Out.Control = ToBitmask(Controls[0], Controls[1], Controls[2], Controls[3]);
+	}
+
+#else
+	const TCHAR* const KernelName = TEXT("Scalar");
+
+	void ClassifyBlock(const uint8* Block, FBlockMasks& Out)
+	{
+		Out = FBlockMasks{};
+		for (int32 Index = 0; Index < BytesPerBlock; ++Index)
+		{
+			const uint8 Char = Block[Index];
+			const uint64 Bit = 1ULL << Index;
+			const uint8 Folded = Char | 0x20;
+			Out.Quote |= Char == '"' ? Bit : 0;
+			Out.Backslash |= Char == '\\' ? Bit : 0;
+			Out.Structural |= (Folded == '{' || Folded == '}' || Char == ':' || Char == ',') ? Bit : 0;
+			Out.Control |= Char < 0x20 ? Bit : 0;
+		}
+	}
+#endif
+
+	/**
+	 * Finds the characters escaped by an odd-length run of backslashes. Adding a bit at the start of
+	 * each run carries it to the character just past the run; whether that lands on an odd or even
+	 * offset gives the parity of the run.
+	 *
+	 * @param Backslash Backslash mask of the block
+	 * @param InOutCarry 1 if the previous block ended in an odd run, which escapes this block's first character
+	 */
+	uint64 FindEscaped(uint64 Backslash, uint64& InOutCarry)
+	{
+		const uint64 OddBits = ~EvenBits;
+
+		// A backslash escaped from the previous block neither starts nor extends a run
+		Backslash &= ~InOutCarry;
+		const uint64 Starts = Backslash & ~(Backslash << 1);
+		const uint64 EvenStarts = Starts & EvenBits;
+		const uint64 OddStarts = Starts & OddBits;
+
+		const uint64 EvenCarries = Backslash + EvenStarts;
+		const uint64 OddCarries = Backslash + OddStarts;
+
+		// Only a run that started on an odd offset and reached the end of the block has odd length
+		const uint64 Escaped = ((EvenCarries & ~Backslash & OddBits) | (OddCarries & ~Backslash & EvenBits)) | InOutCarry;
+		InOutCarry = OddCarries < Backslash ? 1 : 0;
+		return Escaped;
+	}
+
+	/** @return Mask with every bit set that has an odd number of set bits at or below it in Mask */
+	uint64 PrefixXor(uint64 Mask)
+	{
+		Mask ^= Mask << 1;
+		Mask ^= Mask << 2;
+		Mask ^= Mask << 4;
+		Mask ^= Mask << 8;
+		Mask ^= Mask << 16;
+		Mask ^= Mask << 32;
+		return Mask;
+	}
+}
+
+bool FCarespaceJsonIndex::Build(TArrayView<const uint8> InJson)
+{
+	Reset();
+	Json = InJson;
+
+	const int32 NumBlocks = (Json.Num() + BytesPerBlock - 1) / BytesPerBlock;
+	Backslashes.SetNumUninitialized(NumBlocks);
+
+	// Compact JSON has a structural character every four to eight bytes
+	Structurals.Reserve(Json.Num() / 4 + 16);
+
+	uint64 EscapeCarry = 0;
+	uint64 InStringCarry = 0;
+	uint64 Errors = 0;
+	uint8 Tail[BytesPerBlock];
+
+	for (int32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+	{
+		const int32 Offset = BlockIndex * BytesPerBlock;
+		const uint8* Block = Json.GetData() + Offset;
+
+		// The last block is padded with whitespace, which is never indexed
+		if (Json.Num() - Offset < BytesPerBlock)
+		{
+			FMemory::Memset(Tail, ' ', BytesPerBlock);
+			FMemory::Memcpy(Tail, Block, Json.Num() - Offset);
+			Block = Tail;
+		}
+
+		FBlockMasks Masks;
+		ClassifyBlock(Block, Masks);
+		Backslashes[BlockIndex] = Masks.Backslash;
+
+		const uint64 Quotes = Masks.Quote & ~FindEscaped(Masks.Backslash, EscapeCarry);
+
+		// Set from each opening quote up to, but not including, its closing quote
+		const uint64 InString = PrefixXor(Quotes) ^ InStringCarry;
+		InStringCarry = static_cast<uint64>(static_cast<int64>(InString) >> 63);
+		Errors |= Masks.Control & InString;
+
+		uint64 Mask = (Masks.Structural & ~InString) | Quotes;
+		const int32 First = Structurals.AddUninitialized(FMath::CountBits(Mask));
+		uint32* Out = Structurals.GetData() + First;
+		while (Mask)
+		{
+			*Out++ = static_cast<uint32>(Offset + FMath::CountTrailingZeros64(Mask));
+			Mask &= Mask - 1;
+		}
+	}
+
+	if (Errors || InStringCarry)
+	{
+		Reset();
+		return false;
+	}
+	return true;
+}
+
+void FCarespaceJsonIndex::Reset()
+{
+	Json = TArrayView<const uint8>();
+	Structurals.Reset();
+	Backslashes.Reset();
+}
+
+bool FCarespaceJsonIndex::HasBackslash(int32 Begin, int32 End) const
+{
+	while (Begin < End)
+	{
+		const int32 Bit = Begin % BytesPerBlock;
+		const int32 NumBits = FMath::Min(BytesPerBlock - Bit, End - Begin);
+		const uint64 Range = (NumBits == BytesPerBlock ? ~0ULL : ((1ULL << NumBits) - 1)) << Bit;
+		if (Backslashes[Begin / BytesPerBlock] & Range)
+		{
+			return true;
+		}
+		Begin += NumBits;
+	}
+	return false;
+}
+
+const TCHAR* FCarespaceJsonIndex::GetKernelName()
+{
+	return KernelName;
+}
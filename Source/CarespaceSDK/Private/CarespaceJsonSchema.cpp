@@ -0,0 +1,298 @@
+#include "CarespaceJsonSchema.h"
+#include "CarespaceTimestamp.h"
+
+namespace
+{
+	bool KeyEquals(TArrayView<const uint8> Key, const FCarespaceJsonField& Field)
+	{
+		if (Key.Num() != Field.NameLength)
+		{
+			return false;
+		}
+
+		// Keys are ASCII, so folding the case bit is enough for a case-insensitive compare
+		for (int32 Index = 0; Index < Key.Num(); ++Index)
+		{
+			const uint8 A = Key[Index];
+			const uint8 B = static_cast<uint8>(Field.Name[Index]);
+			if (A != B && ((A | 0x20) != (B | 0x20) || (A | 0x20) < 'a' || (A | 0x20) > 'z'))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	const FCarespaceJsonField* FindField(TConstArrayView<FCarespaceJsonField> Fields, TArrayView<const uint8> Key, int32& InOutHint)
+	{
+		for (int32 Offset = 0; Offset < Fields.Num(); ++Offset)
+		{
+			const int32 Index = (InOutHint + Offset) % Fields.Num();
+			if (KeyEquals(Key, Fields[Index]))
+			{
+				InOutHint = Index + 1;
+				return &Fields[Index];
+			}
+		}
+		return nullptr;
+	}
+
+	bool RawEquals(TArrayView<const uint8> Raw, const ANSICHAR* Text, int32 Length)
+	{
+		return Raw.Num() == Length && FMemory::Memcmp(Raw.GetData(), Text, Length) == 0;
+	}
+}
+
+namespace CarespaceJson
+{
+	bool ReadFields(FCarespaceJsonReader& Reader, void* Struct, TConstArrayView<FCarespaceJsonField> Fields)
+	{
+		if (!Reader.ReadObjectStart())
+		{
+			return false;
+		}
+
+		int32 Hint = 0;
+		TArrayView<const uint8> Key;
+		while (Reader.ReadNextKey(Key))
+		{
+			const FCarespaceJsonField* Field = FindField(Fields, Key, Hint);
+			if (!Field)
+			{
+				if (!Reader.SkipValue())
+				{
+					return false;
+				}
+				continue;
+			}
+
+			if (!Reader.ReadNull() && !Field->Read(Reader, Struct))
+			{
+				return false;
+			}
+		}
+		return !Reader.HasError();
+	}
+
+	bool FindArrayElements(const FCarespaceJsonIndex& Index, FAnsiStringView ArrayField, TArray<TArrayView<const uint8>>& OutElements)
+	{
+		FCarespaceJsonReader Reader(Index.GetJson(), Index);
+		if (!Reader.ReadObjectStart())
+		{
+			return false;
+		}
+
+		TArrayView<const uint8> Key;
+		while (Reader.ReadNextKey(Key))
+		{
+			if (!RawEquals(Key, ArrayField.GetData(), ArrayField.Len()) || Reader.PeekType() != ECarespaceJsonValueType::Array)
+			{
+				if (!Reader.SkipValue())
+				{
+					return false;
+				}
+				continue;
+			}
+
+			// Elements are only delimited here; skipping one costs a walk over its indexed brackets and quotes
+			Reader.ReadArrayStart();
+			while (Reader.ReadNextElement())
+			{
+				TArrayView<const uint8> Element;
+				if (!Reader.ReadRawValue(Element))
+				{
+					return false;
+				}
+				OutElements.Add(Element);
+			}
+
+			if (Reader.HasError())
+			{
+				return false;
+			}
+		}
+		return !Reader.HasError() && Reader.IsAtEnd();
+	}
+
+	void WriteFields(FCarespaceJsonWriter& Writer, const void* Struct, TConstArrayView<FCarespaceJsonField> Fields)
+	{
+		Writer.BeginObject();
+		for (const FCarespaceJsonField& Field : Fields)
+		{
+			Writer.WriteKey(Field.Name, Field.NameLength);
+			Field.Write(Writer, Struct);
+		}
+		Writer.EndObject();
+	}
+
+	bool ReadValue(FCarespaceJsonReader& Reader, FString& OutValue)
+	{
+		switch (Reader.PeekType())
+		{
+		case ECarespaceJsonValueType::String:
+			return Reader.ReadString(OutValue);
+
+		case ECarespaceJsonValueType::Number:
+		{
+			// Numbers keep their text, like FJsonValueNumber::AsString
+			TArrayView<const uint8> Token;
+			if (!Reader.ReadNumberToken(Token))
+			{
+				return false;
+			}
+			OutValue = FCarespaceJsonReader::RawStringToString(Token, false);
+			return true;
+		}
+
+		case ECarespaceJsonValueType::Bool:
+		{
+			bool bValue = false;
+			if (!Reader.ReadBool(bValue))
+			{
+				return false;
+			}
+			OutValue = bValue ? TEXT("true") : TEXT("false");
+			return true;
+		}
+
+		default:
+			return false;
+		}
+	}
+
+	bool ReadValue(FCarespaceJsonReader& Reader, int32& OutValue)
+	{
+		switch (Reader.PeekType())
+		{
+		case ECarespaceJsonValueType::Number:
+		{
+			int64 Value = 0;
+			if (!Reader.ReadInteger(Value))
+			{
+				return false;
+			}
+			OutValue = static_cast<int32>(Value);
+			return true;
+		}
+
+		case ECarespaceJsonValueType::String:
+		{
+			FString Text;
+			if (!Reader.ReadString(Text))
+			{
+				return false;
+			}
+			OutValue = static_cast<int32>(FCString::Atoi64(*Text));
+			return true;
+		}
+
+		case ECarespaceJsonValueType::Bool:
+		{
+			bool bValue = false;
+			if (!Reader.ReadBool(bValue))
+			{
+				return false;
+			}
+			OutValue = bValue ? 1 : 0;
+			return true;
+		}
+
+		default:
+			return false;
+		}
+	}
+
+	bool ReadValue(FCarespaceJsonReader& Reader, bool& OutValue)
+	{
+		switch (Reader.PeekType())
+		{
+		case ECarespaceJsonValueType::Bool:
+			return Reader.ReadBool(OutValue);
+
+		case ECarespaceJsonValueType::Number:
+		{
+			double Value = 0.0;
+			if (!Reader.ReadNumber(Value))
+			{
+				return false;
+			}
+			OutValue = Value != 0.0;
+			return true;
+		}
+
+		case ECarespaceJsonValueType::String:
+		{
+			TArrayView<const uint8> Raw;
+			bool bHasEscapes = false;
+			if (!Reader.ReadRawString(Raw, bHasEscapes))
+			{
+				return false;
+			}
+			// FJsonValueString::TryGetBool accepts "true" in any case
+			OutValue = Raw.Num() == 4 && (Raw[0] | 0x20) == 't' && (Raw[1] | 0x20) == 'r' && (Raw[2] | 0x20) == 'u' && (Raw[3] | 0x20) == 'e';
+			return true;
+		}
+
+		default:
+			return false;
+		}
+	}
+
+	bool ReadValue(FCarespaceJsonReader& Reader, FDateTime& OutValue)
+	{
+		TArrayView<const uint8> Raw;
+		bool bHasEscapes = false;
+		if (Reader.PeekType() != ECarespaceJsonValueType::String || !Reader.ReadRawString(Raw, bHasEscapes))
+		{
+			return false;
+		}
+
+		// API timestamps take the fixed-format parser; the engine parsers below cover everything else
+		int64 Ticks = 0;
+		if (!bHasEscapes && FCarespaceTimestamp::ParseTicks(Raw, Ticks))
+		{
+			OutValue = FDateTime(Ticks);
+			return true;
+		}
+
+		if (RawEquals(Raw, "min", 3))
+		{
+			OutValue = FDateTime::MinValue();
+			return true;
+		}
+		if (RawEquals(Raw, "max", 3))
+		{
+			OutValue = FDateTime::MaxValue();
+			return true;
+		}
+		if (RawEquals(Raw, "now", 3))
+		{
+			OutValue = FDateTime::UtcNow();
+			return true;
+		}
+
+		const FString Text = FCarespaceJsonReader::RawStringToString(Raw, bHasEscapes);
+		return FDateTime::ParseIso8601(*Text, OutValue) || FDateTime::Parse(Text, OutValue);
+	}
+
+	void WriteValue(FCarespaceJsonWriter& Writer, const FString& Value)
+	{
+		Writer.WriteString(Value);
+	}
+
+	void WriteValue(FCarespaceJsonWriter& Writer, int32 Value)
+	{
+		Writer.WriteInteger(Value);
+	}
+
+	void WriteValue(FCarespaceJsonWriter& Writer, bool Value)
+	{
+		Writer.WriteBool(Value);
+	}
+
+	void WriteValue(FCarespaceJsonWriter& Writer, const FDateTime& Value)
+	{
+		// Same text as FDateTime::ExportTextItem, which FJsonObjectConverter writes
+		Writer.WriteString(Value.ToString());
+	}
+}
@@ -0,0 +1,173 @@
+#include "CarespaceJsonStream.h"
+
+FCarespaceJsonStreamDecoder::FCarespaceJsonStreamDecoder(const FString& InArrayField)
+{
+	const FTCHARToUTF8 Utf8Field(*InArrayField);
+	ArrayField.Append(reinterpret_cast<const uint8*>(Utf8Field.Get()), Utf8Field.Length());
+
+	Reset();
+}
+
+void FCarespaceJsonStreamDecoder::Reset()
+{
+	Key.Reset();
+	Element.Reset();
+	Depth = 0;
+	NumElements = 0;
+	bInString = false;
+	bEscaped = false;
+	bExpectKey = false;
+	bReadingKey = false;
+	bInArray = false;
+	bInElement = false;
+	bStarted = false;
+	bComplete = false;
+	bFailed = false;
+}
+
+void FCarespaceJsonStreamDecoder::Feed(TArrayView<const uint8> Bytes)
+{
+	// Only the structure is tracked here: nesting depth, string state and the top-level key being read.
+	// The elements themselves are validated by whoever parses them in HandleElement.
+	for (const uint8 Char : Bytes)
+	{
+		if (bFailed)
+		{
+			return;
+		}
+
+		if (bInElement)
+		{
+			Element.Add(Char);
+		}
+
+		if (bInString)
+		{
+			if (bEscaped)
+			{
+				bEscaped = false;
+				if (bReadingKey)
+				{
+					Key.Add(Char);
+				}
+			}
+			else if (Char == '\\')
+			{
+				bEscaped = true;
+			}
+			else if (Char == '"')
+			{
+				bInString = false;
+				bReadingKey = false;
+			}
+			else if (bReadingKey)
+			{
+				Key.Add(Char);
+			}
+			continue;
+		}
+
+		if (Char == ' ' || Char == '\t' || Char == '\n' || Char == '\r')
+		{
+			continue;
+		}
+
+		// Anything but a single object, e.g. a compressed body or trailing garbage, is not ours to decode
+		if (bComplete || (!bStarted && Char != '{'))
+		{
+			bFailed = true;
+			return;
+		}
+		bStarted = true;
+
+		// A value starting directly inside the array is the next element
+		if (bInArray && Depth == 2 && !bInElement && Char != ',' && Char != ']')
+		{
+			bInElement = true;
+			Element.Reset();
+			Element.Add(Char);
+		}
+
+		switch (Char)
+		{
+		case '"':
+			bInString = true;
+			if (Depth == 1 && bExpectKey)
+			{
+				bReadingKey = true;
+				Key.Reset();
+			}
+			break;
+
+		case '{':
+		case '[':
+			if (Depth == 0)
+			{
+				bExpectKey = true;
+			}
+			else if (Depth == 1 && Char == '[' && !bExpectKey && Key == ArrayField)
+			{
+				bInArray = true;
+			}
+			++Depth;
+			break;
+
+		case '}':
+		case ']':
+			if (--Depth < 0)
+			{
+				bFailed = true;
+				return;
+			}
+
+			if (bInArray && Depth == 2 && bInElement)
+			{
+				// Closing bracket of an object or array element
+				EmitElement(Element.Num());
+			}
+			else if (bInArray && Depth == 1)
+			{
+				// End of the array; a scalar element still open ends right before the bracket
+				if (bInElement)
+				{
+					EmitElement(Element.Num() - 1);
+				}
+				bInArray = false;
+			}
+
+			bComplete = Depth == 0;
+			break;
+
+		case ',':
+			if (Depth == 1)
+			{
+				bExpectKey = true;
+			}
+			else if (bInArray && Depth == 2 && bInElement)
+			{
+				EmitElement(Element.Num() - 1);
+			}
+			break;
+
+		case ':':
+			if (Depth == 1)
+			{
+				bExpectKey = false;
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+void FCarespaceJsonStreamDecoder::EmitElement(int32 Length)
+{
+	HandleElement(TArrayView<const uint8>(Element.GetData(), Length));
+	++NumElements;
+
+	// Keep the buffer's capacity; the next element is usually about as large
+	bInElement = false;
+	Element.Reset();
+}
@@ -0,0 +1,55 @@
+#include "CarespaceLatencyTracker.h"
+
+FCarespaceLatencyTracker::FCarespaceLatencyTracker(int32 InWindowSize)
+	: WindowSize(FMath::Max(1, InWindowSize))
+{
+}
+
+FString FCarespaceLatencyTracker::GetEndpointFamily(const FString& Endpoint)
+{
+	int32 SegmentEnd = INDEX_NONE;
+	for (int32 Index = 1; Index < Endpoint.Len(); ++Index)
+	{
+		if (Endpoint[Index] == TEXT('/') || Endpoint[Index] == TEXT('?'))
+		{
+			SegmentEnd = Index;
+			break;
+		}
+	}
+	return SegmentEnd == INDEX_NONE ? Endpoint : Endpoint.Left(SegmentEnd);
+}
+
+void FCarespaceLatencyTracker::AddSample(const FString& Key, double Seconds)
+{
+	FWindow& Window = Windows.FindOrAdd(Key);
+	if (Window.Samples.Num() < WindowSize)
+	{
+		Window.Samples.Add(static_cast<float>(Seconds));
+		return;
+	}
+
+	// Overwrite the oldest sample once the window is full
+	Window.Samples[Window.NextIndex] = static_cast<float>(Seconds);
+	Window.NextIndex = (Window.NextIndex + 1) % WindowSize;
+}
+
+bool FCarespaceLatencyTracker::GetPercentile(const FString& Key, float Percentile, int32 MinSamples, double& OutSeconds) const
+{
+	const FWindow* Window = Windows.Find(Key);
+	if (!Window || Window->Samples.Num() == 0 || Window->Samples.Num() < MinSamples)
+	{
+		return false;
+	}
+
+	TArray<float, TInlineAllocator<128>> Sorted(Window->Samples);
+	Sorted.Sort();
+
+	const int32 Rank = FMath::CeilToInt(FMath::Clamp(Percentile, 0.0f, 1.0f) * Sorted.Num()) - 1;
+	OutSeconds = Sorted[FMath::Clamp(Rank, 0, Sorted.Num() - 1)];
+	return true;
+}
+
+void FCarespaceLatencyTracker::Reset()
+{
+	Windows.Empty();
+}
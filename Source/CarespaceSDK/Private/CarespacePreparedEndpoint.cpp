@@ -0,0 +1,84 @@
+#include "CarespacePreparedEndpoint.h"
+
+FCarespacePreparedEndpoint::FCarespacePreparedEndpoint(const TCHAR* InVerb, const TCHAR* InPathTemplate)
+	: Verb(FString(InVerb).ToUpper())
+	, PathTemplate(InPathTemplate)
+{
+	Options.Priority = PathTemplate.StartsWith(TEXT("/auth/")) ? ECarespaceRequestPriority::Auth : ECarespaceRequestPriority::Interactive;
+	ParseTemplate();
+}
+
+FCarespacePreparedEndpoint::FCarespacePreparedEndpoint(const TCHAR* InVerb, const TCHAR* InPathTemplate, const FCarespaceRequestOptions& InOptions)
+	: Verb(FString(InVerb).ToUpper())
+	, PathTemplate(InPathTemplate)
+	, Options(InOptions)
+{
+	ParseTemplate();
+}
+
+void FCarespacePreparedEndpoint::ParseTemplate()
+{
+	FString Literal;
+	int32 Index = 0;
+
+	while (Index < PathTemplate.Len())
+	{
+		const int32 Close = PathTemplate[Index] == TEXT('{') ? PathTemplate.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Index) : INDEX_NONE;
+		if (Close == INDEX_NONE)
+		{
+			Literal.AppendChar(PathTemplate[Index++]);
+			continue;
+		}
+
+		Literals.Add(MoveTemp(Literal));
+		Literal.Reset();
+		Index = Close + 1;
+	}
+
+	Literals.Add(MoveTemp(Literal));
+}
+
+bool FCarespacePreparedEndpoint::AppendPath(FStringBuilderBase& Out, TArrayView<const FStringView> Arguments) const
+{
+	if (Arguments.Num() != GetNumArguments())
+	{
+		UE_LOG(LogTemp, Error, TEXT("CarespacePreparedEndpoint: %s expects %d arguments, got %d"), *PathTemplate, GetNumArguments(), Arguments.Num());
+		return false;
+	}
+
+	Out.Append(Literals[0]);
+	for (int32 Index = 0; Index < Arguments.Num(); ++Index)
+	{
+		AppendUrlEncoded(Out, Arguments[Index]);
+		Out.Append(Literals[Index + 1]);
+	}
+	return true;
+}
+
+void FCarespacePreparedEndpoint::AppendUrlEncoded(FStringBuilderBase& Out, FStringView Value)
+{
+	static const TCHAR* HexDigits = TEXT("0123456789ABCDEF");
+
+	for (int32 Index = 0; Index < Value.Len(); ++Index)
+	{
+		const TCHAR Char = Value[Index];
+		if ((Char >= TEXT('a') && Char <= TEXT('z')) || (Char >= TEXT('A') && Char <= TEXT('Z')) || (Char >= TEXT('0') && Char <= TEXT('9'))
+			|| Char == TEXT('-') || Char == TEXT('_') || Char == TEXT('.') || Char == TEXT('~'))
+		{
+			Out.AppendChar(Char);
+			continue;
+		}
+
+		// Percent-encode the UTF-8 bytes of anything else, including surrogate pairs
+		const int32 CodeUnits = (FChar::IsHighSurrogate(Char) && Index + 1 < Value.Len()) ? 2 : 1;
+		FTCHARToUTF8 Utf8(Value.GetData() + Index, CodeUnits);
+		for (int32 ByteIndex = 0; ByteIndex < Utf8.Length(); ++ByteIndex)
+		{
+			const uint8 Byte = static_cast<uint8>(Utf8.Get()[ByteIndex]);
+			Out.AppendChar(TEXT('%'));
+			Out.AppendChar(HexDigits[Byte >> 4]);
+			Out.AppendChar(HexDigits[Byte & 0x0f]);
+		}
+		Index += CodeUnits - 1;
+	}
+}
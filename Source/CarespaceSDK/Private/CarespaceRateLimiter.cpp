@@ -0,0 +1,186 @@
+#include "CarespaceRateLimiter.h"
+
+namespace CarespaceRateLimiter
+{
+	// Values below this are treated as "seconds until reset" rather than a Unix timestamp
+	static constexpr int64 MinUnixTimestamp = 1000000000;
+
+	// Fallback wait after a 429 when the server gave no hint at all
+	static constexpr double DefaultRateLimitedDelay = 1.0;
+}
+
+FCarespaceRateLimiter::FCarespaceRateLimiter()
+{
+	// Limits documented in API-REFERENCE.md; corrected from response headers once known
+	SetDefaultBudget(TEXT("auth"), 5, 60.0);
+	SetDefaultBudget(TEXT("standard"), 1000, 3600.0);
+	SetDefaultBudget(TEXT("bulk"), 100, 3600.0);
+}
+
+FString FCarespaceRateLimiter::GetEndpointClass(const FString& Endpoint)
+{
+	if (Endpoint.StartsWith(TEXT("/auth/")))
+	{
+		return TEXT("auth");
+	}
+
+	if (Endpoint.Contains(TEXT("/bulk")) || Endpoint.Contains(TEXT("/import")))
+	{
+		return TEXT("bulk");
+	}
+
+	return TEXT("standard");
+}
+
+void FCarespaceRateLimiter::SetDefaultBudget(const FString& EndpointClass, int32 Limit, double WindowSeconds)
+{
+	const double Now = FPlatformTime::Seconds();
+	FBucket& Bucket = Buckets.FindOrAdd(EndpointClass);
+
+	if (Bucket.bLearnedFromServer)
+	{
+		return;
+	}
+
+	Bucket.Capacity = FMath::Max(1, Limit);
+	Bucket.Tokens = Bucket.Capacity;
+	Bucket.WindowSeconds = FMath::Max(1.0, WindowSeconds);
+	Bucket.RefillPerSecond = Bucket.Capacity / Bucket.WindowSeconds;
+	Bucket.LastRefillTime = Now;
+}
+
+double FCarespaceRateLimiter::GetWaitTime(const FString& EndpointClass, double Now)
+{
+	FBucket& Bucket = FindOrAddBucket(EndpointClass, Now);
+	Refill(Bucket, Now);
+
+	if (Now < Bucket.BlockedUntil)
+	{
+		return Bucket.BlockedUntil - Now;
+	}
+
+	if (Bucket.Tokens >= 1.0)
+	{
+		return 0.0;
+	}
+
+	double Wait = Bucket.RefillPerSecond > 0.0 ? (1.0 - Bucket.Tokens) / Bucket.RefillPerSecond : Bucket.WindowSeconds;
+	if (Bucket.ResetTime > Now)
+	{
+		Wait = FMath::Min(Wait, Bucket.ResetTime - Now);
+	}
+	return Wait;
+}
+
+void FCarespaceRateLimiter::ConsumeToken(const FString& EndpointClass, double Now)
+{
+	FBucket& Bucket = FindOrAddBucket(EndpointClass, Now);
+	Refill(Bucket, Now);
+	Bucket.Tokens = FMath::Max(0.0, Bucket.Tokens - 1.0);
+}
+
+void FCarespaceRateLimiter::UpdateFromHeaders(const FString& EndpointClass, int32 Limit, int32 Remaining, int64 Reset, double Now)
+{
+	FBucket& Bucket = FindOrAddBucket(EndpointClass, Now);
+	Refill(Bucket, Now);
+
+	if (Limit > 0)
+	{
+		Bucket.Capacity = Limit;
+	}
+
+	if (Reset >= 0)
+	{
+		const int64 SecondsUntilReset = Reset >= CarespaceRateLimiter::MinUnixTimestamp
+			? Reset - FDateTime::UtcNow().ToUnixTimestamp()
+			: Reset;
+
+		Bucket.ResetTime = Now + FMath::Max<int64>(0, SecondsUntilReset);
+
+		// The first response of a window reports (almost) the whole window length
+		Bucket.WindowSeconds = FMath::Max(Bucket.WindowSeconds, static_cast<double>(SecondsUntilReset));
+	}
+
+	Bucket.RefillPerSecond = Bucket.Capacity / FMath::Max(1.0, Bucket.WindowSeconds);
+
+	if (Remaining >= 0)
+	{
+		// The server is authoritative; never believe we have more budget than it reports
+		Bucket.Tokens = FMath::Min(Bucket.Tokens, static_cast<double>(Remaining));
+
+		if (Remaining == 0 && Bucket.ResetTime > Now)
+		{
+			Bucket.BlockedUntil = FMath::Max(Bucket.BlockedUntil, Bucket.ResetTime);
+		}
+	}
+
+	Bucket.Tokens = FMath::Min(Bucket.Tokens, Bucket.Capacity);
+	Bucket.bLearnedFromServer = true;
+}
+
+void FCarespaceRateLimiter::HandleRateLimited(const FString& EndpointClass, double RetryAfterSeconds, double Now)
+{
+	FBucket& Bucket = FindOrAddBucket(EndpointClass, Now);
+	Bucket.Tokens = 0.0;
+	Bucket.LastRefillTime = Now;
+
+	double Delay = RetryAfterSeconds;
+	if (Delay < 0.0)
+	{
+		Delay = Bucket.ResetTime > Now ? Bucket.ResetTime - Now : CarespaceRateLimiter::DefaultRateLimitedDelay;
+	}
+
+	Bucket.BlockedUntil = FMath::Max(Bucket.BlockedUntil, Now + Delay);
+}
+
+TArray<FCarespaceRateLimitState> FCarespaceRateLimiter::GetStates(double Now)
+{
+	TArray<FCarespaceRateLimitState> States;
+	States.Reserve(Buckets.Num());
+
+	for (TPair<FString, FBucket>& Pair : Buckets)
+	{
+		FBucket& Bucket = Pair.Value;
+		Refill(Bucket, Now);
+
+		FCarespaceRateLimitState& State = States.AddDefaulted_GetRef();
+		State.EndpointClass = Pair.Key;
+		State.Limit = FMath::RoundToInt(Bucket.Capacity);
+		State.AvailableTokens = Now < Bucket.BlockedUntil ? 0.0f : static_cast<float>(Bucket.Tokens);
+		State.RefillPerSecond = static_cast<float>(Bucket.RefillPerSecond);
+		State.SecondsUntilReset = static_cast<float>(FMath::Max(0.0, Bucket.ResetTime - Now));
+		State.bLearnedFromServer = Bucket.bLearnedFromServer;
+	}
+
+	return States;
+}
+
+FCarespaceRateLimiter::FBucket& FCarespaceRateLimiter::FindOrAddBucket(const FString& EndpointClass, double Now)
+{
+	if (FBucket* Bucket = Buckets.Find(EndpointClass))
+	{
+		return *Bucket;
+	}
+
+	// Unknown classes share the standard budget until the server tells us otherwise
+	FBucket NewBucket = Buckets.FindRef(TEXT("standard"));
+	NewBucket.Tokens = NewBucket.Capacity;
+	NewBucket.LastRefillTime = Now;
+	return Buckets.Add(EndpointClass, NewBucket);
+}
+
+void FCarespaceRateLimiter::Refill(FBucket& Bucket, double Now)
+{
+	if (Bucket.ResetTime > 0.0 && Now >= Bucket.ResetTime)
+	{
+		// The server window rolled over; the full budget is available again
+		Bucket.Tokens = Bucket.Capacity;
+		Bucket.ResetTime = 0.0;
+	}
+	else if (Now > Bucket.LastRefillTime)
+	{
+		Bucket.Tokens = FMath::Min(Bucket.Capacity, Bucket.Tokens + (Now - Bucket.LastRefillTime) * Bucket.RefillPerSecond);
+	}
+
+	Bucket.LastRefillTime = Now;
+}
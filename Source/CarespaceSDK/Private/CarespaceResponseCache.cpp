@@ -0,0 +1,85 @@
+#include "CarespaceResponseCache.h"
+
+FCarespaceResponseCache::FCarespaceResponseCache(int64 InMaxBytes)
+	: MaxBytes(FMath::Max<int64>(0, InMaxBytes))
+	, TotalBytes(0)
+{
+}
+
+FCarespaceResponseCache::~FCarespaceResponseCache()
+{
+	Empty();
+}
+
+void FCarespaceResponseCache::SetMaxBytes(int64 InMaxBytes)
+{
+	MaxBytes = FMath::Max<int64>(0, InMaxBytes);
+	EvictToFit(0);
+}
+
+TSharedPtr<const FCarespaceCachedResponse> FCarespaceResponseCache::Find(const FString& Key)
+{
+	FEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return nullptr;
+	}
+
+	// Move to the head of the recency list
+	RecencyList.RemoveNode(Entry->RecencyNode);
+	RecencyList.AddHead(Key);
+	Entry->RecencyNode = RecencyList.GetHead();
+
+	return Entry->Response;
+}
+
+void FCarespaceResponseCache::Store(const FString& Key, TSharedRef<const FCarespaceCachedResponse> Entry)
+{
+	Remove(Key);
+
+	const int64 Size = GetEntrySize(Key, *Entry);
+	if (Size > MaxBytes)
+	{
+		return;
+	}
+
+	EvictToFit(Size);
+
+	RecencyList.AddHead(Key);
+	Entries.Add(Key, FEntry{ Entry, RecencyList.GetHead(), Size });
+	TotalBytes += Size;
+}
+
+void FCarespaceResponseCache::Remove(const FString& Key)
+{
+	if (FEntry* Entry = Entries.Find(Key))
+	{
+		RecencyList.RemoveNode(Entry->RecencyNode);
+		TotalBytes -= Entry->Size;
+		Entries.Remove(Key);
+	}
+}
+
+void FCarespaceResponseCache::Empty()
+{
+	Entries.Empty();
+	RecencyList.Empty();
+	TotalBytes = 0;
+}
+
+int64 FCarespaceResponseCache::GetEntrySize(const FString& Key, const FCarespaceCachedResponse& Response)
+{
+	return Response.Body.Num()
+		+ (Key.Len() + Response.ETag.Len() + Response.LastModified.Len()) * sizeof(TCHAR)
+		+ sizeof(FCarespaceCachedResponse);
+}
+
+void FCarespaceResponseCache::EvictToFit(int64 BytesNeeded)
+{
+	while (TotalBytes + BytesNeeded > MaxBytes && RecencyList.Num() > 0)
+	{
+		// Copy the key; removing the entry frees the list node that owns it
+		const FString OldestKey = RecencyList.GetTail()->GetValue();
+		Remove(OldestKey);
+	}
+}
@@ -1,10 +1,14 @@
 #include "CarespaceSDK.h"
+#include "CarespaceCompletionDispatcher.h"
 
 #define LOCTEXT_NAMESPACE "FCarespaceSDKModule"
 
 void FCarespaceSDKModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file
+	CompletionDispatcher = MakeUnique<FCarespaceCompletionDispatcher>();
+	CompletionDispatcher->Start();
+
 	UE_LOG(LogTemp, Log, TEXT("CarespaceSDK module started"));
 }
 
@@ -12,6 +16,8 @@ void FCarespaceSDKModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	CompletionDispatcher.Reset();
+
 	UE_LOG(LogTemp, Log, TEXT("CarespaceSDK module shutdown"));
 }
 
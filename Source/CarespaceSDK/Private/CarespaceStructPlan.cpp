@@ -0,0 +1,535 @@
+#include "CarespaceStructPlan.h"
+#include "CarespaceJsonSchema.h"
+#include "JsonObjectConverter.h"
+#include "JsonObjectWrapper.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+	// Struct nesting beyond this depth is treated as recursion through an array and left to the converter
+	constexpr int32 MaxStructDepth = 32;
+
+	FRWLock& GetCacheLock()
+	{
+		static FRWLock CacheLock;
+		return CacheLock;
+	}
+
+	TMap<FObjectKey, TSharedRef<const FCarespaceStructPlan>>& GetCache()
+	{
+		static TMap<FObjectKey, TSharedRef<const FCarespaceStructPlan>> Cache;
+		return Cache;
+	}
+
+	bool KeyEquals(TArrayView<const uint8> Key, const TArray<uint8>& Name)
+	{
+		if (Key.Num() != Name.Num())
+		{
+			return false;
+		}
+
+		// Property names are ASCII, so folding the case bit is enough for a case-insensitive compare
+		for (int32 Index = 0; Index < Key.Num(); ++Index)
+		{
+			const uint8 A = Key[Index];
+			const uint8 B = Name[Index];
+			if (A != B && ((A | 0x20) != (B | 0x20) || (A | 0x20) < 'a' || (A | 0x20) > 'z'))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	const FCarespacePropertyPlan* FindProperty(TConstArrayView<FCarespacePropertyPlan> Properties, TArrayView<const uint8> Key, int32& InOutHint)
+	{
+		for (int32 Offset = 0; Offset < Properties.Num(); ++Offset)
+		{
+			const int32 Index = (InOutHint + Offset) % Properties.Num();
+			if (KeyEquals(Key, Properties[Index].ReadKey))
+			{
+				InOutHint = Index + 1;
+				return &Properties[Index];
+			}
+		}
+		return nullptr;
+	}
+
+	/** Reads a number, a numeric string or a bool, the values FJsonValue::AsNumber accepts. */
+	bool ReadNumberLike(FCarespaceJsonReader& Reader, double& OutValue)
+	{
+		switch (Reader.PeekType())
+		{
+		case ECarespaceJsonValueType::Number:
+			return Reader.ReadNumber(OutValue);
+
+		case ECarespaceJsonValueType::String:
+		{
+			FString Text;
+			if (!Reader.ReadString(Text))
+			{
+				return false;
+			}
+			OutValue = FCString::Atod(*Text);
+			return true;
+		}
+
+		case ECarespaceJsonValueType::Bool:
+		{
+			bool bValue = false;
+			if (!Reader.ReadBool(bValue))
+			{
+				return false;
+			}
+			OutValue = bValue ? 1.0 : 0.0;
+			return true;
+		}
+
+		default:
+			return false;
+		}
+	}
+
+	bool ReadIntegerLike(FCarespaceJsonReader& Reader, int64& OutValue)
+	{
+		if (Reader.PeekType() == ECarespaceJsonValueType::Number)
+		{
+			return Reader.ReadInteger(OutValue);
+		}
+
+		// Integer strings are parsed directly so that large values keep their precision
+		if (Reader.PeekType() == ECarespaceJsonValueType::String)
+		{
+			FString Text;
+			if (!Reader.ReadString(Text))
+			{
+				return false;
+			}
+			OutValue = FCString::Atoi64(*Text);
+			return true;
+		}
+
+		double Value = 0.0;
+		if (!ReadNumberLike(Reader, Value))
+		{
+			return false;
+		}
+		OutValue = static_cast<int64>(Value);
+		return true;
+	}
+
+	bool ReadEnumValue(FCarespaceJsonReader& Reader, const UEnum* Enum, const FNumericProperty* Underlying, void* Value)
+	{
+		int64 EnumValue = 0;
+		if (Reader.PeekType() == ECarespaceJsonValueType::String)
+		{
+			FString Name;
+			if (!Reader.ReadString(Name))
+			{
+				return false;
+			}
+
+			EnumValue = Enum->GetValueByNameString(Name);
+			if (EnumValue == INDEX_NONE)
+			{
+				return false;
+			}
+		}
+		else if (!ReadIntegerLike(Reader, EnumValue))
+		{
+			return false;
+		}
+
+		Underlying->SetIntPropertyValue(Value, EnumValue);
+		return true;
+	}
+
+	bool ReadString(FCarespaceJsonReader& Reader, const FCarespacePropertyPlan& Plan, void* Value)
+	{
+		return CarespaceJson::ReadValue(Reader, *static_cast<FString*>(Value));
+	}
+
+	void WriteString(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value)
+	{
+		Writer.WriteString(*static_cast<const FString*>(Value));
+	}
+
+	bool ReadName(FCarespaceJsonReader& Reader, const FCarespacePropertyPlan& Plan, void* Value)
+	{
+		FString Text;
+		if (!CarespaceJson::ReadValue(Reader, Text))
+		{
+			return false;
+		}
+		*static_cast<FName*>(Value) = FName(*Text);
+		return true;
+	}
+
+	void WriteName(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value)
+	{
+		Writer.WriteString(static_cast<const FName*>(Value)->ToString());
+	}
+
+	bool ReadText(FCarespaceJsonReader& Reader, const FCarespacePropertyPlan& Plan, void* Value)
+	{
+		FString Text;
+		if (!CarespaceJson::ReadValue(Reader, Text))
+		{
+			return false;
+		}
+		*static_cast<FText*>(Value) = FText::FromString(MoveTemp(Text));
+		return true;
+	}
+
+	void WriteText(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value)
+	{
+		Writer.WriteString(static_cast<const FText*>(Value)->ToString());
+	}
+
+	bool ReadBool(FCarespaceJsonReader& Reader, const FCarespacePropertyPlan& Plan, void* Value)
+	{
+		bool bValue = false;
+		if (!CarespaceJson::ReadValue(Reader, bValue))
+		{
+			return false;
+		}
+		static_cast<const FBoolProperty*>(Plan.Property)->SetPropertyValue(Value, bValue);
+		return true;
+	}
+
+	void WriteBool(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value)
+	{
+		Writer.WriteBool(static_cast<const FBoolProperty*>(Plan.Property)->GetPropertyValue(Value));
+	}
+
+	bool ReadInteger(FCarespaceJsonReader& Reader, const FCarespacePropertyPlan& Plan, void* Value)
+	{
+		int64 IntValue = 0;
+		if (!ReadIntegerLike(Reader, IntValue))
+		{
+			return false;
+		}
+		static_cast<const FNumericProperty*>(Plan.Property)->SetIntPropertyValue(Value, IntValue);
+		return true;
+	}
+
+	void WriteInteger(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value)
+	{
+		Writer.WriteInteger(static_cast<const FNumericProperty*>(Plan.Property)->GetSignedIntPropertyValue(Value));
+	}
+
+	bool ReadFloat(FCarespaceJsonReader& Reader, const FCarespacePropertyPlan& Plan, void* Value)
+	{
+		double FloatValue = 0.0;
+		if (!ReadNumberLike(Reader, FloatValue))
+		{
+			return false;
+		}
+		static_cast<const FNumericProperty*>(Plan.Property)->SetFloatingPointPropertyValue(Value, FloatValue);
+		return true;
+	}
+
+	void WriteFloat(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value)
+	{
+		Writer.WriteNumber(static_cast<const FNumericProperty*>(Plan.Property)->GetFloatingPointPropertyValue(Value));
+	}
+
+	bool ReadByteEnum(FCarespaceJsonReader& Reader, const FCarespacePropertyPlan& Plan, void* Value)
+	{
+		const FNumericProperty* Property = static_cast<const FNumericProperty*>(Plan.Property);
+		return ReadEnumValue(Reader, Property->GetIntPropertyEnum(), Property, Value);
+	}
+
+	void WriteByteEnum(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value)
+	{
+		const FNumericProperty* Property = static_cast<const FNumericProperty*>(Plan.Property);
+		Writer.WriteString(Property->GetIntPropertyEnum()->GetNameStringByValue(Property->GetSignedIntPropertyValue(Value)));
+	}
+
+	bool ReadEnum(FCarespaceJsonReader& Reader, const FCarespacePropertyPlan& Plan, void* Value)
+	{
+		const FEnumProperty* Property = static_cast<const FEnumProperty*>(Plan.Property);
+		return ReadEnumValue(Reader, Property->GetEnum(), Property->GetUnderlyingProperty(), Value);
+	}
+
+	void WriteEnum(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value)
+	{
+		const FEnumProperty* Property = static_cast<const FEnumProperty*>(Plan.Property);
+		Writer.WriteString(Property->GetEnum()->GetNameStringByValue(Property->GetUnderlyingProperty()->GetSignedIntPropertyValue(Value)));
+	}
+
+	bool ReadDateTime(FCarespaceJsonReader& Reader, const FCarespacePropertyPlan& Plan, void* Value)
+	{
+		return CarespaceJson::ReadValue(Reader, *static_cast<FDateTime*>(Value));
+	}
+
+	void WriteDateTime(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value)
+	{
+		CarespaceJson::WriteValue(Writer, *static_cast<const FDateTime*>(Value));
+	}
+
+	bool ReadStruct(FCarespaceJsonReader& Reader, const FCarespacePropertyPlan& Plan, void* Value)
+	{
+		if (Reader.PeekType() == ECarespaceJsonValueType::Object)
+		{
+			return Plan.Struct->Read(Reader, Value);
+		}
+
+		// Like the converter, strings are accepted for colors and for structs that import text
+		const UScriptStruct* Struct = static_cast<const FStructProperty*>(Plan.Property)->Struct;
+		FString Text;
+		if (Reader.PeekType() != ECarespaceJsonValueType::String || !Reader.ReadString(Text))
+		{
+			return false;
+		}
+
+		if (Struct == TBaseStructure<FLinearColor>::Get())
+		{
+			*static_cast<FLinearColor*>(Value) = FColor::FromHex(Text);
+			return true;
+		}
+		if (Struct == TBaseStructure<FColor>::Get())
+		{
+			*static_cast<FColor*>(Value) = FColor::FromHex(Text);
+			return true;
+		}
+
+		UScriptStruct::ICppStructOps* StructOps = Struct->GetCppStructOps();
+		const TCHAR* Buffer = *Text;
+		return StructOps && StructOps->HasImportTextItem() && StructOps->ImportTextItem(Buffer, Value, PPF_None, nullptr, GWarn);
+	}
+
+	void WriteStructObject(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value)
+	{
+		Plan.Struct->Write(Writer, Value);
+	}
+
+	void WriteStructText(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value)
+	{
+		FString Text;
+		static_cast<const FStructProperty*>(Plan.Property)->Struct->GetCppStructOps()->ExportTextItem(Text, Value, nullptr, nullptr, PPF_None, nullptr);
+		Writer.WriteString(Text);
+	}
+
+	bool ReadArray(FCarespaceJsonReader& Reader, const FCarespacePropertyPlan& Plan, void* Value)
+	{
+		if (!Reader.ReadArrayStart())
+		{
+			return false;
+		}
+
+		FScriptArrayHelper Helper(static_cast<const FArrayProperty*>(Plan.Property), Value);
+		Helper.EmptyValues();
+		while (Reader.ReadNextElement())
+		{
+			const int32 Index = Helper.AddValue();
+			if (!Reader.ReadNull() && !Plan.Inner->Read(Reader, *Plan.Inner, Helper.GetRawPtr(Index)))
+			{
+				return false;
+			}
+		}
+		return !Reader.HasError();
+	}
+
+	void WriteArray(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value)
+	{
+		FScriptArrayHelper Helper(static_cast<const FArrayProperty*>(Plan.Property), Value);
+		Writer.BeginArray();
+		for (int32 Index = 0; Index < Helper.Num(); ++Index)
+		{
+			Plan.Inner->Write(Writer, *Plan.Inner, Helper.GetRawPtr(Index));
+		}
+		Writer.EndArray();
+	}
+}
+
+TSharedRef<const FCarespaceStructPlan> FCarespaceStructPlan::Get(const UStruct* Struct)
+{
+	return GetOrBuild(Struct, 0);
+}
+
+void FCarespaceStructPlan::ResetCache()
+{
+	FWriteScopeLock WriteLock(GetCacheLock());
+	GetCache().Reset();
+}
+
+TSharedRef<const FCarespaceStructPlan> FCarespaceStructPlan::GetOrBuild(const UStruct* Struct, int32 Depth)
+{
+	const FObjectKey Key(Struct);
+	{
+		FReadScopeLock ReadLock(GetCacheLock());
+		if (const TSharedRef<const FCarespaceStructPlan>* Existing = GetCache().Find(Key))
+		{
+			return *Existing;
+		}
+	}
+
+	TSharedRef<FCarespaceStructPlan> Plan = MakeShared<FCarespaceStructPlan>();
+	if (Depth > MaxStructDepth)
+	{
+		Plan->bSupported = false;
+		return Plan;
+	}
+
+	// Built without holding the lock; a plan built concurrently by another thread is equivalent
+	for (TFieldIterator<FProperty> It(Struct); It && Plan->bSupported; ++It)
+	{
+		FCarespacePropertyPlan& PropertyPlan = Plan->Properties.AddDefaulted_GetRef();
+		Plan->bSupported = BuildPropertyPlan(*It, PropertyPlan, Depth);
+
+		// Keys as FJsonObjectConverter reads and writes them
+		const FString AuthoredName = It->GetAuthoredName();
+		const FTCHARToUTF8 ReadKey(*AuthoredName);
+		PropertyPlan.ReadKey.Append(reinterpret_cast<const uint8*>(ReadKey.Get()), ReadKey.Length());
+
+		TArray<uint8> QuotedKey;
+		FCarespaceJsonWriter KeyWriter(QuotedKey);
+		KeyWriter.WriteString(FJsonObjectConverter::StandardizeCase(AuthoredName));
+		PropertyPlan.WriteKey.Append(reinterpret_cast<const ANSICHAR*>(QuotedKey.GetData()) + 1, QuotedKey.Num() - 2);
+	}
+
+	FWriteScopeLock WriteLock(GetCacheLock());
+	return GetCache().FindOrAdd(Key, TSharedRef<const FCarespaceStructPlan>(Plan));
+}
+
+bool FCarespaceStructPlan::BuildPropertyPlan(const FProperty* Property, FCarespacePropertyPlan& OutPlan, int32 Depth)
+{
+	OutPlan.Property = Property;
+	if (Property->ArrayDim != 1)
+	{
+		return false;
+	}
+
+	if (Property->IsA<FStrProperty>())
+	{
+		OutPlan.Read = &ReadString;
+		OutPlan.Write = &WriteString;
+	}
+	else if (Property->IsA<FNameProperty>())
+	{
+		OutPlan.Read = &ReadName;
+		OutPlan.Write = &WriteName;
+	}
+	else if (Property->IsA<FTextProperty>())
+	{
+		OutPlan.Read = &ReadText;
+		OutPlan.Write = &WriteText;
+	}
+	else if (Property->IsA<FBoolProperty>())
+	{
+		OutPlan.Read = &ReadBool;
+		OutPlan.Write = &WriteBool;
+	}
+	else if (Property->IsA<FEnumProperty>())
+	{
+		OutPlan.Read = &ReadEnum;
+		OutPlan.Write = &WriteEnum;
+	}
+	else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+	{
+		if (NumericProperty->GetIntPropertyEnum())
+		{
+			OutPlan.Read = &ReadByteEnum;
+			OutPlan.Write = &WriteByteEnum;
+		}
+		else if (NumericProperty->IsFloatingPoint())
+		{
+			OutPlan.Read = &ReadFloat;
+			OutPlan.Write = &WriteFloat;
+		}
+		else
+		{
+			OutPlan.Read = &ReadInteger;
+			OutPlan.Write = &WriteInteger;
+		}
+	}
+	else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		// The wrapper holds arbitrary JSON, which only the converter knows how to embed
+		if (StructProperty->Struct == FJsonObjectWrapper::StaticStruct())
+		{
+			return false;
+		}
+
+		if (StructProperty->Struct == TBaseStructure<FDateTime>::Get())
+		{
+			OutPlan.Read = &ReadDateTime;
+			OutPlan.Write = &WriteDateTime;
+			return true;
+		}
+
+		OutPlan.Struct = GetOrBuild(StructProperty->Struct, Depth + 1);
+		if (!OutPlan.Struct->IsSupported())
+		{
+			return false;
+		}
+
+		const UScriptStruct::ICppStructOps* StructOps = StructProperty->Struct->GetCppStructOps();
+		OutPlan.Read = &ReadStruct;
+		OutPlan.Write = StructOps && StructOps->HasExportTextItem() ? &WriteStructText : &WriteStructObject;
+	}
+	else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		TSharedRef<FCarespacePropertyPlan> InnerPlan = MakeShared<FCarespacePropertyPlan>();
+		if (!BuildPropertyPlan(ArrayProperty->Inner, *InnerPlan, Depth))
+		{
+			return false;
+		}
+
+		OutPlan.Inner = InnerPlan;
+		OutPlan.Read = &ReadArray;
+		OutPlan.Write = &WriteArray;
+	}
+	else
+	{
+		// Maps, sets, object references and delegates are left to the converter
+		return false;
+	}
+
+	return true;
+}
+
+void FCarespaceStructPlan::Write(FCarespaceJsonWriter& Writer, const void* Struct) const
+{
+	Writer.BeginObject();
+	for (const FCarespacePropertyPlan& Plan : Properties)
+	{
+		Writer.WriteKey(Plan.WriteKey.GetData(), Plan.WriteKey.Num());
+		Plan.Write(Writer, Plan, Plan.Property->ContainerPtrToValuePtr<void>(Struct));
+	}
+	Writer.EndObject();
+}
+
+bool FCarespaceStructPlan::Read(FCarespaceJsonReader& Reader, void* Struct) const
+{
+	if (!Reader.ReadObjectStart())
+	{
+		return false;
+	}
+
+	int32 Hint = 0;
+	TArrayView<const uint8> Key;
+	while (Reader.ReadNextKey(Key))
+	{
+		const FCarespacePropertyPlan* Plan = FindProperty(Properties, Key, Hint);
+		if (!Plan)
+		{
+			if (!Reader.SkipValue())
+			{
+				return false;
+			}
+			continue;
+		}
+
+		if (!Reader.ReadNull() && !Plan->Read(Reader, *Plan, Plan->Property->ContainerPtrToValuePtr<void>(Struct)))
+		{
+			return false;
+		}
+	}
+	return !Reader.HasError();
+}
@@ -0,0 +1,145 @@
+#include "CarespaceTimestamp.h"
+
+namespace
+{
+	// Days from 0001-01-01 to 1970-01-01, the epoch DaysFromCivil counts from
+	constexpr int64 DaysToUnixEpoch = 719162;
+
+	/** @return Days since 1970-01-01 of a proleptic Gregorian date, after Howard Hinnant's days_from_civil */
+	int64 DaysFromCivil(int32 Year, int32 Month, int32 Day)
+	{
+		// Years start in March so that the leap day ends the year
+		Year -= Month <= 2 ? 1 : 0;
+		const int32 Era = Year / 400;
+		const int32 YearOfEra = Year - Era * 400;
+		const int32 DayOfYear = (153 * ((Month + 9) % 12) + 2) / 5 + Day - 1;
+		const int32 DayOfEra = YearOfEra * 365 + YearOfEra / 4 - YearOfEra / 100 + DayOfYear;
+		return static_cast<int64>(Era) * 146097 + DayOfEra - 719468;
+	}
+
+	/**
+	 * Parses the fixed-offset fields of a timestamp. Validity is accumulated in a mask and checked once
+	 * at the end, so well-formed input runs without data-dependent branches up to the fraction.
+	 */
+	template <typename CharType>
+	bool ParseTimestamp(const CharType* Text, int32 Length, int64& OutTicks)
+	{
+		// "YYYY-MM-DD" or at least "YYYY-MM-DDTHH:MM:SS"
+		if (Length != 10 && Length < 19)
+		{
+			return false;
+		}
+
+		uint32 Invalid = 0;
+		auto ReadDigits = [Text, &Invalid](int32 Offset, int32 Count)
+		{
+			int32 Value = 0;
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				const uint32 Digit = static_cast<uint32>(Text[Offset + Index]) - '0';
+				Invalid |= Digit > 9 ? 1 : 0;
+				Value = Value * 10 + static_cast<int32>(Digit);
+			}
+			return Value;
+		};
+		auto Expect = [Text, &Invalid](int32 Offset, uint32 Char)
+		{
+			Invalid |= static_cast<uint32>(Text[Offset]) ^ Char;
+		};
+
+		const int32 Year = ReadDigits(0, 4);
+		const int32 Month = ReadDigits(5, 2);
+		const int32 Day = ReadDigits(8, 2);
+		Expect(4, '-');
+		Expect(7, '-');
+
+		int64 TimeTicks = 0;
+		if (Length > 10)
+		{
+			const CharType Separator = Text[10];
+			Invalid |= (Separator == 'T' || Separator == 't' || Separator == ' ') ? 0 : 1;
+
+			const int32 Hour = ReadDigits(11, 2);
+			const int32 Minute = ReadDigits(14, 2);
+			const int32 Second = ReadDigits(17, 2);
+			Expect(13, ':');
+			Expect(16, ':');
+			Invalid |= (Hour > 23 ? 1 : 0) | (Minute > 59 ? 1 : 0) | (Second > 59 ? 1 : 0);
+			TimeTicks = Hour * ETimespan::TicksPerHour + Minute * ETimespan::TicksPerMinute + Second * ETimespan::TicksPerSecond;
+
+			// Digits past the 100 ns resolution of FDateTime are read and dropped
+			int32 Offset = 19;
+			if (Offset < Length && Text[Offset] == '.')
+			{
+				const int32 FractionStart = ++Offset;
+				int64 Scale = ETimespan::TicksPerSecond;
+				for (; Offset < Length && static_cast<uint32>(Text[Offset]) - '0' <= 9; ++Offset)
+				{
+					Scale /= 10;
+					TimeTicks += (static_cast<uint32>(Text[Offset]) - '0') * Scale;
+				}
+				Invalid |= Offset == FractionStart ? 1 : 0;
+			}
+
+			// Without a zone the time is UTC, as FDateTime::ParseIso8601 reads it too
+			if (Offset < Length)
+			{
+				const CharType Zone = Text[Offset];
+				if ((Zone == '+' || Zone == '-') && Length - Offset == 6)
+				{
+					const int32 ZoneHour = ReadDigits(Offset + 1, 2);
+					const int32 ZoneMinute = ReadDigits(Offset + 4, 2);
+					Expect(Offset + 3, ':');
+					Invalid |= (ZoneHour > 23 ? 1 : 0) | (ZoneMinute > 59 ? 1 : 0);
+
+					const int64 ZoneTicks = ZoneHour * ETimespan::TicksPerHour + ZoneMinute * ETimespan::TicksPerMinute;
+					TimeTicks -= Zone == '+' ? ZoneTicks : -ZoneTicks;
+				}
+				else
+				{
+					Invalid |= ((Zone == 'Z' || Zone == 'z') && Length - Offset == 1) ? 0 : 1;
+				}
+			}
+		}
+
+		const bool bLeapYear = Year % 4 == 0 && (Year % 100 != 0 || Year % 400 == 0);
+		const int32 DaysInMonth = Month == 2 ? (bLeapYear ? 29 : 28) : 30 + ((Month + (Month >> 3)) & 1);
+		Invalid |= (Year < 1 ? 1 : 0) | (Month < 1 || Month > 12 ? 1 : 0) | (Day < 1 || Day > DaysInMonth ? 1 : 0);
+		if (Invalid)
+		{
+			return false;
+		}
+
+		// An offset can still push the first or last day of the calendar out of range
+		const int64 Ticks = (DaysFromCivil(Year, Month, Day) + DaysToUnixEpoch) * ETimespan::TicksPerDay + TimeTicks;
+		if (Ticks < 0 || Ticks > FDateTime::MaxValue().GetTicks())
+		{
+			return false;
+		}
+
+		OutTicks = Ticks;
+		return true;
+	}
+}
+
+bool FCarespaceTimestamp::ParseTicks(TArrayView<const uint8> Utf8, int64& OutTicks)
+{
+	return ParseTimestamp(Utf8.GetData(), Utf8.Num(), OutTicks);
+}
+
+bool FCarespaceTimestamp::ParseTicks(FStringView Text, int64& OutTicks)
+{
+	return ParseTimestamp(Text.GetData(), Text.Len(), OutTicks);
+}
+
+bool FCarespaceTimestamp::Parse(FStringView Text, FDateTime& OutDateTime)
+{
+	int64 Ticks = 0;
+	if (!ParseTicks(Text, Ticks))
+	{
+		return false;
+	}
+
+	OutDateTime = FDateTime(Ticks);
+	return true;
+}
@@ -4,6 +4,7 @@
 #include "UObject/NoExportTypes.h"
 #include "CarespaceHTTPClient.h"
 #include "CarespaceAuthAPI.h"
+#include "CarespaceJsonStream.h"
 #include "CarespaceTypes.h"
 #include "CarespaceAPI.generated.h"
 
@@ -32,9 +33,11 @@ public:
 	 * 
 	 * @param InBaseURL The base URL for the Carespace API (default: development server)
 	 * @param InAPIKey The API key for authentication (can be set later with SetAPIKey)
+	 * @param bInWarmUpConnection Open a connection to the base URL right away, and again whenever it changes,
+	 *        so the first request (usually the login) does not pay for DNS, TCP and TLS setup (default: false)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Carespace")
-	void Initialize(const FString& InBaseURL = TEXT("https://api-dev.carespace.ai"), const FString& InAPIKey = TEXT(""));
+	void Initialize(const FString& InBaseURL = TEXT("https://api-dev.carespace.ai"), const FString& InAPIKey = TEXT(""), bool bInWarmUpConnection = false);
 
 	/**
 	 * Sets the API key used for authenticating requests.
@@ -88,27 +91,30 @@ public:
 	 * @param Limit Number of users per page (default: 20, max: 100)
 	 * @param Search Optional search term to filter users by name or email
 	 * @param OnComplete Delegate called when the request completes with user data or error
+	 * @return Handle that cancels the request, e.g. when the calling widget closes
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Carespace|Users")
-	void GetUsers(int32 Page = 1, int32 Limit = 20, const FString& Search = TEXT(""), const FOnCarespaceUsersReceived& OnComplete = FOnCarespaceUsersReceived());
+	FCarespaceRequestHandle GetUsers(int32 Page = 1, int32 Limit = 20, const FString& Search = TEXT(""), const FOnCarespaceUsersReceived& OnComplete = FOnCarespaceUsersReceived());
 
 	/**
 	 * Retrieves detailed information for a specific user.
 	 * 
 	 * @param UserId Unique identifier of the user to retrieve
 	 * @param OnComplete Delegate called when the request completes with user data or error
+	 * @return Handle that cancels the request, e.g. when the calling widget closes
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Carespace|Users")
-	void GetUser(const FString& UserId, const FOnCarespaceUsersReceived& OnComplete);
+	FCarespaceRequestHandle GetUser(const FString& UserId, const FOnCarespaceUsersReceived& OnComplete);
 
 	/**
 	 * Creates a new user in the Carespace system.
 	 * 
 	 * @param UserRequest Complete user information including email, name, and role
 	 * @param OnComplete Delegate called when the request completes with created user data or error
+	 * @return Handle that cancels the request, e.g. when the calling widget closes
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Carespace|Users")
-	void CreateUser(const FCarespaceCreateUserRequest& UserRequest, const FOnCarespaceUsersReceived& OnComplete);
+	FCarespaceRequestHandle CreateUser(const FCarespaceCreateUserRequest& UserRequest, const FOnCarespaceUsersReceived& OnComplete);
 
 	/**
 	 * Retrieves a paginated list of clients (patients) from the Carespace API.
@@ -117,27 +123,30 @@ public:
 	 * @param Limit Number of clients per page (default: 20, max: 100)
 	 * @param Search Optional search term to filter clients by name or identifier
 	 * @param OnComplete Delegate called when the request completes with client data or error
+	 * @return Handle that cancels the request, e.g. when the calling widget closes
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Carespace|Clients")
-	void GetClients(int32 Page = 1, int32 Limit = 20, const FString& Search = TEXT(""), const FOnCarespaceClientsReceived& OnComplete = FOnCarespaceClientsReceived());
+	FCarespaceRequestHandle GetClients(int32 Page = 1, int32 Limit = 20, const FString& Search = TEXT(""), const FOnCarespaceClientsReceived& OnComplete = FOnCarespaceClientsReceived());
 
 	/**
 	 * Retrieves detailed information for a specific client.
 	 * 
 	 * @param ClientId Unique identifier of the client to retrieve
 	 * @param OnComplete Delegate called when the request completes with client data or error
+	 * @return Handle that cancels the request, e.g. when the calling widget closes
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Carespace|Clients")
-	void GetClient(const FString& ClientId, const FOnCarespaceClientsReceived& OnComplete);
+	FCarespaceRequestHandle GetClient(const FString& ClientId, const FOnCarespaceClientsReceived& OnComplete);
 
 	/**
 	 * Creates a new client (patient) in the Carespace system.
 	 * 
 	 * @param ClientData Complete client information including personal details and medical data
 	 * @param OnComplete Delegate called when the request completes with created client data or error
+	 * @return Handle that cancels the request, e.g. when the calling widget closes
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Carespace|Clients")
-	void CreateClient(const FCarespaceClient& ClientData, const FOnCarespaceClientsReceived& OnComplete);
+	FCarespaceRequestHandle CreateClient(const FCarespaceClient& ClientData, const FOnCarespaceClientsReceived& OnComplete);
 
 	/**
 	 * Retrieves a paginated list of rehabilitation programs from the Carespace API.
@@ -146,27 +155,79 @@ public:
 	 * @param Limit Number of programs per page (default: 20, max: 100)
 	 * @param Category Optional category filter (e.g., "physical-therapy", "occupational-therapy")
 	 * @param OnComplete Delegate called when the request completes with program data or error
+	 * @return Handle that cancels the request, e.g. when the calling widget closes
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Carespace|Programs")
-	void GetPrograms(int32 Page = 1, int32 Limit = 20, const FString& Category = TEXT(""), const FOnCarespaceProgramsReceived& OnComplete = FOnCarespaceProgramsReceived());
+	FCarespaceRequestHandle GetPrograms(int32 Page = 1, int32 Limit = 20, const FString& Category = TEXT(""), const FOnCarespaceProgramsReceived& OnComplete = FOnCarespaceProgramsReceived());
 
 	/**
 	 * Retrieves detailed information for a specific rehabilitation program.
 	 * 
 	 * @param ProgramId Unique identifier of the program to retrieve
 	 * @param OnComplete Delegate called when the request completes with program data or error
+	 * @return Handle that cancels the request, e.g. when the calling widget closes
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Carespace|Programs")
-	void GetProgram(const FString& ProgramId, const FOnCarespaceProgramsReceived& OnComplete);
+	FCarespaceRequestHandle GetProgram(const FString& ProgramId, const FOnCarespaceProgramsReceived& OnComplete);
 
 	/**
 	 * Creates a new rehabilitation program in the Carespace system.
 	 * 
 	 * @param ProgramData Complete program information including exercises, duration, and goals
 	 * @param OnComplete Delegate called when the request completes with created program data or error
+	 * @return Handle that cancels the request, e.g. when the calling widget closes
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Carespace|Programs")
-	void CreateProgram(const FCarespaceProgram& ProgramData, const FOnCarespaceProgramsReceived& OnComplete);
+	FCarespaceRequestHandle CreateProgram(const FCarespaceProgram& ProgramData, const FOnCarespaceProgramsReceived& OnComplete);
+
+	// Latest-wins queries
+	/**
+	 * Sets how long the Search* calls wait for input to settle before sending a request.
+	 *
+	 * @param Seconds Debounce interval (0 sends immediately, default: 0.25)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace")
+	void SetSearchDebounce(float Seconds);
+
+	/**
+	 * Latest-wins variant of GetUsers for search-as-you-type fields.
+	 * Each call supersedes the previous one: a request that has not been sent yet is replaced,
+	 * one in flight is cancelled, and a late response is dropped, so OnComplete is only called
+	 * with results for the most recent Search.
+	 *
+	 * @param Page Page number to retrieve (1-based)
+	 * @param Limit Number of users per page
+	 * @param Search Search term to filter users by name or email
+	 * @param OnComplete Delegate called with the results of the latest search only
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Users")
+	void SearchUsers(int32 Page, int32 Limit, const FString& Search, const FOnCarespaceUsersReceived& OnComplete);
+
+	/**
+	 * Latest-wins variant of GetClients for search-as-you-type fields such as patient pickers.
+	 *
+	 * @param Page Page number to retrieve (1-based)
+	 * @param Limit Number of clients per page
+	 * @param Search Search term to filter clients by name or identifier
+	 * @param OnComplete Delegate called with the results of the latest search only
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Clients")
+	void SearchClients(int32 Page, int32 Limit, const FString& Search, const FOnCarespaceClientsReceived& OnComplete);
+
+	/**
+	 * Latest-wins variant of GetPrograms for category filters that change quickly.
+	 *
+	 * @param Page Page number to retrieve (1-based)
+	 * @param Limit Number of programs per page
+	 * @param Category Category to filter programs by
+	 * @param OnComplete Delegate called with the results of the latest filter only
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Programs")
+	void SearchPrograms(int32 Page, int32 Limit, const FString& Category, const FOnCarespaceProgramsReceived& OnComplete);
+
+	/** Cancels every pending Search* query; none of their callbacks will be called. */
+	UFUNCTION(BlueprintCallable, Category = "Carespace")
+	void CancelPendingSearches();
 
 	/**
 	 * Static factory method to create and initialize a new Carespace API instance.
@@ -186,30 +247,57 @@ private:
 	UPROPERTY()
 	UCarespaceAuthAPI* AuthAPI;
 
-	// Response handlers
-	UFUNCTION()
-	void HandleUsersResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceUsersReceived OnComplete);
+	bool bWarmUpConnection;
 
-	UFUNCTION()
-	void HandleSingleUserResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceUsersReceived OnComplete);
+	// Latest-wins state of one query stream; responses of older generations are dropped
+	struct FSupersedeChannel
+	{
+		FTSTicker::FDelegateHandle DebounceHandle;
+		FCarespaceRequestHandle InFlight;
+		uint32 Generation = 0;
+	};
 
-	UFUNCTION()
-	void HandleClientsResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceClientsReceived OnComplete);
+	FSupersedeChannel UserSearchChannel;
+	FSupersedeChannel ClientSearchChannel;
+	FSupersedeChannel ProgramSearchChannel;
+	float SearchDebounceSeconds;
 
-	UFUNCTION()
-	void HandleSingleClientResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceClientsReceived OnComplete);
+	void IssueLatest(FSupersedeChannel& Channel, TFunction<FCarespaceRequestHandle(uint32)> Issue);
+	static void CancelChannel(FSupersedeChannel& Channel);
+	FCarespaceRequestHandle SendListRequest(const FCarespacePreparedEndpoint& Endpoint, int32 Page, int32 Limit, const TCHAR* FilterName, const FString& FilterValue, const FOnHTTPResponseBytes& OnComplete, UObject* Owner, TSharedPtr<FCarespaceJsonStreamDecoder> Decoder);
 
-	UFUNCTION()
-	void HandleProgramsResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceProgramsReceived OnComplete);
+	// Response handlers
+	void HandleUsersResponse(bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error, FOnCarespaceUsersReceived OnComplete, TSharedRef<TCarespaceJsonListDecoder<FCarespaceUser>> Decoder);
+	void HandleSingleUserResponse(bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error, FOnCarespaceUsersReceived OnComplete);
+	void HandleClientsResponse(bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error, FOnCarespaceClientsReceived OnComplete, TSharedRef<TCarespaceJsonListDecoder<FCarespaceClient>> Decoder);
+	void HandleSingleClientResponse(bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error, FOnCarespaceClientsReceived OnComplete);
+	void HandleProgramsResponse(bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error, FOnCarespaceProgramsReceived OnComplete, TSharedRef<TCarespaceJsonListDecoder<FCarespaceProgram>> Decoder);
+	void HandleSingleProgramResponse(bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error, FOnCarespaceProgramsReceived OnComplete);
+
+	/**
+	 * Parses a response body on a worker thread and hands the typed items to Continuation on the game thread,
+	 * through FCarespaceCompletionDispatcher in the lane of the request being completed.
+	 * Continuation is dropped if this object is destroyed in the meantime, or if the caller is cancelled
+	 * by its handle or owner.
+	 */
+	template <typename ItemType>
+	void ParseOffGameThread(const TArray<uint8>& ResponseBody, TUniqueFunction<TArray<ItemType>(const TArray<uint8>&)> Parse, TUniqueFunction<void(TArray<ItemType>&&)> Continuation);
+
+	/**
+	 * Hands the items of a list response to Continuation like ParseOffGameThread, taking them from the decoder
+	 * that was fed while the body downloaded. Falls back to Parse for bodies the decoder never saw.
+	 */
+	template <typename ItemType>
+	void DecodeList(const TArray<uint8>& ResponseBody, TSharedRef<TCarespaceJsonListDecoder<ItemType>> Decoder, TUniqueFunction<TArray<ItemType>(const TArray<uint8>&)> Parse, TUniqueFunction<void(TArray<ItemType>&&)> Continuation);
 
-	UFUNCTION()
-	void HandleSingleProgramResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceProgramsReceived OnComplete);
+	/** Ends a completion deferred by ParseOffGameThread or DecodeList; see UCarespaceHTTPClient::EndDeferredCompletion */
+	bool EndDeferredCompletion(uint64 Token) const;
 
-	// Utility methods
-	TArray<FCarespaceUser> ParseUsersFromJson(const FString& JsonString);
-	TArray<FCarespaceClient> ParseClientsFromJson(const FString& JsonString);
-	TArray<FCarespaceProgram> ParseProgramsFromJson(const FString& JsonString);
-	FCarespaceUser ParseUserFromJson(const FString& JsonString);
-	FCarespaceClient ParseClientFromJson(const FString& JsonString);
-	FCarespaceProgram ParseProgramFromJson(const FString& JsonString);
+	// Utility methods; static and free of UObject access so that they can run on worker threads
+	static TArray<FCarespaceUser> ParseUsersFromJson(const TArray<uint8>& JsonBytes);
+	static TArray<FCarespaceClient> ParseClientsFromJson(const TArray<uint8>& JsonBytes);
+	static TArray<FCarespaceProgram> ParseProgramsFromJson(const TArray<uint8>& JsonBytes);
+	static FCarespaceUser ParseUserFromJson(const TArray<uint8>& JsonBytes);
+	static FCarespaceClient ParseClientFromJson(const TArray<uint8>& JsonBytes);
+	static FCarespaceProgram ParseProgramFromJson(const TArray<uint8>& JsonBytes);
 };
\ No newline at end of file
@@ -103,10 +103,10 @@ private:
 	UPROPERTY()
 	UCarespaceHTTPClient* HTTPClient;
 
-	// Response handlers
-	UFUNCTION()
-	void HandleLoginResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceLoginComplete OnComplete);
+	/** POSTs a UTF-8 JSON body in the auth lane and hands the response back undecoded. */
+	void SendAuthRequest(const TCHAR* Endpoint, TArray<uint8> JsonPayload, const FOnHTTPResponseBytes& OnComplete);
 
-	UFUNCTION()
-	void HandleGenericResponse(bool bWasSuccessful, const FString& ResponseContent, const FCarespaceError& Error, FOnCarespaceRequestComplete OnComplete);
+	// Response handlers
+	void HandleLoginResponse(bool bWasSuccessful, const TArray<uint8>& ResponseContent, const FCarespaceError& Error, FOnCarespaceLoginComplete OnComplete);
+	void HandleGenericResponse(bool bWasSuccessful, const TArray<uint8>& ResponseContent, const FCarespaceError& Error, FOnCarespaceRequestComplete OnComplete);
 };
\ No newline at end of file
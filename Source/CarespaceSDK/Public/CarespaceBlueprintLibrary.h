@@ -68,6 +68,20 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Error", meta = (DisplayName = "Is Network Error"))
 	static bool IsNetworkError(const FCarespaceError& Error);
 
+	/** True if the call failed fast because its host or endpoint is known to be down; show an offline state instead of retrying */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Error", meta = (DisplayName = "Is Circuit Open Error"))
+	static bool IsCircuitOpenError(const FCarespaceError& Error);
+
+	// Completion dispatch
+	/**
+	 * Sets how much game thread time SDK completion callbacks may use per frame. Callbacks beyond
+	 * the budget run on the next frame, most urgent requests first.
+	 *
+	 * @param Milliseconds Budget per frame (default: 2 ms)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Performance", meta = (DisplayName = "Set Completion Frame Budget"))
+	static void SetCompletionFrameBudget(float Milliseconds);
+
 	// Array utilities
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Array", meta = (DisplayName = "Get User Count"))
 	static int32 GetUserCount(const TArray<FCarespaceUser>& Users);
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CarespaceCircuitBreaker.generated.h"
+
+/**
+ * State of a circuit guarding a host or an endpoint family.
+ */
+UENUM(BlueprintType)
+enum class ECarespaceCircuitState : uint8
+{
+	/** Requests flow normally */
+	Closed UMETA(DisplayName = "Closed"),
+	/** Requests fail immediately with a CircuitOpenError */
+	Open UMETA(DisplayName = "Open"),
+	/** A limited number of probe requests test whether the backend recovered */
+	HalfOpen UMETA(DisplayName = "Half Open")
+};
+
+/**
+ * Controls when circuits open and how they recover.
+ */
+USTRUCT(BlueprintType)
+struct CARESPACESDK_API FCarespaceCircuitBreakerSettings
+{
+	GENERATED_BODY()
+
+	/** Whether requests to failing hosts and endpoints fail fast */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Circuit")
+	bool bEnabled = true;
+
+	/** Consecutive failures after which a circuit opens */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Circuit")
+	int32 FailureThreshold = 5;
+
+	/** Time an open circuit waits before letting a probe through, in seconds */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Circuit")
+	float OpenSeconds = 5.0f;
+
+	/** Upper bound of the open time, which doubles every time a probe fails */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Circuit")
+	float MaxOpenSeconds = 60.0f;
+
+	/** Number of probe requests allowed in flight while half-open */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Circuit")
+	int32 HalfOpenProbes = 1;
+
+	/** Successful probes needed to close the circuit again */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Circuit")
+	int32 SuccessesToClose = 1;
+};
+
+/**
+ * Snapshot of a single circuit, as exposed by UCarespaceHTTPClient::GetCircuitStates.
+ */
+USTRUCT(BlueprintType)
+struct CARESPACESDK_API FCarespaceCircuitStatus
+{
+	GENERATED_BODY()
+
+	/** Host ("api.carespace.ai") or host and endpoint family ("api.carespace.ai/users") the circuit guards */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Circuit")
+	FString Key;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Circuit")
+	ECarespaceCircuitState State = ECarespaceCircuitState::Closed;
+
+	/** Failures since the last success */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Circuit")
+	int32 ConsecutiveFailures = 0;
+
+	/** Seconds until an open circuit lets a probe through, 0 otherwise */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Circuit")
+	float SecondsUntilProbe = 0.0f;
+};
+
+/**
+ * Tracks consecutive failures per key and stops traffic to keys that keep failing.
+ * A closed circuit opens after FailureThreshold consecutive failures; once OpenSeconds have passed
+ * it turns half-open and admits a few probe requests. A successful probe closes the circuit, a
+ * failed one opens it again for twice as long.
+ *
+ * All times are in FPlatformTime::Seconds() units and passed in explicitly.
+ */
+class CARESPACESDK_API FCarespaceCircuitBreaker
+{
+public:
+	/** Called whenever a circuit changes state */
+	using FStateChangedCallback = TFunction<void(const FString& /*Key*/, ECarespaceCircuitState /*State*/)>;
+
+	void SetSettings(const FCarespaceCircuitBreakerSettings& InSettings) { Settings = InSettings; }
+	const FCarespaceCircuitBreakerSettings& GetSettings() const { return Settings; }
+
+	void SetStateChangedCallback(FStateChangedCallback InCallback) { StateChangedCallback = MoveTemp(InCallback); }
+
+	/**
+	 * Checks whether a request would be rejected right now, without claiming a probe.
+	 *
+	 * @return True if the circuit is open, or half-open with every probe slot taken
+	 */
+	bool IsRejecting(const FString& Key, double Now) const;
+
+	/**
+	 * Admits a request that is about to be sent.
+	 *
+	 * @param Key Circuit the request goes through
+	 * @param Now Current time
+	 * @param bOutIsProbe Set to true if the request was admitted as a half-open probe
+	 * @return False if the request must fail fast
+	 */
+	bool TryAdmit(const FString& Key, double Now, bool& bOutIsProbe);
+
+	/** Records a response that shows the backend behind Key is healthy. */
+	void RecordSuccess(const FString& Key, double Now, bool bWasProbe);
+
+	/** Records a failed request, opening the circuit once the threshold is reached. */
+	void RecordFailure(const FString& Key, double Now, bool bWasProbe);
+
+	/** Returns the probe slot of a request that was cancelled before it completed. */
+	void ReleaseProbe(const FString& Key);
+
+	/** @return State of the circuit, Closed if it has never seen a request */
+	ECarespaceCircuitState GetState(const FString& Key) const;
+
+	/** @return True if any circuit is currently not closed */
+	bool HasOpenCircuits() const;
+
+	/** @return State of every circuit that has seen a request */
+	TArray<FCarespaceCircuitStatus> GetStates(double Now) const;
+
+	/** Closes every circuit. */
+	void Reset();
+
+private:
+	struct FCircuit
+	{
+		ECarespaceCircuitState State = ECarespaceCircuitState::Closed;
+		int32 ConsecutiveFailures = 0;
+		int32 ProbeSuccesses = 0;
+		int32 ProbesInFlight = 0;
+		int32 TimesOpened = 0;
+		double OpenUntil = 0.0;
+	};
+
+	FCarespaceCircuitBreakerSettings Settings;
+	TMap<FString, FCircuit> Circuits;
+	FStateChangedCallback StateChangedCallback;
+
+	void Open(const FString& Key, FCircuit& Circuit, double Now);
+	void SetState(const FString& Key, FCircuit& Circuit, ECarespaceCircuitState State);
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "CarespaceHTTPClient.h"
+#include <atomic>
+
+/**
+ * Runs SDK completions on the game thread under a per-frame time budget.
+ * Completions can be queued from any thread into lock-free per-priority queues. Each tick the queues
+ * are drained most urgent lane first until the budget is used up; whatever is left runs on the next
+ * frame, so a burst of responses is spread over several frames instead of causing a hitch.
+ *
+ * The CarespaceSDK module owns the instance used by the SDK; see Dispatch.
+ */
+class CARESPACESDK_API FCarespaceCompletionDispatcher
+{
+public:
+	FCarespaceCompletionDispatcher();
+	~FCarespaceCompletionDispatcher();
+
+	/**
+	 * Queues a completion on the module's dispatcher. Falls back to a plain game thread task
+	 * while the module is not running.
+	 *
+	 * @param Priority Lane of the request the completion belongs to
+	 * @param Completion Work to run on the game thread
+	 */
+	static void Dispatch(ECarespaceRequestPriority Priority, TUniqueFunction<void()> Completion);
+
+	/** @return The module's dispatcher, or nullptr while the module is not running */
+	static FCarespaceCompletionDispatcher* Get();
+
+	/** Queues a completion. Safe to call from any thread. */
+	void Enqueue(ECarespaceRequestPriority Priority, TUniqueFunction<void()> Completion);
+
+	/**
+	 * Sets how much game thread time completions may use per frame.
+	 *
+	 * @param Milliseconds Budget per tick (default: 2 ms); at least one completion runs every tick
+	 */
+	void SetFrameBudgetMilliseconds(float Milliseconds);
+	float GetFrameBudgetMilliseconds() const { return FrameBudgetMilliseconds; }
+
+	/** @return Number of completions waiting to run */
+	int32 GetNumPending() const { return NumPending.load(std::memory_order_relaxed); }
+
+	/**
+	 * Runs queued completions, most urgent lane first, until BudgetSeconds have passed.
+	 * At least one completion runs so that the queue always makes progress.
+	 *
+	 * @param BudgetSeconds Time the completions may take
+	 * @return Number of completions run
+	 */
+	int32 Drain(double BudgetSeconds);
+
+	/** Starts draining the queues from the core ticker. */
+	void Start();
+
+	/** Stops draining; completions still queued run immediately. */
+	void Stop();
+
+private:
+	static constexpr int32 NumLanes = 3;
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> Lanes[NumLanes];
+	std::atomic<int32> NumPending;
+	float FrameBudgetMilliseconds;
+	FTSTicker::FDelegateHandle TickHandle;
+
+	static FCarespaceCompletionDispatcher* Instance;
+
+	bool Tick(float DeltaTime);
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CarespaceResponseCache.h"
+#include "Async/Future.h"
+#include "CarespaceDiskCache.generated.h"
+
+/**
+ * Configuration of the persistent response cache used for fast warm starts.
+ * The cache is opt-in and, by default, limited to catalog endpoints that carry no patient data.
+ */
+USTRUCT(BlueprintType)
+struct CARESPACESDK_API FCarespaceDiskCacheSettings
+{
+	GENERATED_BODY()
+
+	/** Whether GET responses for the configured endpoints are persisted to disk */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Cache")
+	bool bEnabled = false;
+
+	/** Maximum size of the cache directory in bytes; oldest entries are deleted first */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Cache")
+	int64 MaxBytes = 32 * 1024 * 1024;
+
+	/** Entries older than this are still used as validators but never served stale (seconds) */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Cache")
+	float MaxStaleSeconds = 7.0f * 24.0f * 60.0f * 60.0f;
+
+	/** Endpoint prefixes whose responses are persisted */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Cache")
+	TArray<FString> EndpointPrefixes = { TEXT("/programs"), TEXT("/exercises") };
+
+	/** Cache directory; defaults to Saved/Carespace/ResponseCache when empty */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Cache")
+	FString Directory;
+};
+
+/**
+ * Persistent, compressed store for GET responses.
+ * Each entry is one zlib-compressed file named after a hash of its request key, with a header
+ * recording CARESPACE_SDK_SCHEMA_VERSION so that entries written for older data types are ignored.
+ * Reads, writes, size enforcement and clearing run on the thread pool; the synchronous Load is meant for tools and tests.
+ */
+class CARESPACESDK_API FCarespaceDiskCache
+{
+public:
+	FCarespaceDiskCache();
+
+	void SetSettings(const FCarespaceDiskCacheSettings& InSettings);
+	const FCarespaceDiskCacheSettings& GetSettings() const { return Settings; }
+
+	/** @return True if responses of the given endpoint should be persisted */
+	bool IsCacheable(const FString& Endpoint) const;
+
+	/**
+	 * Reads an entry from disk.
+	 *
+	 * @param Key Canonical request key
+	 * @param OutAgeSeconds Time since the entry was written or last revalidated
+	 * @return The entry, or nullptr if it is missing, corrupt or from another schema version
+	 */
+	TSharedPtr<FCarespaceCachedResponse> Load(const FString& Key, double& OutAgeSeconds) const;
+
+	/**
+	 * Reads an entry on the thread pool, keeping file access and decompression off the game thread.
+	 *
+	 * @param Key Canonical request key
+	 * @param OnLoaded Called on the game thread with the entry, or nullptr as for Load, and its age in seconds
+	 */
+	void LoadAsync(const FString& Key, TFunction<void(TSharedPtr<FCarespaceCachedResponse>, double)> OnLoaded) const;
+
+	/**
+	 * Writes an entry asynchronously and trims the cache to its size budget afterwards.
+	 *
+	 * @return Future that is set once the entry was written and the budget enforced
+	 */
+	TFuture<void> StoreAsync(const FString& Key, TSharedRef<const FCarespaceCachedResponse> Entry) const;
+
+	/**
+	 * Marks an entry as fresh after the server confirmed it with 304 Not Modified.
+	 *
+	 * @return Future that is set once the entry's time stamp was updated
+	 */
+	TFuture<void> Touch(const FString& Key) const;
+
+	/**
+	 * Deletes every persisted entry.
+	 *
+	 * @return Future that is set once the cache directory was deleted
+	 */
+	TFuture<void> Clear() const;
+
+private:
+	FCarespaceDiskCacheSettings Settings;
+	FString CacheDirectory;
+
+	// Serializes writers, time stamp updates, clearing and the size enforcement pass
+	TSharedRef<FCriticalSection, ESPMode::ThreadSafe> WriteLock;
+
+	FString GetEntryPath(const FString& Key) const;
+	static TSharedPtr<FCarespaceCachedResponse> LoadEntry(const FString& Path, const FString& Key, double& OutAgeSeconds);
+	static void EnforceBudget(const FString& Directory, int64 MaxBytes);
+};
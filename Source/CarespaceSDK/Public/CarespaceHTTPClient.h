@@ -4,11 +4,434 @@
 #include "UObject/NoExportTypes.h"
 #include "Http.h"
 #include "Json.h"
+#include "Containers/Ticker.h"
+#include "Runtime/Launch/Resources/Version.h"
 #include "CarespaceTypes.h"
+#include "CarespaceRateLimiter.h"
+#include "CarespaceResponseCache.h"
+#include "CarespaceDiskCache.h"
+#include "CarespaceLatencyTracker.h"
+#include "CarespaceCircuitBreaker.h"
+#include "CarespaceHttpTransport.h"
 #include "CarespaceHTTPClient.generated.h"
 
+// Engines without the UTF8CHAR TJsonReader/TJsonWriter round-trip JSON bodies through FString instead
+#define CARESPACE_WITH_UTF8_JSON (ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3))
+
+class FCarespacePreparedEndpoint;
+class FCarespaceJsonStreamDecoder;
+class FCarespaceResponseStream;
+class UCarespaceHTTPClient;
+
 DECLARE_DYNAMIC_DELEGATE_ThreeParams(FOnHTTPResponse, bool, bWasSuccessful, const FString&, ResponseContent, const FCarespaceError&, Error);
 
+/** Broadcast when the circuit guarding a host ("api.carespace.ai") or endpoint family ("api.carespace.ai/users") changes state */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCarespaceCircuitStateChanged, const FString&, CircuitKey, ECarespaceCircuitState, State);
+
+/** Native response delegate receiving the decoded UTF-8 body without conversion to FString */
+DECLARE_DELEGATE_ThreeParams(FOnHTTPResponseBytes, bool /*bWasSuccessful*/, const TArray<uint8>& /*ResponseBody*/, const FCarespaceError& /*Error*/);
+
+/**
+ * Scheduling lane of a request. Queued requests are started strictly in lane order,
+ * so authentication is never stuck behind interactive calls, and interactive calls
+ * are never stuck behind background prefetching.
+ */
+UENUM(BlueprintType)
+enum class ECarespaceRequestPriority : uint8
+{
+	Auth UMETA(DisplayName = "Authentication"),
+	Interactive UMETA(DisplayName = "Interactive"),
+	Background UMETA(DisplayName = "Background")
+};
+
+/**
+ * Content coding applied to request bodies.
+ */
+UENUM(BlueprintType)
+enum class ECarespaceContentEncoding : uint8
+{
+	None UMETA(DisplayName = "None"),
+	Gzip UMETA(DisplayName = "gzip"),
+	Deflate UMETA(DisplayName = "deflate")
+};
+
+/**
+ * Controls hedging of GET requests: when a response is slower than most recent responses of the
+ * same endpoint family, an identical second request is sent and whichever answers first wins.
+ */
+USTRUCT(BlueprintType)
+struct CARESPACESDK_API FCarespaceHedgingPolicy
+{
+	GENERATED_BODY()
+
+	/** Whether slow GET requests are hedged */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Hedging")
+	bool bEnabled = false;
+
+	/** Observed latency percentile after which the hedge is sent, in [0, 1] */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Hedging")
+	float LatencyPercentile = 0.95f;
+
+	/** Lower bound of the hedge delay in seconds, so that fast endpoints are not hedged on noise */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Hedging")
+	float MinDelaySeconds = 0.05f;
+
+	/** Number of latency samples an endpoint family needs before it is hedged */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Hedging")
+	int32 MinSamples = 20;
+
+	/** Hedges earned per GET request; 0.1 caps the extra load at roughly 10% */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Hedging")
+	float BudgetRatio = 0.1f;
+
+	/** Maximum number of hedges that can be saved up for a burst of slow responses */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Hedging")
+	float MaxBudgetTokens = 5.0f;
+};
+
+/**
+ * Per-call options for UCarespaceHTTPClient::SendRequest.
+ */
+USTRUCT(BlueprintType)
+struct CARESPACESDK_API FCarespaceRequestOptions
+{
+	GENERATED_BODY()
+
+	/** Scheduling lane the request is queued in */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace")
+	ECarespaceRequestPriority Priority = ECarespaceRequestPriority::Interactive;
+
+	/**
+	 * Timeout of a single attempt in seconds. 0 uses the endpoint default set with
+	 * SetEndpointTimeout, or the client-wide timeout.
+	 */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace")
+	float TimeoutSeconds = 0.0f;
+
+	/**
+	 * Overall time budget in seconds, covering queueing, every attempt and the delays between retries.
+	 * When it runs out the caller receives a TimeoutError. 0 means no deadline.
+	 */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace")
+	float DeadlineSeconds = 0.0f;
+
+	/**
+	 * Object whose lifetime bounds the request. Once it is destroyed the request is cancelled and its
+	 * callback is never called. Defaults to the object the completion delegate is bound to.
+	 */
+	UPROPERTY()
+	TWeakObjectPtr<UObject> Owner;
+};
+
+/**
+ * Identifies one caller's subscription to a request, returned by every send method.
+ * Cancelling a handle guarantees that its callback is never called; the HTTP request itself is
+ * aborted once no other coalesced caller is waiting on it.
+ */
+USTRUCT(BlueprintType)
+struct CARESPACESDK_API FCarespaceRequestHandle
+{
+	GENERATED_BODY()
+
+	FCarespaceRequestHandle() = default;
+	FCarespaceRequestHandle(UCarespaceHTTPClient* InClient, uint64 InId)
+		: Client(InClient)
+		, Id(InId)
+	{
+	}
+
+	/** @return True if the handle refers to a request that was issued (it may have completed since) */
+	bool IsValid() const { return Id != 0; }
+
+	/** @return True if the request has neither completed nor been cancelled */
+	bool IsPending() const;
+
+	/**
+	 * Cancels the request for this caller.
+	 *
+	 * @return True if the request was still pending
+	 */
+	bool Cancel() const;
+
+	uint64 GetId() const { return Id; }
+
+private:
+	UPROPERTY()
+	TWeakObjectPtr<UCarespaceHTTPClient> Client;
+
+	UPROPERTY()
+	uint64 Id = 0;
+};
+
+/**
+ * Controls how failed requests of one HTTP verb are retried.
+ * Delays follow exponential backoff with decorrelated jitter; a Retry-After header
+ * from the server always takes precedence over the computed delay.
+ */
+USTRUCT(BlueprintType)
+struct CARESPACESDK_API FCarespaceRetryPolicy
+{
+	GENERATED_BODY()
+
+	/** Maximum number of retries after the first attempt (0 disables retrying) */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Retry")
+	int32 MaxRetries = 3;
+
+	/** Smallest delay before a retry, in seconds */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Retry")
+	float BaseDelaySeconds = 0.5f;
+
+	/** Largest delay before a retry, in seconds. Requests asked to wait longer by Retry-After fail instead */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Retry")
+	float MaxDelaySeconds = 20.0f;
+
+	/** Retry when the request failed to reach the server or the connection dropped */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Retry")
+	bool bRetryOnNetworkError = true;
+
+	/** Retry when the server answered 429 Too Many Requests */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Retry")
+	bool bRetryOnRateLimited = true;
+
+	/** Retry when the server answered with a 5xx status */
+	UPROPERTY(BlueprintReadWrite, Category = "Carespace|Retry")
+	bool bRetryOnServerError = true;
+
+	/**
+	 * Picks the delay before the next retry with decorrelated jitter: a random value between the base delay
+	 * and three times the previous delay, capped at MaxDelaySeconds.
+	 *
+	 * @param PreviousDelay Delay used before the previous retry, 0 before the first one
+	 * @return Delay in seconds
+	 */
+	double GetNextDelay(double PreviousDelay) const;
+};
+
+/**
+ * Aggregate counters describing the traffic handled by a UCarespaceHTTPClient.
+ * Useful for profiling and for verifying that optimizations such as request
+ * coalescing are effective in a given title.
+ */
+USTRUCT(BlueprintType)
+struct CARESPACESDK_API FCarespaceHTTPStats
+{
+	GENERATED_BODY()
+
+	/** Number of HTTP requests actually sent over the wire */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 RequestsSent = 0;
+
+	/** Number of calls that attached to an identical in-flight GET instead of sending their own request */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 RequestsCoalesced = 0;
+
+	/** Largest number of requests that were waiting for a free connection slot at the same time */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 PeakQueueDepth = 0;
+
+	/** Number of requests that were held back by the client-side rate limiter */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 RequestsRateLimited = 0;
+
+	/** Number of retries sent after a failed attempt */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 RetriesAttempted = 0;
+
+	/** Number of retryable failures reported to the caller because the retry budget was exhausted */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 RetriesDroppedByBudget = 0;
+
+	/** Number of GET responses served from memory after the server answered 304 Not Modified */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 ResponsesNotModified = 0;
+
+	/** Response body bytes the server did not have to resend thanks to revalidation */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int64 BytesSavedByRevalidation = 0;
+
+	/** Number of GET calls answered from the persistent cache while a background refresh ran */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 ResponsesServedFromDisk = 0;
+
+	/** Number of request bodies sent with a Content-Encoding */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 RequestsCompressed = 0;
+
+	/** Size of compressed request bodies before compression */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int64 RequestBytesBeforeCompression = 0;
+
+	/** Size of compressed request bodies as sent */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int64 RequestBytesAfterCompression = 0;
+
+	/** Compressed size divided by original size over all compressed bodies (1 = no gain) */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	float RequestCompressionRatio = 1.0f;
+
+	/** Number of callers that cancelled their request, explicitly or through a destroyed owner */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 RequestsCancelled = 0;
+
+	/** Number of HTTP requests aborted because every caller waiting on them cancelled */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 RequestsAborted = 0;
+
+	/**
+	 * Number of TimeoutErrors reported: requests whose last attempt ran out of time, counted once however many
+	 * callers shared them, and callers whose own deadline expired first
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 RequestsTimedOut = 0;
+
+	/** Number of callers that failed fast with a CircuitOpenError instead of reaching the network */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 RequestsRejectedByCircuit = 0;
+
+	/** Round trip of the last connection warm-up, including DNS, TCP and TLS setup; 0 until one completed */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	float WarmUpSeconds = 0.0f;
+
+	/** Number of hedge requests sent for slow GETs */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 HedgesSent = 0;
+
+	/** Number of hedge requests that answered before the original request */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 HedgesWon = 0;
+
+	/** Number of hedges not sent because the hedge budget was exhausted */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 HedgesDroppedByBudget = 0;
+
+	/** Number of response bodies received with a Content-Encoding and decoded by the client */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 ResponsesDecompressed = 0;
+
+	/** Bytes saved on the wire by compressed responses */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int64 ResponseBytesSavedByCompression = 0;
+
+	/** Number of list responses whose elements were decoded while the body was still arriving */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|Stats")
+	int32 ResponsesStreamed = 0;
+};
+
+/**
+ * A caller waiting on a request. Exactly one of the delegates is bound; the FString body
+ * is only materialized when at least one caller asked for it.
+ */
+struct FCarespaceResponseCallback
+{
+	FOnHTTPResponse OnComplete;
+	FOnHTTPResponseBytes OnCompleteBytes;
+
+	/** Id of the caller's FCarespaceRequestHandle */
+	uint64 Id = 0;
+};
+
+/**
+ * Internal bookkeeping for a single logical request issued by UCarespaceHTTPClient.
+ * A context may be shared by several callers when identical GETs are coalesced.
+ */
+struct FCarespaceRequestContext
+{
+	/** HTTP verb of the request (GET, POST, PUT, DELETE) */
+	FString Verb;
+
+	/** Endpoint path relative to the base URL */
+	FString Endpoint;
+
+	/** Fully built request URL including the canonical query string */
+	FString URL;
+
+	/** UTF-8 encoded request body, serialized once and reused by every attempt */
+	TArray<uint8> Payload;
+
+	/** Content-Encoding of Payload, empty when it is sent as plain JSON */
+	FString ContentEncoding;
+
+	/** Size of Payload before compression, used to restore it if the server rejects the encoding */
+	int32 UncompressedPayloadSize = 0;
+
+	/** Key under which this request is registered for coalescing, empty if it is not shared */
+	FString CoalescingKey;
+
+	/** Key of the response cache entry for this request, empty if the response is not cached */
+	FString CacheKey;
+
+	/** Set while an open circuit's rejection waits for the persisted copy that may still answer the callers */
+	bool bCircuitRejectionPending = false;
+
+	/** Whether the request carries the API key; connection probes go without */
+	bool bSendCredentials = true;
+
+	/** Receives the body of the current attempt as it arrives and feeds it to the caller's decoder, if one was given */
+	TSharedPtr<FCarespaceResponseStream> ResponseStream;
+
+	/** Cached response whose validators were sent with the current attempt */
+	TSharedPtr<const FCarespaceCachedResponse> RevalidatedResponse;
+
+	/** Host the request is sent to, used for per-host concurrency limits */
+	FString Host;
+
+	/** Scheduling lane of the request */
+	ECarespaceRequestPriority Priority = ECarespaceRequestPriority::Interactive;
+
+	/** Rate limit bucket the request draws from */
+	FString RateLimitClass;
+
+	/** Whether the request has already been counted as held back by the rate limiter */
+	bool bWasRateLimited = false;
+
+	/** Number of retries already sent for this request */
+	int32 RetryCount = 0;
+
+	/** Delay used before the previous retry, the seed for decorrelated jitter */
+	double LastRetryDelay = 0.0;
+
+	/** HTTP request of the current attempt while it is in flight */
+	FHttpRequestPtr HttpRequest;
+
+	/** Hedge of the current attempt while it is in flight */
+	FHttpRequestPtr HedgeRequest;
+
+	/** Time the hedge of the current attempt was sent */
+	double HedgeStartTime = 0.0;
+
+	/** Key the latency and circuit of this request's endpoint family are tracked under (host and family) */
+	FString LatencyKey;
+
+	/** Whether the current attempt was admitted as a probe of a half-open host or family circuit */
+	bool bHostCircuitProbe = false;
+	bool bFamilyCircuitProbe = false;
+
+	/** Timeout of each attempt in seconds */
+	float AttemptTimeoutSeconds = 0.0f;
+
+	/** Time the current attempt was started and its effective timeout */
+	double AttemptStartTime = 0.0;
+	float CurrentAttemptTimeout = 0.0f;
+
+	/** Number of the current attempt, so that the timer of an earlier attempt recognizes it is late */
+	int32 AttemptNumber = 0;
+
+	/** Timer that cancels the current attempt once its timeout runs out */
+	FTSTicker::FDelegateHandle AttemptTimerHandle;
+
+	/** Set when the timer cancelled the current attempt, so that its failure is reported as a timeout */
+	bool bAttemptTimedOut = false;
+
+	/** Latest deadline of the callers waiting on this request (FPlatformTime::Seconds), 0 if any caller has none */
+	double DeadlineTime = 0.0;
+
+	/** Set once every caller cancelled; the request is dropped wherever it currently is */
+	bool bCancelled = false;
+
+	/** Every caller waiting on this request; all of them receive the single result */
+	TArray<FCarespaceResponseCallback> Callbacks;
+};
+
 UCLASS(BlueprintType)
 class CARESPACESDK_API UCarespaceHTTPClient : public UObject
 {
@@ -24,36 +447,612 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Carespace")
 	void SetAPIKey(const FString& InAPIKey);
 
+	/**
+	 * Sets the default timeout of a single attempt, used when neither the call options nor an
+	 * endpoint default specify one.
+	 *
+	 * @param InTimeoutSeconds Timeout in seconds (default: 30)
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Carespace")
 	void SetTimeout(float InTimeoutSeconds);
 
+	/**
+	 * Sets the default attempt timeout for endpoints starting with a prefix, e.g. a short one for
+	 * "/auth/" and a patient one for bulk catalog endpoints. The longest matching prefix wins.
+	 *
+	 * @param EndpointPrefix Endpoint path prefix, e.g. "/programs"
+	 * @param InTimeoutSeconds Timeout in seconds, or 0 to remove the override
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace")
+	void SetEndpointTimeout(const FString& EndpointPrefix, float InTimeoutSeconds);
+
+	/**
+	 * Enables or disables coalescing of identical in-flight GET requests.
+	 * When enabled, a GET whose verb, canonical URL and credentials match a request
+	 * that is already in flight does not hit the network; the caller is attached to
+	 * the existing request and receives the same result. Enabled by default.
+	 *
+	 * @param bEnabled Whether identical GET requests should share a single HTTP request
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace")
+	void SetRequestCoalescingEnabled(bool bEnabled);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace")
+	bool IsRequestCoalescingEnabled() const { return bCoalesceRequests; }
+
+	/**
+	 * Replaces the transport requests are sent through, e.g. with one that answers from memory in tests.
+	 * Set it before sending requests; requests already in flight are cancelled through the new transport.
+	 *
+	 * @param InTransport Transport to use, or null to send through the HTTP module again
+	 */
+	void SetTransport(TSharedPtr<ICarespaceHttpTransport> InTransport);
+
+	// Statistics
+	/**
+	 * Returns traffic counters collected since creation or the last ResetStats call.
+	 *
+	 * @return Snapshot of the client statistics
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Stats")
+	FCarespaceHTTPStats GetStats() const { return Stats; }
+
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Stats")
+	void ResetStats();
+
 	// HTTP Methods
 	UFUNCTION(BlueprintCallable, Category = "Carespace")
-	void SendGETRequest(const FString& Endpoint, const TMap<FString, FString>& QueryParameters, const FOnHTTPResponse& OnComplete);
+	FCarespaceRequestHandle SendGETRequest(const FString& Endpoint, const TMap<FString, FString>& QueryParameters, const FOnHTTPResponse& OnComplete);
 
 	UFUNCTION(BlueprintCallable, Category = "Carespace")
-	void SendPOSTRequest(const FString& Endpoint, const FString& JsonPayload, const FOnHTTPResponse& OnComplete);
+	FCarespaceRequestHandle SendPOSTRequest(const FString& Endpoint, const FString& JsonPayload, const FOnHTTPResponse& OnComplete);
 
 	UFUNCTION(BlueprintCallable, Category = "Carespace")
-	void SendPUTRequest(const FString& Endpoint, const FString& JsonPayload, const FOnHTTPResponse& OnComplete);
+	FCarespaceRequestHandle SendPUTRequest(const FString& Endpoint, const FString& JsonPayload, const FOnHTTPResponse& OnComplete);
 
 	UFUNCTION(BlueprintCallable, Category = "Carespace")
-	void SendDELETERequest(const FString& Endpoint, const FOnHTTPResponse& OnComplete);
+	FCarespaceRequestHandle SendDELETERequest(const FString& Endpoint, const FOnHTTPResponse& OnComplete);
+
+	/**
+	 * Sends a request with explicit per-call options.
+	 * The Send*Request helpers are shorthands for this method; they schedule requests to
+	 * /auth endpoints in the Auth lane and everything else in the Interactive lane.
+	 *
+	 * @param Verb HTTP verb ("GET", "POST", "PUT" or "DELETE")
+	 * @param Endpoint Endpoint path relative to the base URL
+	 * @param QueryParameters Query parameters appended to the URL
+	 * @param JsonPayload Serialized JSON body, may be empty
+	 * @param Options Scheduling options for this call
+	 * @param OnComplete Delegate called with the response or error
+	 * @return Handle that cancels the request for this caller
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace")
+	FCarespaceRequestHandle SendRequest(const FString& Verb, const FString& Endpoint, const TMap<FString, FString>& QueryParameters, const FString& JsonPayload, const FCarespaceRequestOptions& Options, const FOnHTTPResponse& OnComplete);
+
+	/**
+	 * Native variant of SendRequest that hands the decoded UTF-8 response body to the caller as bytes.
+	 * Parsers that read UTF-8 directly avoid converting the whole body to an FString.
+	 *
+	 * @param Verb HTTP verb ("GET", "POST", "PUT" or "DELETE")
+	 * @param Endpoint Endpoint path relative to the base URL
+	 * @param QueryParameters Query parameters appended to the URL
+	 * @param JsonPayload Serialized JSON body, may be empty
+	 * @param Options Scheduling options for this call
+	 * @param OnComplete Delegate called with the response body or error
+	 */
+	FCarespaceRequestHandle SendRequestRaw(const FString& Verb, const FString& Endpoint, const TMap<FString, FString>& QueryParameters, const FString& JsonPayload, const FCarespaceRequestOptions& Options, const FOnHTTPResponseBytes& OnComplete);
+
+	/** Variant of SendRequestRaw whose body is already UTF-8 encoded and is sent as is. */
+	FCarespaceRequestHandle SendRequestRaw(const FString& Verb, const FString& Endpoint, const TMap<FString, FString>& QueryParameters, TArray<uint8> JsonPayload, const FCarespaceRequestOptions& Options, const FOnHTTPResponseBytes& OnComplete);
+
+	/**
+	 * Sends a request to a prepared endpoint, filling in only the per-call parts of the URL.
+	 *
+	 * @param Endpoint Prepared verb, path template and options
+	 * @param PathArguments One value per template placeholder, URL-encoded by the client
+	 * @param QueryParameters Query parameters appended to the URL
+	 * @param JsonPayload UTF-8 encoded JSON body, may be empty
+	 * @param OnComplete Delegate called with the response body or error
+	 * @param Owner Object whose destruction cancels the request, overriding the endpoint options
+	 * @param ResponseDecoder Decoder fed with the body on the HTTP thread while it downloads. It is reset before every
+	 *                        attempt and complete once OnComplete runs, unless the caller was answered from a cache or
+	 *                        joined an identical request already in flight, or the engine is older than 5.3
+	 *                        and cannot stream response bodies; check IsComplete() and decode the body otherwise.
+	 */
+	FCarespaceRequestHandle SendPrepared(const FCarespacePreparedEndpoint& Endpoint, TArrayView<const FStringView> PathArguments, const TMap<FString, FString>& QueryParameters, TArray<uint8> JsonPayload, const FOnHTTPResponseBytes& OnComplete, UObject* Owner = nullptr, TSharedPtr<FCarespaceJsonStreamDecoder> ResponseDecoder = nullptr);
+
+	/**
+	 * Variant of SendPrepared whose body is serialized on a worker thread, keeping large structs off the game thread.
+	 * The request is queued once the payload is ready; the returned handle can be cancelled in the meantime.
+	 *
+	 * @param Endpoint Prepared verb, path template and options
+	 * @param PathArguments One value per template placeholder, URL-encoded by the client
+	 * @param QueryParameters Query parameters appended to the URL
+	 * @param SerializePayload Produces the UTF-8 JSON body; runs on a worker thread and must only touch data it owns
+	 * @param OnComplete Delegate called with the response body or error
+	 * @param Owner Object whose destruction cancels the request, overriding the endpoint options
+	 */
+	FCarespaceRequestHandle SendPreparedDeferred(const FCarespacePreparedEndpoint& Endpoint, TArrayView<const FStringView> PathArguments, const TMap<FString, FString>& QueryParameters, TUniqueFunction<TArray<uint8>()> SerializePayload, const FOnHTTPResponseBytes& OnComplete, UObject* Owner = nullptr);
+
+	// Cancellation
+	/**
+	 * Cancels a request for the caller that issued it. Its callback will not be called.
+	 *
+	 * @param Handle Handle returned by the send method
+	 * @return True if the request was still pending
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Requests")
+	bool CancelRequest(const FCarespaceRequestHandle& Handle);
+
+	/** @return True if the request has neither completed nor been cancelled */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Requests")
+	bool IsRequestPending(const FCarespaceRequestHandle& Handle) const;
+
+	/**
+	 * Cancels every pending request owned by an object, e.g. when a widget is closed.
+	 * Requests of destroyed owners are also cancelled automatically.
+	 *
+	 * @param Owner Owner passed in the request options, or the object the callback was bound to
+	 * @return Number of requests cancelled
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Requests")
+	int32 CancelAllRequestsForOwner(const UObject* Owner);
+
+	/**
+	 * Returns the lane of the request whose callbacks are currently running, so that a callback
+	 * deferring its work (e.g. to FCarespaceCompletionDispatcher) can keep the request's priority.
+	 *
+	 * @return Lane of the request being completed, Interactive outside of a callback
+	 */
+	ECarespaceRequestPriority GetDispatchPriority() const { return DispatchPriority; }
+
+	/**
+	 * Keeps the caller whose callback is currently running pending until EndDeferredCompletion, for a callback
+	 * that finishes its work later (e.g. parsing on a worker thread). Until then, the caller's handle and
+	 * CancelAllRequestsForOwner can still cancel it.
+	 *
+	 * @return Token to pass to EndDeferredCompletion, 0 outside of a callback
+	 */
+	uint64 BeginDeferredCompletion();
+
+	/**
+	 * Ends a completion deferred with BeginDeferredCompletion.
+	 *
+	 * @param Token Value returned by BeginDeferredCompletion
+	 * @return True if the caller should still be called back: it was not cancelled and its owner is alive
+	 */
+	bool EndDeferredCompletion(uint64 Token);
+
+	// Scheduling
+	/**
+	 * Limits how many requests may be in flight at once across all hosts.
+	 * Additional requests wait in their priority lane until a slot frees up.
+	 *
+	 * @param InMaxConcurrentRequests Maximum number of concurrent requests (0 = unlimited, default: 6)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Scheduling")
+	void SetMaxConcurrentRequests(int32 InMaxConcurrentRequests);
+
+	/**
+	 * Limits how many requests may be in flight at once to a single host.
+	 *
+	 * @param InMaxConcurrentRequestsPerHost Maximum number of concurrent requests per host (0 = unlimited, default: 4)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Scheduling")
+	void SetMaxConcurrentRequestsPerHost(int32 InMaxConcurrentRequestsPerHost);
+
+	/**
+	 * Returns the number of requests waiting to be started in the given lane.
+	 * Callers issuing bulk work can use this to apply backpressure.
+	 *
+	 * @param Priority Lane to inspect
+	 * @return Number of queued requests in that lane
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Scheduling")
+	int32 GetQueueDepth(ECarespaceRequestPriority Priority) const;
+
+	/** @return Number of queued requests across all lanes */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Scheduling")
+	int32 GetTotalQueueDepth() const;
+
+	/** @return Number of requests currently in flight */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Scheduling")
+	int32 GetActiveRequestCount() const { return ActiveRequestCount; }
+
+	// Rate limiting
+	/**
+	 * Enables or disables client-side pacing of requests.
+	 * When enabled, requests wait in the queue while the token bucket of their endpoint class
+	 * is empty. Buckets learn their budget from the X-RateLimit-* response headers. Enabled by default.
+	 *
+	 * @param bEnabled Whether outgoing requests should be paced
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|RateLimit")
+	void SetRateLimitingEnabled(bool bEnabled);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|RateLimit")
+	bool IsRateLimitingEnabled() const { return bRateLimitingEnabled; }
+
+	/**
+	 * Returns the current state of every rate limit bucket.
+	 *
+	 * @return One entry per endpoint class ("auth", "standard", "bulk")
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|RateLimit")
+	TArray<FCarespaceRateLimitState> GetRateLimitStates();
+
+	// Request compression
+	/**
+	 * Enables compression of large POST and PUT bodies.
+	 * Bodies of at least MinBytes are sent with the given Content-Encoding when that makes them smaller.
+	 * If a host answers 415 Unsupported Media Type, the request is resent uncompressed and bodies to
+	 * that host are no longer compressed. Disabled by default.
+	 *
+	 * @param Encoding Content coding to use, or None to disable compression
+	 * @param MinBytes Smallest body size worth compressing (default: 1024)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Compression")
+	void SetRequestCompression(ECarespaceContentEncoding Encoding, int32 MinBytes = 1024);
+
+	// Hedging
+	/**
+	 * Configures hedging of slow GET requests. Disabled by default.
+	 *
+	 * @param Policy Hedging policy to apply to every GET
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Hedging")
+	void SetHedgingPolicy(const FCarespaceHedgingPolicy& Policy);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Hedging")
+	FCarespaceHedgingPolicy GetHedgingPolicy() const { return HedgingPolicy; }
+
+	// Connection
+	/**
+	 * Opens a connection to the base URL ahead of the first real request by sending it a HEAD, so that
+	 * DNS resolution and the TCP and TLS handshakes are not paid by the first call. The HTTP module keeps
+	 * the connection in its pool for later requests. GetStats().WarmUpSeconds reports how long it took.
+	 * The HEAD carries no credentials and is scheduled in the Background lane, subject to the rate limiter
+	 * and the circuit breaker like any other request.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Connection")
+	void WarmUpConnection();
+
+	/**
+	 * Keeps the pooled connection from being closed by idle timeouts of proxies and load balancers
+	 * by sending a HEAD to the base URL whenever no request was sent for the given interval.
+	 *
+	 * @param IntervalSeconds Idle time after which a keep-alive is sent (0 = disabled, default)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Connection")
+	void SetKeepAliveInterval(float IntervalSeconds);
+
+	// Circuit breaker
+	/**
+	 * Configures the circuit breakers that make calls fail fast while a host or endpoint family is down.
+	 * Network failures and timeouts count against both the host and the endpoint family, 5xx responses
+	 * only against the family. While a circuit is open, calls through it fail immediately with a
+	 * CircuitOpenError; after a cool-down a probe request tests whether the backend recovered. Enabled by default.
+	 *
+	 * @param Settings Thresholds and cool-down times
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Circuit")
+	void SetCircuitBreakerSettings(const FCarespaceCircuitBreakerSettings& Settings);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Circuit")
+	FCarespaceCircuitBreakerSettings GetCircuitBreakerSettings() const { return CircuitBreaker.GetSettings(); }
+
+	/**
+	 * Returns the state that applies to calls to an endpoint: Open if either its host or its
+	 * endpoint family circuit is open, HalfOpen if either is probing, Closed otherwise.
+	 *
+	 * @param Endpoint Endpoint path relative to the base URL
+	 * @return State callers should plan for, e.g. to show an offline indicator
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Circuit")
+	ECarespaceCircuitState GetCircuitState(const FString& Endpoint) const;
+
+	/** @return State of every host and endpoint family circuit that has seen a request */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Circuit")
+	TArray<FCarespaceCircuitStatus> GetCircuitStates() const;
+
+	/** Closes every circuit, e.g. after the platform reports that connectivity is back. */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Circuit")
+	void ResetCircuits();
+
+	/** Broadcast whenever a circuit opens, starts probing or closes */
+	UPROPERTY(BlueprintAssignable, Category = "Carespace|Circuit")
+	FOnCarespaceCircuitStateChanged OnCircuitStateChanged;
+
+	// Response cache
+	/**
+	 * Enables or disables conditional revalidation of GET responses.
+	 * When enabled, GET responses carrying an ETag or Last-Modified header are kept in memory and
+	 * later requests for the same URL send If-None-Match / If-Modified-Since. A 304 Not Modified
+	 * answer is then served from memory. Enabled by default.
+	 *
+	 * @param bEnabled Whether GET responses should be cached and revalidated
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Cache")
+	void SetResponseCacheEnabled(bool bEnabled);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Cache")
+	bool IsResponseCacheEnabled() const { return bResponseCacheEnabled; }
+
+	/**
+	 * Sets the memory budget of the response cache. Least recently used entries are evicted first.
+	 *
+	 * @param MaxBytes Maximum number of bytes kept in the cache (default: 8 MB)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Cache")
+	void SetResponseCacheBudget(int64 MaxBytes);
+
+	/** @return Number of bytes currently held by the response cache */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Cache")
+	int64 GetResponseCacheSize() const { return ResponseCache.GetTotalBytes(); }
+
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Cache")
+	void ClearResponseCache();
+
+	/**
+	 * Configures the persistent response cache used for instant warm starts.
+	 * When enabled, GET responses of the configured endpoints are also written to disk. On the next
+	 * launch the first request for such an endpoint is answered immediately from disk
+	 * (stale-while-revalidate) while a background request revalidates the entry.
+	 *
+	 * @param Settings Persistent cache configuration (disabled by default)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Cache")
+	void SetDiskCacheSettings(const FCarespaceDiskCacheSettings& Settings);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Cache")
+	FCarespaceDiskCacheSettings GetDiskCacheSettings() const { return DiskCache.GetSettings(); }
+
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Cache")
+	void ClearDiskCache();
+
+	/**
+	 * Sets the account cached responses belong to. Cache entries are keyed by this identity rather than by
+	 * the credential, so a refreshed token keeps hitting the persisted responses of the same account.
+	 *
+	 * @param Identity Stable account id, or empty to use the subject of a JWT API key (the key itself otherwise)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Cache")
+	void SetCacheIdentity(const FString& Identity);
+
+	// Retries
+	/**
+	 * Sets the retry policy used for requests with the given HTTP verb.
+	 * By default GET, PUT and DELETE retry network errors, 429 and 5xx responses,
+	 * while POST only retries 429 since the server may already have acted on it.
+	 *
+	 * @param Verb HTTP verb the policy applies to
+	 * @param Policy Retry behavior for that verb
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Retry")
+	void SetRetryPolicy(const FString& Verb, const FCarespaceRetryPolicy& Policy);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace|Retry")
+	FCarespaceRetryPolicy GetRetryPolicy(const FString& Verb) const;
+
+	/**
+	 * Sets the maximum number of retries for every verb.
+	 *
+	 * @param MaxRetries Retries after the first attempt (0 disables retrying)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Retry")
+	void SetMaxRetries(int32 MaxRetries);
+
+	/**
+	 * Sets the base backoff delay for every verb.
+	 *
+	 * @param BaseDelaySeconds Smallest delay before a retry, in seconds
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Retry")
+	void SetRetryDelay(float BaseDelaySeconds);
+
+	/**
+	 * Configures the global retry budget that keeps retries from amplifying an outage.
+	 * Every request that succeeds on its first attempt earns RetryRatio tokens, each retry
+	 * spends one, and the balance is capped at MaxTokens. Failures never earn tokens, so an
+	 * outage drains the budget instead of refilling it.
+	 *
+	 * @param RetryRatio Retries allowed per successful first attempt (default: 0.2)
+	 * @param MaxTokens Largest burst of retries allowed (default: 10)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Carespace|Retry")
+	void SetRetryBudget(float RetryRatio, float MaxTokens);
+
+	// UObject interface
+	virtual void BeginDestroy() override;
 
 	// Utility functions
+
+	/**
+	 * Serializes a struct to condensed JSON with the same keys as FJsonObjectConverter.
+	 * The struct's property plan is built once per type and cached (see FCarespaceStructPlan).
+	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace")
 	static FString StructToJsonString(const UStruct* StructDefinition, const void* Struct);
 
+	/** Parses a JSON object into a struct through its cached property plan. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Carespace")
 	static bool JsonStringToStruct(const FString& JsonString, const UStruct* StructDefinition, void* OutStruct);
 
+	/**
+	 * Serializes a struct straight to a UTF-8 request body, without an intermediate FString.
+	 *
+	 * @param StructDefinition Struct type to write
+	 * @param Struct Struct instance to write
+	 * @return Condensed UTF-8 JSON, with the same keys as StructToJsonString
+	 */
+	static TArray<uint8> StructToJsonBytes(const UStruct* StructDefinition, const void* Struct);
+
+	/**
+	 * Parses a UTF-8 JSON body straight into a struct, without an intermediate FString.
+	 *
+	 * @param JsonBytes UTF-8 encoded JSON
+	 * @param StructDefinition Struct type to fill
+	 * @param OutStruct Struct instance to fill
+	 * @return True if the body was a JSON object and matched the struct
+	 */
+	static bool JsonBytesToStruct(TArrayView<const uint8> JsonBytes, const UStruct* StructDefinition, void* OutStruct);
+
+	/** Parses a UTF-8 JSON body into a JSON object, or returns nullptr if it is not one. */
+	static TSharedPtr<FJsonObject> JsonBytesToObject(TArrayView<const uint8> JsonBytes);
+
 private:
 	FString BaseURL;
 	FString APIKey;
+
+	// Headers shared by every request, rebuilt only when the API key changes
+	TArray<TPair<FString, FString>> CommonHeaders;
+
+	// SHA-1 of the API key, separating the requests of different credentials in coalescing keys
+	FString APIKeyHash;
+
+	// Account the cached responses belong to (see SetCacheIdentity), and the SHA-1 cache keys carry
+	FString CacheIdentity;
+	FString CacheIdentityHash;
+
+	TSharedPtr<ICarespaceHttpTransport> Transport;
 	float TimeoutSeconds;
+	TMap<FString, float> EndpointTimeouts;
+	bool bCoalesceRequests;
+	int32 MaxConcurrentRequests;
+	int32 MaxConcurrentRequestsPerHost;
+	bool bRateLimitingEnabled;
 
-	void ConfigureRequest(TSharedRef<IHttpRequest> Request, const FString& Verb, const FString& URL);
-	void HandleResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FOnHTTPResponse OnComplete);
-	FCarespaceError ProcessError(FHttpResponsePtr Response, bool bWasSuccessful);
+	FCarespaceRateLimiter RateLimiter;
+
+	FCarespaceHedgingPolicy HedgingPolicy;
+	FCarespaceLatencyTracker LatencyTracker;
+	float HedgeBudgetTokens;
+
+	FCarespaceCircuitBreaker CircuitBreaker;
+
+	// Idle keep-alive of the pooled connection
+	float KeepAliveIntervalSeconds;
+	double LastRequestTime;
+	FTSTicker::FDelegateHandle KeepAliveHandle;
+
+	ECarespaceContentEncoding RequestCompression;
+	int32 MinCompressedRequestBytes;
+	TSet<FString> HostsRejectingCompression;
+
+	bool bResponseCacheEnabled;
+	FCarespaceResponseCache ResponseCache;
+	FCarespaceDiskCache DiskCache;
+
+	TMap<FString, FCarespaceRetryPolicy> RetryPolicies;
+	float RetryBudgetRatio;
+	float RetryBudgetMaxTokens;
+	float RetryBudgetTokens;
+
+	FCarespaceHTTPStats Stats;
+
+	// GET requests currently in flight, keyed by their coalescing key
+	TMap<FString, TSharedPtr<FCarespaceRequestContext>> InFlightGETRequests;
+
+	// Requests waiting for a connection slot, one FIFO per ECarespaceRequestPriority lane
+	static constexpr int32 NumPriorityLanes = 3;
+	TArray<TSharedRef<FCarespaceRequestContext>> PendingRequests[NumPriorityLanes];
+
+	int32 ActiveRequestCount;
+	TMap<FString, int32> ActiveRequestsPerHost;
+
+	// Pending wake-up used to resume the queue once a rate limit bucket refills
+	FTSTicker::FDelegateHandle QueueWakeUpHandle;
+	double QueueWakeUpTime;
+
+	// Set by FCarespaceScopedRequestPriority to override the lane of requests issued in its scope
+	TOptional<ECarespaceRequestPriority> PriorityOverride;
+
+	// Lane of the request whose callbacks DispatchResponse is running
+	ECarespaceRequestPriority DispatchPriority;
+
+	// Caller whose callback DispatchResponse is running, 0 outside of a callback
+	uint64 DispatchingId;
+	TWeakObjectPtr<const UObject> DispatchingOwner;
+
+	friend struct FCarespaceScopedRequestPriority;
+
+	// A caller waiting on a request, keyed by its handle id. Context is null while the payload of a
+	// deferred request is still being serialized, or while a deferred completion is under way.
+	struct FSubscription
+	{
+		TSharedPtr<FCarespaceRequestContext> Context;
+		TWeakObjectPtr<const UObject> Owner;
+	};
+
+	TMap<uint64, FSubscription> Subscriptions;
+	uint64 NextRequestId;
+
+	// Periodic check for subscriptions whose owner was destroyed
+	FTSTicker::FDelegateHandle OwnerSweepHandle;
+
+	FCarespaceRequestHandle SubmitRequest(const FString& Verb, const FString& Endpoint, const FString& URL, TArray<uint8> Payload, const FCarespaceRequestOptions& Options, FCarespaceResponseCallback OnComplete, TSharedPtr<FCarespaceJsonStreamDecoder> ResponseDecoder = nullptr, bool bSendCredentials = true);
+	bool CancelSubscription(uint64 Id);
+	void AbortRequest(TSharedRef<FCarespaceRequestContext> Context);
+	bool SweepDestroyedOwners(float DeltaTime);
+	void ExpireSubscription(uint64 Id, float DeadlineSeconds);
+	float GetAttemptTimeout(const FString& Endpoint, const FCarespaceRequestOptions& Options) const;
+	void EnqueueRequest(TSharedRef<FCarespaceRequestContext> Context);
+	void PumpRequestQueue();
+	bool CanStartRequest(FCarespaceRequestContext& Context, double Now, double& OutWaitSeconds);
+	void ScheduleQueueWakeUp(double DelaySeconds);
+	void UpdateRateLimits(const FCarespaceRequestContext& Context, const ICarespaceHttpResponse& Response);
+	void CompressPayload(FCarespaceRequestContext& Context);
+	bool TryResendUncompressed(TSharedRef<FCarespaceRequestContext> Context, int32 ResponseCode);
+	void LoadFromDiskCache(TSharedRef<FCarespaceRequestContext> Context);
+	void ServeFromDiskCache(TSharedRef<FCarespaceRequestContext> Context, TSharedPtr<FCarespaceCachedResponse> Entry, double AgeSeconds);
+	void StoreInResponseCache(const FCarespaceRequestContext& Context, const ICarespaceHttpResponse& Response, const TArray<uint8>& Body);
+	static FString BytesToString(const TArray<uint8>& Bytes);
+	static TArray<uint8> StringToBytes(const FString& String);
+	bool DecodeResponseBody(const ICarespaceHttpResponse& Response, const TArray<uint8>& Content, TArray<uint8>& OutBody, bool& bOutDecoded);
+	void DispatchResponse(const TArray<FCarespaceResponseCallback>& Callbacks, ECarespaceRequestPriority Priority, bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error);
+	bool TryScheduleRetry(TSharedRef<FCarespaceRequestContext> Context, const ICarespaceHttpResponse* Response);
+	static double ParseRetryAfter(const ICarespaceHttpResponse* Response);
+	void StartRequest(TSharedRef<FCarespaceRequestContext> Context);
+	TSharedRef<IHttpRequest> CreateHttpRequest(TSharedRef<FCarespaceRequestContext> Context, float Timeout);
+	void ScheduleHedge(TSharedRef<FCarespaceRequestContext> Context);
+	void SendHedge(TSharedRef<FCarespaceRequestContext> Context);
+	void TimeOutAttempt(TSharedRef<FCarespaceRequestContext> Context, int32 AttemptNumber);
+	void ReleaseRequestSlot(const FCarespaceRequestContext& Context);
+	bool IsCircuitRejecting(const FCarespaceRequestContext& Context, double Now) const;
+	bool AdmitThroughCircuits(FCarespaceRequestContext& Context, double Now);
+	void RecordCircuitOutcome(FCarespaceRequestContext& Context, int32 ResponseCode);
+	void ReleaseCircuitProbes(FCarespaceRequestContext& Context);
+	void RejectOpenCircuit(TSharedRef<FCarespaceRequestContext> Context);
+	FCarespaceRequestOptions MakeDefaultOptions(const FString& Endpoint) const;
+	FCarespaceRequestHandle RejectPathArguments(const FCarespacePreparedEndpoint& Endpoint, const FCarespaceRequestOptions& Options, const FOnHTTPResponseBytes& OnComplete);
+	bool BuildPreparedURL(const FCarespacePreparedEndpoint& Endpoint, TArrayView<const FStringView> PathArguments, const TMap<FString, FString>& QueryParameters, FString& OutPath, FString& OutURL) const;
+	FString MakeRequestKey(const FString& Verb, const FString& URL) const;
+	FString MakeCacheKey(const FString& URL) const;
+	static FString GetCredentialSubject(const FString& Credential);
+
+	void ConfigureRequest(TSharedRef<IHttpRequest> Request, const FString& Verb, const FString& URL, float Timeout, bool bSendCredentials);
+	void SendConnectionProbe(bool bIsWarmUp);
+	bool TickKeepAlive(float DeltaTime);
+	void HandleResponse(FHttpRequestPtr Request, TSharedPtr<const ICarespaceHttpResponse> Response, TSharedRef<FCarespaceRequestContext> Context);
+	FCarespaceError ProcessError(const ICarespaceHttpResponse* Response, const TArray<uint8>& Body);
+	void RebuildCommonHeaders();
 	FString BuildURL(const FString& Endpoint, const TMap<FString, FString>& QueryParameters = TMap<FString, FString>());
-};
\ No newline at end of file
+	static void AppendQueryString(FStringBuilderBase& Out, const TMap<FString, FString>& QueryParameters);
+};
+
+/**
+ * Overrides the scheduling lane of every request issued through a client while in scope.
+ * Lets high-level calls such as UCarespaceAPI::GetPrograms be used for background prefetching:
+ *
+ *   FCarespaceScopedRequestPriority BackgroundScope(API->GetHTTPClient(), ECarespaceRequestPriority::Background);
+ *   API->GetPrograms(Page, 100, TEXT(""), OnPageReceived);
+ */
+struct CARESPACESDK_API FCarespaceScopedRequestPriority
+{
+	FCarespaceScopedRequestPriority(UCarespaceHTTPClient* InClient, ECarespaceRequestPriority Priority);
+	~FCarespaceScopedRequestPriority();
+
+private:
+	TWeakObjectPtr<UCarespaceHTTPClient> Client;
+	TOptional<ECarespaceRequestPriority> PreviousOverride;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+
+/**
+ * The parts of a received HTTP response that UCarespaceHTTPClient reads.
+ * Keeps the client independent of IHttpResponse, whose interface changes between engine versions,
+ * so that transports other than the HTTP module can answer requests.
+ */
+class CARESPACESDK_API ICarespaceHttpResponse
+{
+public:
+	virtual ~ICarespaceHttpResponse() = default;
+
+	virtual int32 GetResponseCode() const = 0;
+
+	/** @return Value of a response header, empty if the header is missing */
+	virtual FString GetHeader(const FString& HeaderName) const = 0;
+
+	/** @return Body as received, empty if it was written to the request's response body stream instead */
+	virtual const TArray<uint8>& GetContent() const = 0;
+
+	virtual FString GetURL() const = 0;
+};
+
+/** Called on the game thread when a request finished; the response is null if no answer was received */
+DECLARE_DELEGATE_TwoParams(FOnCarespaceTransportComplete, FHttpRequestPtr /*Request*/, TSharedPtr<const ICarespaceHttpResponse> /*Response*/);
+
+/**
+ * Carries the requests of a UCarespaceHTTPClient. The client configures each IHttpRequest (URL, verb, headers,
+ * body) and hands it to its transport; the default transport sends it through the HTTP module, while tests
+ * install one that records requests and answers them from memory.
+ */
+class CARESPACESDK_API ICarespaceHttpTransport
+{
+public:
+	virtual ~ICarespaceHttpTransport() = default;
+
+	/**
+	 * Sends a configured request. OnComplete is called exactly once, on the game thread, with a null
+	 * response if the request failed to connect, timed out in the HTTP module or was cancelled.
+	 */
+	virtual void ProcessRequest(const TSharedRef<IHttpRequest>& Request, const FOnCarespaceTransportComplete& OnComplete) = 0;
+
+	/** Cancels a request sent with ProcessRequest. Its OnComplete still runs, immediately or later. */
+	virtual void CancelRequest(const TSharedRef<IHttpRequest>& Request) = 0;
+
+	/** @return Transport that sends requests through FHttpModule */
+	static TSharedRef<ICarespaceHttpTransport> CreateDefault();
+};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FCarespaceJsonIndex;
+
+/**
+ * Type of the next value in a JSON document.
+ */
+enum class ECarespaceJsonValueType : uint8
+{
+	None,
+	Object,
+	Array,
+	String,
+	Number,
+	Bool,
+	Null
+};
+
+/**
+ * Minimal forward-only reader over a UTF-8 JSON document. Values are read straight into their
+ * destination without building FJsonValue objects; the typed decoders of CarespaceJsonSchema.h
+ * drive it field by field.
+ *
+ * Every Read* method returns false and sets the error flag on malformed input, except where noted.
+ *
+ * Given a structural index of the document, strings and nested values are skipped by jumping between
+ * indexed offsets instead of scanning every byte.
+ */
+class CARESPACESDK_API FCarespaceJsonReader
+{
+public:
+	explicit FCarespaceJsonReader(TArrayView<const uint8> InJson);
+
+	/**
+	 * Creates a reader that uses a structural index.
+	 *
+	 * @param InJson Range of the indexed document to read, e.g. one element of a list
+	 * @param InIndex Index of the whole document; must outlive the reader
+	 */
+	FCarespaceJsonReader(TArrayView<const uint8> InJson, const FCarespaceJsonIndex& InIndex);
+
+	/** @return Type of the next value, None at the end of the input or before a character that cannot start one */
+	ECarespaceJsonValueType PeekType();
+
+	/** Consumes the opening brace of an object. */
+	bool ReadObjectStart();
+
+	/**
+	 * Advances to the next key of the current object and consumes the colon after it.
+	 *
+	 * @param OutKey Raw UTF-8 bytes of the key between its quotes, escape sequences included
+	 * @return False once the closing brace has been consumed, or on a syntax error (see HasError)
+	 */
+	bool ReadNextKey(TArrayView<const uint8>& OutKey);
+
+	/** Consumes the opening bracket of an array. */
+	bool ReadArrayStart();
+
+	/**
+	 * Advances to the next element of the current array.
+	 *
+	 * @return False once the closing bracket has been consumed, or on a syntax error (see HasError)
+	 */
+	bool ReadNextElement();
+
+	bool ReadString(FString& OutValue);
+
+	/**
+	 * Reads a string without unescaping it.
+	 *
+	 * @param OutRaw Raw UTF-8 bytes between the quotes
+	 * @param bOutHasEscapes Set if OutRaw contains escape sequences and must be unescaped before use
+	 */
+	bool ReadRawString(TArrayView<const uint8>& OutRaw, bool& bOutHasEscapes);
+
+	/** Reads a number token without interpreting it, failing unless it follows the JSON number grammar. */
+	bool ReadNumberToken(TArrayView<const uint8>& OutToken);
+
+	/** @return Value of a token returned by ReadNumberToken, whatever its length */
+	static double ParseNumberToken(TArrayView<const uint8> Token);
+
+	bool ReadNumber(double& OutValue);
+
+	/** Reads a number, truncating fractions like FJsonValue::AsNumber followed by an integer cast. */
+	bool ReadInteger(int64& OutValue);
+
+	bool ReadBool(bool& OutValue);
+
+	/** @return True if the next value was null and has been consumed; never an error */
+	bool ReadNull();
+
+	/** Skips the next value, including everything nested in it. */
+	bool SkipValue();
+
+	/**
+	 * Skips the next value and returns its text.
+	 *
+	 * @param OutValue JSON text of the value, pointing into the document
+	 */
+	bool ReadRawValue(TArrayView<const uint8>& OutValue);
+
+	bool HasError() const { return bError; }
+
+	/** @return True if only whitespace is left */
+	bool IsAtEnd();
+
+	/** Appends the UTF-8 text of a raw string read with ReadRawString, resolving its escape sequences. */
+	static void Unescape(TArrayView<const uint8> Raw, TArray<UTF8CHAR, TInlineAllocator<256>>& OutUtf8);
+
+	/** Converts raw string bytes read with ReadRawString to an FString. */
+	static FString RawStringToString(TArrayView<const uint8> Raw, bool bHasEscapes);
+
+private:
+	const uint8* Cursor;
+	const uint8* End;
+
+	// Optional structural index, and the first indexed offset that may still lie ahead of the cursor
+	const FCarespaceJsonIndex* Index;
+	int32 IndexCursor;
+
+	// Whether the next key or element is the first of its container, i.e. not preceded by a comma
+	bool bFirstInContainer;
+	bool bError;
+
+	void SkipWhitespace();
+	bool Fail();
+	bool ReadLiteral(const ANSICHAR* Literal, int32 Length);
+	bool ReadSeparator(uint8 Close);
+
+	/** @return Next indexed character at or after the cursor and before the end, or nullptr */
+	const uint8* SeekIndexed();
+};
+
+/**
+ * Appends condensed UTF-8 JSON to a byte array. Commas between members and elements are inserted
+ * automatically; callers only describe the structure.
+ */
+class CARESPACESDK_API FCarespaceJsonWriter
+{
+public:
+	explicit FCarespaceJsonWriter(TArray<uint8>& InOutput);
+
+	void BeginObject();
+	void EndObject();
+	void BeginArray();
+	void EndArray();
+
+	/**
+	 * Writes an object key that needs no escaping, followed by its colon.
+	 *
+	 * @param Key ASCII key name
+	 * @param Length Length of Key in bytes
+	 */
+	void WriteKey(const ANSICHAR* Key, int32 Length);
+
+	/** Writes a string literal key, e.g. WriteKey("email"). */
+	template <int32 N>
+	void WriteKey(const ANSICHAR (&Key)[N])
+	{
+		WriteKey(Key, N - 1);
+	}
+
+	void WriteString(FStringView Value);
+	void WriteInteger(int64 Value);
+	void WriteNumber(double Value);
+	void WriteBool(bool Value);
+	void WriteNull();
+
+	/** Writes a string from UTF-8 bytes, escaping quotes, backslashes and control characters. */
+	void WriteUtf8String(TArrayView<const uint8> Utf8);
+
+private:
+	TArray<uint8>& Output;
+	bool bNeedsComma;
+
+	void BeginValue();
+	void Append(const ANSICHAR* Text, int32 Length);
+};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CarespaceJsonCodec.h"
+
+/**
+ * Bump allocator for short-lived, trivially destructible data. Memory is taken from a few large
+ * blocks and released all at once by Reset or the destructor; nothing is freed individually.
+ */
+class CARESPACESDK_API FCarespaceJsonArena : public FNoncopyable
+{
+public:
+	/** @param InBlockSize Size of each block in bytes; larger requests get a block of their own */
+	explicit FCarespaceJsonArena(int32 InBlockSize = 16 * 1024);
+	~FCarespaceJsonArena();
+
+	void* Allocate(SIZE_T Size, SIZE_T Alignment);
+
+	/** @return Uninitialized storage for Count elements, or nullptr if Count is 0 */
+	template <typename T>
+	T* AllocateArray(int32 Count)
+	{
+		static_assert(TIsTriviallyDestructible<T>::Value, "Arena memory is released without running destructors");
+		return Count > 0 ? static_cast<T*>(Allocate(sizeof(T) * Count, alignof(T))) : nullptr;
+	}
+
+	/** Releases every block. */
+	void Reset();
+
+	/** @return Number of heap allocations made since the last reset */
+	int32 GetNumBlocks() const { return Blocks.Num(); }
+
+	/** @return Bytes handed out since the last reset */
+	SIZE_T GetBytesUsed() const { return BytesUsed; }
+
+private:
+	TArray<void*, TInlineAllocator<8>> Blocks;
+	uint8* Cursor = nullptr;
+	uint8* BlockEnd = nullptr;
+	SIZE_T BytesUsed = 0;
+	int32 BlockSize;
+};
+
+struct FCarespaceJsonMember;
+
+/**
+ * Value in an FCarespaceJsonDocument. Strings and numbers point into the parsed bytes; containers
+ * point into the document's arena.
+ */
+struct CARESPACESDK_API FCarespaceJsonNode
+{
+	ECarespaceJsonValueType Type = ECarespaceJsonValueType::None;
+	bool bHasEscapes = false;
+
+	/** Members or elements of a container, bytes of a string or number */
+	int32 Count = 0;
+
+	union
+	{
+		const uint8* Text;
+		const FCarespaceJsonMember* Members;
+		const FCarespaceJsonNode* Elements;
+		bool bValue;
+	};
+
+	FCarespaceJsonNode()
+		: Text(nullptr)
+	{
+	}
+
+	ECarespaceJsonValueType GetType() const { return Type; }
+
+	/**
+	 * Finds a member of an object, matching the key case-insensitively like FJsonObject does.
+	 *
+	 * @param Key ASCII key
+	 * @return The member's value, or nullptr if this is not an object or has no such member
+	 */
+	const FCarespaceJsonNode* FindField(FAnsiStringView Key) const;
+
+	TConstArrayView<FCarespaceJsonMember> GetMembers() const;
+	TConstArrayView<FCarespaceJsonNode> GetElements() const;
+
+	/** Converts strings, numbers and bools to a string, like FJsonValue::TryGetString. */
+	bool TryGetString(FString& OutValue) const;
+
+	/** @return Text of a string, number or bool, or an empty string for anything else */
+	FString AsString() const;
+
+	/** @return Value of a number, numeric string or bool, or 0 for anything else */
+	double AsNumber() const;
+
+	/** @return Value of a bool, non-zero number or "true" string */
+	bool AsBool() const;
+};
+
+struct FCarespaceJsonMember
+{
+	/** Raw UTF-8 key, escape sequences included */
+	const uint8* Key;
+	int32 KeyLength;
+	FCarespaceJsonNode Value;
+};
+
+/**
+ * Read-only JSON DOM for decoding a response. Unlike FJsonSerializer, which allocates and
+ * reference-counts every FJsonValue and FJsonObject, containers are stored contiguously in a
+ * per-document arena and strings are not copied at all, so a whole page costs a handful of
+ * allocations that are released together with the document.
+ *
+ * The parsed bytes must outlive the document.
+ */
+class CARESPACESDK_API FCarespaceJsonDocument : public FNoncopyable
+{
+public:
+	/**
+	 * Parses a document, discarding any previous one.
+	 *
+	 * @param Json UTF-8 encoded JSON, referenced by the nodes rather than copied
+	 * @return False if Json is not a single well-formed value
+	 */
+	bool Parse(TArrayView<const uint8> Json);
+
+	const FCarespaceJsonNode& GetRoot() const { return Root; }
+	const FCarespaceJsonArena& GetArena() const { return Arena; }
+
+private:
+	FCarespaceJsonArena Arena;
+	FCarespaceJsonNode Root;
+
+	// Children of the containers being parsed; copied to the arena once a container is closed
+	TArray<FCarespaceJsonNode, TInlineAllocator<64>> ElementStack;
+	TArray<FCarespaceJsonMember, TInlineAllocator<64>> MemberStack;
+
+	bool ParseValue(FCarespaceJsonReader& Reader, FCarespaceJsonNode& OutNode, int32 Depth);
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Structural index of a UTF-8 JSON document, in the style of the first stage of simdjson. The
+ * document is classified 64 bytes at a time with vector compares (AVX2, SSE2 or NEON, with a scalar
+ * fallback) into bitmasks of quotes, backslashes and structural characters. Escaped quotes and
+ * everything inside strings are then masked out with carry arithmetic and a prefix XOR, without
+ * branching on individual bytes.
+ *
+ * The index holds the sorted offsets of every brace, bracket, colon and comma outside strings, and of
+ * both quotes of every string. An FCarespaceJsonReader given the index jumps from quote to quote and
+ * over nested values instead of scanning them byte by byte.
+ */
+class CARESPACESDK_API FCarespaceJsonIndex
+{
+public:
+	/**
+	 * Indexes a document, discarding any previous index.
+	 *
+	 * @param InJson UTF-8 encoded JSON, referenced rather than copied
+	 * @return False if a string is unterminated or contains an unescaped control character
+	 */
+	bool Build(TArrayView<const uint8> InJson);
+
+	void Reset();
+
+	/** @return The indexed document */
+	TArrayView<const uint8> GetJson() const { return Json; }
+
+	/** @return Offsets of the structural characters and quotes, in document order */
+	TConstArrayView<uint32> GetStructurals() const { return Structurals; }
+
+	/** @return True if a backslash occurs in the document between offsets Begin (inclusive) and End (exclusive) */
+	bool HasBackslash(int32 Begin, int32 End) const;
+
+	/** @return Name of the classification kernel this build uses: "AVX2", "SSE2", "NEON" or "Scalar" */
+	static const TCHAR* GetKernelName();
+
+private:
+	TArrayView<const uint8> Json;
+	TArray<uint32> Structurals;
+
+	// Backslash mask of every 64-byte block, telling ReadRawString whether a string needs unescaping
+	TArray<uint64> Backslashes;
+};
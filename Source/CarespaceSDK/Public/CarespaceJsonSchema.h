@@ -0,0 +1,376 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CarespaceJsonCodec.h"
+#include "CarespaceJsonIndex.h"
+#include "Async/ParallelFor.h"
+#include "CarespaceTypes.h"
+
+#include <type_traits>
+
+/**
+ * Entry of a compile-time field table: the JSON key of one struct member and the functions that
+ * read it from and write it to JSON. Tables are built with CarespaceJson::MakeField.
+ */
+struct FCarespaceJsonField
+{
+	/** ASCII key as written by FJsonObjectConverter, matched case-insensitively when reading */
+	const ANSICHAR* Name;
+	int32 NameLength;
+
+	bool (*Read)(FCarespaceJsonReader& Reader, void* Struct);
+	void (*Write)(FCarespaceJsonWriter& Writer, const void* Struct);
+};
+
+/**
+ * Field table of a struct that can be converted without reflection. Specializations list the
+ * members in declaration order under the keys FJsonObjectConverter uses for them.
+ */
+template <typename T>
+struct TCarespaceJsonSchema;
+
+/**
+ * Typed JSON conversion driven by TCarespaceJsonSchema. The JSON contract is the one of
+ * FJsonObjectConverter: keys are matched case-insensitively, unknown keys are ignored, nulls keep the
+ * default value, and a value of the wrong type fails the whole struct.
+ */
+namespace CarespaceJson
+{
+	template <typename T, typename = void>
+	struct THasSchema
+	{
+		static constexpr bool Value = false;
+	};
+
+	template <typename T>
+	struct THasSchema<T, std::void_t<decltype(TCarespaceJsonSchema<T>::Fields)>>
+	{
+		static constexpr bool Value = true;
+	};
+
+	template <typename MemberPointerType>
+	struct TMemberPointerTraits;
+
+	template <typename ValueType, typename OwnerType>
+	struct TMemberPointerTraits<ValueType OwnerType::*>
+	{
+		using FOwner = OwnerType;
+		using FValue = ValueType;
+	};
+
+	/**
+	 * Reads the members of an object through a field table. Fields are looked up starting after the
+	 * previous match, so documents written in declaration order need one comparison per key.
+	 */
+	CARESPACESDK_API bool ReadFields(FCarespaceJsonReader& Reader, void* Struct, TConstArrayView<FCarespaceJsonField> Fields);
+
+	/**
+	 * Finds the elements of an array member of the top-level object, e.g. the "data" of a list response.
+	 *
+	 * @param Index Structural index of the document
+	 * @param ArrayField Key of the array, compared byte for byte like FCarespaceJsonStreamDecoder does
+	 * @param OutElements Receives the JSON text of every element, pointing into the document
+	 * @return False if the document is malformed; elements found before the error are kept
+	 */
+	CARESPACESDK_API bool FindArrayElements(const FCarespaceJsonIndex& Index, FAnsiStringView ArrayField, TArray<TArrayView<const uint8>>& OutElements);
+
+	/** Writes the members of a struct as an object, in table order. */
+	CARESPACESDK_API void WriteFields(FCarespaceJsonWriter& Writer, const void* Struct, TConstArrayView<FCarespaceJsonField> Fields);
+
+	CARESPACESDK_API bool ReadValue(FCarespaceJsonReader& Reader, FString& OutValue);
+	CARESPACESDK_API bool ReadValue(FCarespaceJsonReader& Reader, int32& OutValue);
+	CARESPACESDK_API bool ReadValue(FCarespaceJsonReader& Reader, bool& OutValue);
+	CARESPACESDK_API bool ReadValue(FCarespaceJsonReader& Reader, FDateTime& OutValue);
+
+	CARESPACESDK_API void WriteValue(FCarespaceJsonWriter& Writer, const FString& Value);
+	CARESPACESDK_API void WriteValue(FCarespaceJsonWriter& Writer, int32 Value);
+	CARESPACESDK_API void WriteValue(FCarespaceJsonWriter& Writer, bool Value);
+	CARESPACESDK_API void WriteValue(FCarespaceJsonWriter& Writer, const FDateTime& Value);
+
+	// Containers and nested structs are declared before any definition so that the member readers
+	// below find them; argument-dependent lookup does not search this namespace.
+	template <typename T>
+	bool ReadValue(FCarespaceJsonReader& Reader, TArray<T>& OutValue);
+
+	template <typename T>
+	void WriteValue(FCarespaceJsonWriter& Writer, const TArray<T>& Value);
+
+	template <typename T, typename = std::enable_if_t<THasSchema<T>::Value>>
+	bool ReadValue(FCarespaceJsonReader& Reader, T& OutValue);
+
+	template <typename T, typename = std::enable_if_t<THasSchema<T>::Value>>
+	void WriteValue(FCarespaceJsonWriter& Writer, const T& Value);
+
+	template <auto Member>
+	bool ReadMember(FCarespaceJsonReader& Reader, void* Struct)
+	{
+		using FOwner = typename TMemberPointerTraits<decltype(Member)>::FOwner;
+		return ReadValue(Reader, static_cast<FOwner*>(Struct)->*Member);
+	}
+
+	template <auto Member>
+	void WriteMember(FCarespaceJsonWriter& Writer, const void* Struct)
+	{
+		using FOwner = typename TMemberPointerTraits<decltype(Member)>::FOwner;
+		WriteValue(Writer, static_cast<const FOwner*>(Struct)->*Member);
+	}
+
+	/**
+	 * Builds the table entry of a struct member.
+	 *
+	 * @param Name JSON key of the member
+	 */
+	template <auto Member, int32 NameSize>
+	constexpr FCarespaceJsonField MakeField(const ANSICHAR (&Name)[NameSize])
+	{
+		return FCarespaceJsonField{ Name, NameSize - 1, &ReadMember<Member>, &WriteMember<Member> };
+	}
+
+	template <typename T>
+	bool ReadValue(FCarespaceJsonReader& Reader, TArray<T>& OutValue)
+	{
+		if (!Reader.ReadArrayStart())
+		{
+			return false;
+		}
+
+		OutValue.Reset();
+		while (Reader.ReadNextElement())
+		{
+			T& Element = OutValue.AddDefaulted_GetRef();
+			if (!Reader.ReadNull() && !ReadValue(Reader, Element))
+			{
+				return false;
+			}
+		}
+		return !Reader.HasError();
+	}
+
+	template <typename T>
+	void WriteValue(FCarespaceJsonWriter& Writer, const TArray<T>& Value)
+	{
+		Writer.BeginArray();
+		for (const T& Element : Value)
+		{
+			WriteValue(Writer, Element);
+		}
+		Writer.EndArray();
+	}
+
+	template <typename T, typename>
+	bool ReadValue(FCarespaceJsonReader& Reader, T& OutValue)
+	{
+		return ReadFields(Reader, &OutValue, TCarespaceJsonSchema<T>::Fields);
+	}
+
+	template <typename T, typename>
+	void WriteValue(FCarespaceJsonWriter& Writer, const T& Value)
+	{
+		WriteFields(Writer, &Value, TCarespaceJsonSchema<T>::Fields);
+	}
+
+	/**
+	 * Decodes a JSON object into a struct with a field table.
+	 *
+	 * @param JsonBytes UTF-8 encoded JSON object
+	 * @param OutValue Struct to fill; members missing from the document are left untouched
+	 * @return False if the document is malformed or a member has the wrong type
+	 */
+	template <typename T>
+	bool FromJson(TArrayView<const uint8> JsonBytes, T& OutValue)
+	{
+		FCarespaceJsonReader Reader(JsonBytes);
+		return ReadValue(Reader, OutValue) && !Reader.HasError();
+	}
+
+	/** Elements decoded per task by FromJsonList; lists of at most this many are decoded on the calling thread. */
+	constexpr int32 ListDecodeBatchSize = 8;
+
+	/**
+	 * Decodes the elements of a list response such as {"data": [...], "total": 2} through a structural
+	 * index of the whole body. Once the index has delimited them the elements are independent, so they
+	 * are decoded in parallel batches and assembled in document order. Elements that do not match the
+	 * struct are skipped, like TCarespaceJsonListDecoder does.
+	 *
+	 * @param JsonBytes UTF-8 encoded JSON object
+	 * @param ArrayField Key of the array holding the elements
+	 * @param OutItems Receives the decoded elements
+	 * @param Flags Scheduling of the decode tasks, e.g. ForceSingleThread
+	 * @return False if the document is malformed
+	 */
+	template <typename T>
+	bool FromJsonList(TArrayView<const uint8> JsonBytes, FAnsiStringView ArrayField, TArray<T>& OutItems, EParallelForFlags Flags = EParallelForFlags::None)
+	{
+		FCarespaceJsonIndex Index;
+		TArray<TArrayView<const uint8>> Elements;
+		const bool bValid = Index.Build(JsonBytes) && FindArrayElements(Index, ArrayField, Elements);
+
+		TArray<T> Items;
+		Items.SetNum(Elements.Num());
+		TArray<bool> Decoded;
+		Decoded.SetNumZeroed(Elements.Num());
+
+		// A single batch isn't worth a task, so it always stays on the calling thread
+		const EParallelForFlags DecodeFlags = Elements.Num() <= ListDecodeBatchSize ? Flags | EParallelForFlags::ForceSingleThread : Flags;
+		ParallelFor(TEXT("CarespaceJson::FromJsonList"), Elements.Num(), ListDecodeBatchSize, [&Elements, &Index, &Items, &Decoded](int32 ElementIndex)
+		{
+			FCarespaceJsonReader Reader(Elements[ElementIndex], Index);
+			Decoded[ElementIndex] = ReadValue(Reader, Items[ElementIndex]) && !Reader.HasError();
+		}, DecodeFlags);
+
+		if (OutItems.IsEmpty() && !Decoded.Contains(false))
+		{
+			OutItems = MoveTemp(Items);
+			return bValid;
+		}
+
+		OutItems.Reserve(OutItems.Num() + Elements.Num());
+		for (int32 ElementIndex = 0; ElementIndex < Items.Num(); ++ElementIndex)
+		{
+			if (Decoded[ElementIndex])
+			{
+				OutItems.Add(MoveTemp(Items[ElementIndex]));
+			}
+		}
+		return bValid;
+	}
+
+	/** Appends the condensed UTF-8 JSON of a struct with a field table to OutJson. */
+	template <typename T>
+	void ToJson(const T& Value, TArray<uint8>& OutJson)
+	{
+		FCarespaceJsonWriter Writer(OutJson);
+		WriteValue(Writer, Value);
+	}
+
+	/** @return Condensed UTF-8 JSON of a struct with a field table, ready to send as a request body */
+	template <typename T>
+	TArray<uint8> ToJsonBytes(const T& Value)
+	{
+		TArray<uint8> Json;
+		ToJson(Value, Json);
+		return Json;
+	}
+
+	/** @return Condensed JSON of a struct with a field table */
+	template <typename T>
+	FString ToJsonString(const T& Value)
+	{
+		const TArray<uint8> Json = ToJsonBytes(Value);
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Json.GetData()), Json.Num());
+		return FString(Converter.Length(), Converter.Get());
+	}
+}
+
+template <>
+struct TCarespaceJsonSchema<FCarespaceUser>
+{
+	static constexpr FCarespaceJsonField Fields[] =
+	{
+		CarespaceJson::MakeField<&FCarespaceUser::Id>("id"),
+		CarespaceJson::MakeField<&FCarespaceUser::Email>("email"),
+		CarespaceJson::MakeField<&FCarespaceUser::Name>("name"),
+		CarespaceJson::MakeField<&FCarespaceUser::FirstName>("firstName"),
+		CarespaceJson::MakeField<&FCarespaceUser::LastName>("lastName"),
+		CarespaceJson::MakeField<&FCarespaceUser::Role>("role"),
+		CarespaceJson::MakeField<&FCarespaceUser::bIsActive>("bIsActive"),
+		CarespaceJson::MakeField<&FCarespaceUser::CreatedAt>("createdAt"),
+		CarespaceJson::MakeField<&FCarespaceUser::UpdatedAt>("updatedAt"),
+	};
+};
+
+template <>
+struct TCarespaceJsonSchema<FCarespaceAddress>
+{
+	static constexpr FCarespaceJsonField Fields[] =
+	{
+		CarespaceJson::MakeField<&FCarespaceAddress::Street>("street"),
+		CarespaceJson::MakeField<&FCarespaceAddress::City>("city"),
+		CarespaceJson::MakeField<&FCarespaceAddress::State>("state"),
+		CarespaceJson::MakeField<&FCarespaceAddress::ZipCode>("zipCode"),
+		CarespaceJson::MakeField<&FCarespaceAddress::Country>("country"),
+	};
+};
+
+template <>
+struct TCarespaceJsonSchema<FCarespaceClient>
+{
+	static constexpr FCarespaceJsonField Fields[] =
+	{
+		CarespaceJson::MakeField<&FCarespaceClient::Id>("id"),
+		CarespaceJson::MakeField<&FCarespaceClient::Name>("name"),
+		CarespaceJson::MakeField<&FCarespaceClient::Email>("email"),
+		CarespaceJson::MakeField<&FCarespaceClient::Phone>("phone"),
+		CarespaceJson::MakeField<&FCarespaceClient::DateOfBirth>("dateOfBirth"),
+		CarespaceJson::MakeField<&FCarespaceClient::Gender>("gender"),
+		CarespaceJson::MakeField<&FCarespaceClient::Address>("address"),
+		CarespaceJson::MakeField<&FCarespaceClient::MedicalHistory>("medicalHistory"),
+		CarespaceJson::MakeField<&FCarespaceClient::Notes>("notes"),
+		CarespaceJson::MakeField<&FCarespaceClient::bIsActive>("bIsActive"),
+		CarespaceJson::MakeField<&FCarespaceClient::CreatedAt>("createdAt"),
+		CarespaceJson::MakeField<&FCarespaceClient::UpdatedAt>("updatedAt"),
+	};
+};
+
+template <>
+struct TCarespaceJsonSchema<FCarespaceExercise>
+{
+	static constexpr FCarespaceJsonField Fields[] =
+	{
+		CarespaceJson::MakeField<&FCarespaceExercise::Id>("id"),
+		CarespaceJson::MakeField<&FCarespaceExercise::Name>("name"),
+		CarespaceJson::MakeField<&FCarespaceExercise::Description>("description"),
+		CarespaceJson::MakeField<&FCarespaceExercise::Instructions>("instructions"),
+		CarespaceJson::MakeField<&FCarespaceExercise::VideoURL>("videoURL"),
+		CarespaceJson::MakeField<&FCarespaceExercise::ImageURL>("imageURL"),
+		CarespaceJson::MakeField<&FCarespaceExercise::Duration>("duration"),
+		CarespaceJson::MakeField<&FCarespaceExercise::Repetitions>("repetitions"),
+		CarespaceJson::MakeField<&FCarespaceExercise::Sets>("sets"),
+		CarespaceJson::MakeField<&FCarespaceExercise::RestTime>("restTime"),
+		CarespaceJson::MakeField<&FCarespaceExercise::Order>("order"),
+	};
+};
+
+template <>
+struct TCarespaceJsonSchema<FCarespaceProgram>
+{
+	static constexpr FCarespaceJsonField Fields[] =
+	{
+		CarespaceJson::MakeField<&FCarespaceProgram::Id>("id"),
+		CarespaceJson::MakeField<&FCarespaceProgram::Name>("name"),
+		CarespaceJson::MakeField<&FCarespaceProgram::Description>("description"),
+		CarespaceJson::MakeField<&FCarespaceProgram::Category>("category"),
+		CarespaceJson::MakeField<&FCarespaceProgram::Difficulty>("difficulty"),
+		CarespaceJson::MakeField<&FCarespaceProgram::Duration>("duration"),
+		CarespaceJson::MakeField<&FCarespaceProgram::bIsTemplate>("bIsTemplate"),
+		CarespaceJson::MakeField<&FCarespaceProgram::bIsActive>("bIsActive"),
+		CarespaceJson::MakeField<&FCarespaceProgram::CreatedBy>("createdBy"),
+		CarespaceJson::MakeField<&FCarespaceProgram::CreatedAt>("createdAt"),
+		CarespaceJson::MakeField<&FCarespaceProgram::UpdatedAt>("updatedAt"),
+		CarespaceJson::MakeField<&FCarespaceProgram::Exercises>("exercises"),
+	};
+};
+
+template <>
+struct TCarespaceJsonSchema<FCarespaceLoginRequest>
+{
+	static constexpr FCarespaceJsonField Fields[] =
+	{
+		CarespaceJson::MakeField<&FCarespaceLoginRequest::Email>("email"),
+		CarespaceJson::MakeField<&FCarespaceLoginRequest::Password>("password"),
+	};
+};
+
+template <>
+struct TCarespaceJsonSchema<FCarespaceCreateUserRequest>
+{
+	static constexpr FCarespaceJsonField Fields[] =
+	{
+		CarespaceJson::MakeField<&FCarespaceCreateUserRequest::Email>("email"),
+		CarespaceJson::MakeField<&FCarespaceCreateUserRequest::Name>("name"),
+		CarespaceJson::MakeField<&FCarespaceCreateUserRequest::FirstName>("firstName"),
+		CarespaceJson::MakeField<&FCarespaceCreateUserRequest::LastName>("lastName"),
+		CarespaceJson::MakeField<&FCarespaceCreateUserRequest::Role>("role"),
+		CarespaceJson::MakeField<&FCarespaceCreateUserRequest::Password>("password"),
+	};
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CarespaceHTTPClient.h"
+#include "CarespaceJsonSchema.h"
+
+/**
+ * Incremental decoder for list responses shaped like {"data": [{...}, {...}], "total": 2}.
+ * Bytes may be fed in chunks of any size as they arrive from the transport. Every element of the
+ * array field is handed to HandleElement as soon as its last byte has been seen, so decoding overlaps
+ * the download and only one element is ever held as JSON text; no DOM of the whole document is built.
+ *
+ * Feed is not thread-safe, but may be called from any single thread at a time, e.g. the HTTP thread.
+ */
+class CARESPACESDK_API FCarespaceJsonStreamDecoder
+{
+public:
+	/** @param InArrayField Top-level field whose array elements are emitted */
+	explicit FCarespaceJsonStreamDecoder(const FString& InArrayField = TEXT("data"));
+	virtual ~FCarespaceJsonStreamDecoder() = default;
+
+	/**
+	 * Consumes the next chunk of the document. Input after a syntax error is ignored.
+	 *
+	 * @param Bytes UTF-8 encoded JSON, continuing where the previous chunk ended
+	 */
+	void Feed(TArrayView<const uint8> Bytes);
+
+	/** Forgets everything fed so far, e.g. before the body of a retried request arrives. */
+	virtual void Reset();
+
+	/** @return True once the whole top-level object has been consumed without error */
+	bool IsComplete() const { return bComplete && !bFailed; }
+
+	/** @return True if the input is not a JSON object, e.g. because it is still compressed */
+	bool HasFailed() const { return bFailed; }
+
+	/** @return Number of elements emitted so far */
+	int32 GetNumElements() const { return NumElements; }
+
+protected:
+	/**
+	 * Called on the feeding thread for every complete element of the array field.
+	 *
+	 * @param ElementJson UTF-8 JSON text of the element, only valid during the call
+	 */
+	virtual void HandleElement(TArrayView<const uint8> ElementJson) = 0;
+
+private:
+	TArray<uint8> ArrayField;
+
+	// Key of the top-level field being read, and the bytes of the element being accumulated
+	TArray<uint8> Key;
+	TArray<uint8> Element;
+
+	int32 Depth;
+	int32 NumElements;
+	bool bInString;
+	bool bEscaped;
+	bool bExpectKey;
+	bool bReadingKey;
+	bool bInArray;
+	bool bInElement;
+	bool bStarted;
+	bool bComplete;
+	bool bFailed;
+
+	void EmitElement(int32 Length);
+};
+
+/**
+ * Stream decoder that converts every element of a list response into a USTRUCT as it arrives.
+ * Elements that do not match the struct are skipped, like FJsonObjectConverter does for whole arrays.
+ * Structs with a TCarespaceJsonSchema field table are decoded straight from the bytes without reflection.
+ */
+template <typename StructType>
+class TCarespaceJsonListDecoder : public FCarespaceJsonStreamDecoder
+{
+public:
+	explicit TCarespaceJsonListDecoder(const FString& InArrayField = TEXT("data"))
+		: FCarespaceJsonStreamDecoder(InArrayField)
+	{
+	}
+
+	virtual void Reset() override
+	{
+		FCarespaceJsonStreamDecoder::Reset();
+		Items.Reset();
+	}
+
+	/** @return Items decoded so far; the decoder keeps none of them */
+	TArray<StructType> MoveItems() { return MoveTemp(Items); }
+
+protected:
+	virtual void HandleElement(TArrayView<const uint8> ElementJson) override
+	{
+		StructType Item;
+		bool bDecoded;
+		if constexpr (CarespaceJson::THasSchema<StructType>::Value)
+		{
+			bDecoded = CarespaceJson::FromJson(ElementJson, Item);
+		}
+		else
+		{
+			bDecoded = UCarespaceHTTPClient::JsonBytesToStruct(ElementJson, StructType::StaticStruct(), &Item);
+		}
+
+		if (bDecoded)
+		{
+			Items.Add(MoveTemp(Item));
+		}
+	}
+
+private:
+	TArray<StructType> Items;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Sliding window of observed response latencies per endpoint family, used to decide when a
+ * request is slow enough to be worth hedging. Only the most recent samples are kept so that
+ * the percentiles follow changes in backend performance.
+ */
+class CARESPACESDK_API FCarespaceLatencyTracker
+{
+public:
+	explicit FCarespaceLatencyTracker(int32 InWindowSize = 128);
+
+	/**
+	 * Maps an endpoint path to the family its latency is tracked under: the first path segment,
+	 * so that "/programs/123" and "/programs/456" share statistics.
+	 *
+	 * @param Endpoint Endpoint path relative to the base URL
+	 * @return Family such as "/programs"
+	 */
+	static FString GetEndpointFamily(const FString& Endpoint);
+
+	/** Records the latency of one successful response. */
+	void AddSample(const FString& Key, double Seconds);
+
+	/**
+	 * Computes a latency percentile over the current window.
+	 *
+	 * @param Key Family key the samples were recorded under
+	 * @param Percentile Percentile in [0, 1], e.g. 0.95
+	 * @param MinSamples Number of samples required for a meaningful estimate
+	 * @param OutSeconds Latency at the requested percentile
+	 * @return False if fewer than MinSamples samples have been recorded
+	 */
+	bool GetPercentile(const FString& Key, float Percentile, int32 MinSamples, double& OutSeconds) const;
+
+	void Reset();
+
+private:
+	struct FWindow
+	{
+		TArray<float> Samples;
+		int32 NextIndex = 0;
+	};
+
+	TMap<FString, FWindow> Windows;
+	int32 WindowSize;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CarespaceHTTPClient.h"
+
+/**
+ * An endpoint whose verb, path template and scheduling options are parsed once and reused for every call.
+ * Path templates name their variable segments in braces, e.g. "/users/{id}"; the literal parts are
+ * stored ready to append, so a call only URL-encodes and appends its arguments.
+ *
+ * Prepared endpoints are immutable and are meant to be created once, typically as function-local statics:
+ *
+ *   static const FCarespacePreparedEndpoint GetUser(TEXT("GET"), TEXT("/users/{id}"));
+ *   HTTPClient->SendPrepared(GetUser, { FStringView(UserId) }, TMap<FString, FString>(), TArray<uint8>(), OnComplete);
+ */
+class CARESPACESDK_API FCarespacePreparedEndpoint
+{
+public:
+	/**
+	 * @param InVerb HTTP verb ("GET", "POST", "PUT" or "DELETE")
+	 * @param InPathTemplate Endpoint path relative to the base URL, with {name} placeholders
+	 */
+	FCarespacePreparedEndpoint(const TCHAR* InVerb, const TCHAR* InPathTemplate);
+
+	/** Same as above, with explicit scheduling options instead of the lane derived from the path. */
+	FCarespacePreparedEndpoint(const TCHAR* InVerb, const TCHAR* InPathTemplate, const FCarespaceRequestOptions& InOptions);
+
+	const FString& GetVerb() const { return Verb; }
+	const FString& GetPathTemplate() const { return PathTemplate; }
+	const FCarespaceRequestOptions& GetOptions() const { return Options; }
+	int32 GetNumArguments() const { return Literals.Num() - 1; }
+
+	/**
+	 * Appends the endpoint path with its placeholders replaced by the URL-encoded arguments.
+	 *
+	 * @param Out Builder to append to
+	 * @param Arguments One value per placeholder, in template order
+	 * @return False if the number of arguments does not match the template
+	 */
+	bool AppendPath(FStringBuilderBase& Out, TArrayView<const FStringView> Arguments) const;
+
+	/** Appends Value with every character outside the URL unreserved set percent-encoded. */
+	static void AppendUrlEncoded(FStringBuilderBase& Out, FStringView Value);
+
+private:
+	FString Verb;
+	FString PathTemplate;
+	FCarespaceRequestOptions Options;
+
+	// Text between placeholders; an argument goes between each consecutive pair
+	TArray<FString> Literals;
+
+	void ParseTemplate();
+};
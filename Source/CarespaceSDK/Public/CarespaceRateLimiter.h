@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CarespaceRateLimiter.generated.h"
+
+/**
+ * Snapshot of a single rate limit bucket, as exposed by UCarespaceHTTPClient::GetRateLimitStates.
+ */
+USTRUCT(BlueprintType)
+struct CARESPACESDK_API FCarespaceRateLimitState
+{
+	GENERATED_BODY()
+
+	/** Endpoint class the bucket applies to ("auth", "standard" or "bulk") */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|RateLimit")
+	FString EndpointClass;
+
+	/** Requests allowed per window, as last reported by X-RateLimit-Limit or the documented default */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|RateLimit")
+	int32 Limit = 0;
+
+	/** Requests that may be sent right now without waiting */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|RateLimit")
+	float AvailableTokens = 0.0f;
+
+	/** Rate at which the bucket refills, in requests per second */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|RateLimit")
+	float RefillPerSecond = 0.0f;
+
+	/** Seconds until the server window resets, 0 if unknown */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|RateLimit")
+	float SecondsUntilReset = 0.0f;
+
+	/** True once the bucket has been updated from X-RateLimit-* response headers */
+	UPROPERTY(BlueprintReadOnly, Category = "Carespace|RateLimit")
+	bool bLearnedFromServer = false;
+};
+
+/**
+ * Client-side token bucket limiter that paces outgoing requests per endpoint class.
+ * Buckets start from the limits documented in API-REFERENCE.md and are corrected from the
+ * X-RateLimit-Limit, X-RateLimit-Remaining and X-RateLimit-Reset headers of every response,
+ * so the client slows down before the server starts answering with 429.
+ *
+ * All times are in FPlatformTime::Seconds() units and passed in explicitly.
+ */
+class CARESPACESDK_API FCarespaceRateLimiter
+{
+public:
+	FCarespaceRateLimiter();
+
+	/**
+	 * Maps an endpoint path to the class of rate limit that applies to it.
+	 *
+	 * @param Endpoint Endpoint path relative to the base URL (e.g. "/auth/login")
+	 * @return "auth", "bulk" or "standard"
+	 */
+	static FString GetEndpointClass(const FString& Endpoint);
+
+	/**
+	 * Overrides the initial budget of an endpoint class until the server reports its own.
+	 *
+	 * @param EndpointClass Class to configure
+	 * @param Limit Requests allowed per window
+	 * @param WindowSeconds Length of the window in seconds
+	 */
+	void SetDefaultBudget(const FString& EndpointClass, int32 Limit, double WindowSeconds);
+
+	/**
+	 * Returns how long a request of the given class has to wait before a token is available.
+	 *
+	 * @return 0 if a token is available now, otherwise the wait in seconds
+	 */
+	double GetWaitTime(const FString& EndpointClass, double Now);
+
+	/** Takes one token from the bucket of the given class. */
+	void ConsumeToken(const FString& EndpointClass, double Now);
+
+	/**
+	 * Corrects a bucket from the rate limit headers of a response.
+	 *
+	 * @param EndpointClass Class of the endpoint that produced the response
+	 * @param Limit Value of X-RateLimit-Limit
+	 * @param Remaining Value of X-RateLimit-Remaining
+	 * @param Reset Value of X-RateLimit-Reset (Unix timestamp or seconds until reset), negative if absent
+	 * @param Now Current time
+	 */
+	void UpdateFromHeaders(const FString& EndpointClass, int32 Limit, int32 Remaining, int64 Reset, double Now);
+
+	/**
+	 * Empties a bucket after the server answered 429, blocking it until the given time.
+	 *
+	 * @param EndpointClass Class of the rejected endpoint
+	 * @param RetryAfterSeconds Server supplied delay, or a negative value to wait for the window reset
+	 * @param Now Current time
+	 */
+	void HandleRateLimited(const FString& EndpointClass, double RetryAfterSeconds, double Now);
+
+	/** @return State of every bucket that has been used or configured */
+	TArray<FCarespaceRateLimitState> GetStates(double Now);
+
+private:
+	struct FBucket
+	{
+		double Capacity = 0.0;
+		double Tokens = 0.0;
+		double RefillPerSecond = 0.0;
+		double WindowSeconds = 0.0;
+		double LastRefillTime = 0.0;
+		double ResetTime = 0.0;
+		double BlockedUntil = 0.0;
+		bool bLearnedFromServer = false;
+	};
+
+	TMap<FString, FBucket> Buckets;
+
+	FBucket& FindOrAddBucket(const FString& EndpointClass, double Now);
+	static void Refill(FBucket& Bucket, double Now);
+};
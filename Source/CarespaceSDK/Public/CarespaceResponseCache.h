@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/List.h"
+
+/**
+ * A GET response body kept for conditional revalidation, together with its validators.
+ */
+struct FCarespaceCachedResponse
+{
+	/** Value of the ETag response header, sent back as If-None-Match */
+	FString ETag;
+
+	/** Value of the Last-Modified response header, sent back as If-Modified-Since */
+	FString LastModified;
+
+	/** Raw response body as received from the server */
+	TArray<uint8> Body;
+};
+
+/**
+ * In-memory HTTP response cache with a least-recently-used byte budget.
+ * Entries are only ever served after the server confirmed them with 304 Not Modified,
+ * so the cache never returns stale data; it only saves transferring unchanged bodies.
+ *
+ * Entries are handed out as shared references, which keeps a body alive for a request
+ * that is revalidating it even if the entry is evicted in the meantime.
+ */
+class CARESPACESDK_API FCarespaceResponseCache
+{
+public:
+	explicit FCarespaceResponseCache(int64 InMaxBytes = 8 * 1024 * 1024);
+	~FCarespaceResponseCache();
+
+	/** Changes the byte budget, evicting least recently used entries if needed. */
+	void SetMaxBytes(int64 InMaxBytes);
+
+	/**
+	 * Looks up an entry and marks it as most recently used.
+	 *
+	 * @param Key Canonical request key
+	 * @return The cached entry, or nullptr if there is none
+	 */
+	TSharedPtr<const FCarespaceCachedResponse> Find(const FString& Key);
+
+	/**
+	 * Adds or replaces an entry. Bodies larger than the whole budget are not stored.
+	 *
+	 * @param Key Canonical request key
+	 * @param Entry Response body and validators
+	 */
+	void Store(const FString& Key, TSharedRef<const FCarespaceCachedResponse> Entry);
+
+	/** Drops a single entry. */
+	void Remove(const FString& Key);
+
+	/** Drops every entry. */
+	void Empty();
+
+	int64 GetTotalBytes() const { return TotalBytes; }
+	int64 GetMaxBytes() const { return MaxBytes; }
+	int32 Num() const { return Entries.Num(); }
+
+private:
+	struct FEntry
+	{
+		TSharedRef<const FCarespaceCachedResponse> Response;
+		TDoubleLinkedList<FString>::TDoubleLinkedListNode* RecencyNode;
+		int64 Size;
+	};
+
+	TMap<FString, FEntry> Entries;
+
+	// Most recently used key at the head, eviction candidates at the tail
+	TDoubleLinkedList<FString> RecencyList;
+
+	int64 MaxBytes;
+	int64 TotalBytes;
+
+	static int64 GetEntrySize(const FString& Key, const FCarespaceCachedResponse& Response);
+	void EvictToFit(int64 BytesNeeded);
+};
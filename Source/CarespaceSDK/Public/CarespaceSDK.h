@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+class FCarespaceCompletionDispatcher;
+
 class FCarespaceSDKModule : public IModuleInterface
 {
 public:
@@ -10,4 +12,8 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	/** Runs SDK completions on the game thread under a per-frame budget */
+	TUniquePtr<FCarespaceCompletionDispatcher> CompletionDispatcher;
 };
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FCarespaceJsonReader;
+class FCarespaceJsonWriter;
+class FCarespaceStructPlan;
+
+/**
+ * Precomputed conversion of one property: its keys and the handlers for its type.
+ */
+struct FCarespacePropertyPlan
+{
+	const FProperty* Property = nullptr;
+
+	/** UTF-8 key as written by FJsonObjectConverter, already escaped for JSON */
+	TArray<ANSICHAR> WriteKey;
+
+	/** UTF-8 authored name that incoming keys are matched against case-insensitively */
+	TArray<uint8> ReadKey;
+
+	bool (*Read)(FCarespaceJsonReader& Reader, const FCarespacePropertyPlan& Plan, void* Value) = nullptr;
+	void (*Write)(FCarespaceJsonWriter& Writer, const FCarespacePropertyPlan& Plan, const void* Value) = nullptr;
+
+	/** Plan of the elements of an array property */
+	TSharedPtr<const FCarespacePropertyPlan> Inner;
+
+	/** Plan of the members of a struct property */
+	TSharedPtr<const FCarespaceStructPlan> Struct;
+};
+
+/**
+ * Serialization plan of a UStruct for the generic StructToJsonString / JsonStringToStruct helpers.
+ * Walking the properties, encoding their keys and choosing a handler per type happens once per
+ * struct type; converting an instance afterwards only runs the handlers against the condensed
+ * FCarespaceJsonWriter and FCarespaceJsonReader, without FJsonValue objects.
+ *
+ * Plans follow the JSON contract of FJsonObjectConverter. Structs with a property the plan cannot
+ * handle (maps, sets, object references, static arrays) are not supported, and callers fall back to
+ * the converter for them.
+ */
+class CARESPACESDK_API FCarespaceStructPlan
+{
+public:
+	/**
+	 * Returns the plan of a struct, building and caching it on first use. Safe to call from any thread.
+	 *
+	 * @param Struct Struct type to convert
+	 * @return Cached plan; check IsSupported before using it
+	 */
+	static TSharedRef<const FCarespaceStructPlan> Get(const UStruct* Struct);
+
+	/** Drops all cached plans, e.g. after struct types have been reloaded. */
+	static void ResetCache();
+
+	bool IsSupported() const { return bSupported; }
+
+	/** Writes a struct instance as a JSON object. */
+	void Write(FCarespaceJsonWriter& Writer, const void* Struct) const;
+
+	/**
+	 * Reads a JSON object into a struct instance. Members missing from the document are left untouched.
+	 *
+	 * @return False if the document is malformed or a member has the wrong type
+	 */
+	bool Read(FCarespaceJsonReader& Reader, void* Struct) const;
+
+private:
+	TArray<FCarespacePropertyPlan> Properties;
+	bool bSupported = true;
+
+	static TSharedRef<const FCarespaceStructPlan> GetOrBuild(const UStruct* Struct, int32 Depth);
+	static bool BuildPropertyPlan(const FProperty* Property, FCarespacePropertyPlan& OutPlan, int32 Depth);
+};
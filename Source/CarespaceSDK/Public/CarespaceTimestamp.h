@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed-format parser for the RFC 3339 timestamps the Carespace API sends, e.g. "2024-01-02T03:04:05.123Z".
+ * Fields sit at fixed offsets, so they are read with a handful of digit checks and arithmetic instead of
+ * the tokenizing FDateTime::ParseIso8601 does, and nothing is allocated.
+ *
+ * Accepted forms are "YYYY-MM-DD" and "YYYY-MM-DDTHH:MM:SS" with an optional fraction of any length and an
+ * optional "Z" or "+HH:MM" / "-HH:MM" offset; 't', 'z' and a space separator are accepted as well. Anything
+ * else is rejected so callers can fall back to the engine parsers.
+ */
+struct CARESPACESDK_API FCarespaceTimestamp
+{
+	/**
+	 * Parses a timestamp into UTC ticks. Comparing ticks is enough to order two timestamps, e.g. to
+	 * check whether an UpdatedAt is newer, without building FDateTime values.
+	 *
+	 * @param Utf8 Text of the timestamp
+	 * @param OutTicks 100-nanosecond ticks since 0001-01-01 UTC, as FDateTime::GetTicks returns them
+	 * @return False if the text is not in one of the accepted forms or names an invalid date
+	 */
+	static bool ParseTicks(TArrayView<const uint8> Utf8, int64& OutTicks);
+
+	/** Variant of ParseTicks for text held in an FString. */
+	static bool ParseTicks(FStringView Text, int64& OutTicks);
+
+	/** Parses a timestamp into a UTC FDateTime. */
+	static bool Parse(FStringView Text, FDateTime& OutDateTime);
+};
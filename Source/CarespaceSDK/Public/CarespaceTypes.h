@@ -4,6 +4,10 @@
 #include "Engine/Engine.h"
 #include "CarespaceTypes.generated.h"
 
+// Version of the data types below and of their JSON mapping. Bump whenever a type or field
+// changes so that persisted responses written by an older SDK are discarded instead of misread.
+#define CARESPACE_SDK_SCHEMA_VERSION 1
+
 // Forward declarations
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnCarespaceRequestComplete, bool, bWasSuccessful);
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnCarespaceLoginComplete, bool, bWasSuccessful, const FString&, AccessToken);
@@ -19,7 +23,9 @@ enum class ECarespaceErrorType : uint8
 	AuthenticationError UMETA(DisplayName = "Authentication Error"),
 	ValidationError UMETA(DisplayName = "Validation Error"),
 	ServerError UMETA(DisplayName = "Server Error"),
-	UnknownError UMETA(DisplayName = "Unknown Error")
+	UnknownError UMETA(DisplayName = "Unknown Error"),
+	TimeoutError UMETA(DisplayName = "Timeout Error"),
+	CircuitOpenError UMETA(DisplayName = "Circuit Open")
 };
 
 USTRUCT(BlueprintType)
@@ -4,6 +4,10 @@
 #include "CarespaceAPI.h"
 #include "MockCarespaceHTTPClient.h"
 #include "CarespaceTypes.h"
+#include "CarespaceTestDelegateReceiver.h"
+#include "CarespaceTestLatentCommands.h"
+#include "CarespaceTestTransport.h"
+#include "UObject/StrongObjectPtr.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogCarespaceAPITests, Log, All);
 
@@ -331,4 +335,204 @@ bool FCarespaceAPIErrorHandlingTest::RunTest(const FString& Parameters)
 	TestEqual("Error code should match", ReceivedError.Code, TEXT("VALIDATION_ERROR"));
 	
 	return !HasAnyErrors();
-}
\ No newline at end of file
+}
+
+/**
+ * Test suite for the latest-wins Search* queries of UCarespaceAPI.
+ * Verifies that a burst of calls collapses into one request after the debounce interval and that a
+ * superseded or cancelled search never calls back, even when its response is already being parsed.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceAPISearchTest, "CarespaceSDK.API.Search",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceAPISearchTest::RunTest(const FString& Parameters)
+{
+	struct FState
+	{
+		TStrongObjectPtr<UCarespaceAPI> API;
+		TStrongObjectPtr<UCarespaceTestDelegateReceiver> Receiver;
+		TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+		FOnCarespaceUsersReceived OnUsers;
+		FOnCarespaceClientsReceived OnClients;
+	};
+	TSharedRef<FState> State = MakeShared<FState>();
+	State->API.Reset(NewObject<UCarespaceAPI>());
+	State->API->Initialize(TEXT("https://api-test.carespace.ai"), TEXT("test-api-key"));
+	State->API->GetHTTPClient()->SetTransport(State->Transport);
+	State->Receiver.Reset(NewObject<UCarespaceTestDelegateReceiver>());
+	State->OnUsers.BindDynamic(State->Receiver.Get(), &UCarespaceTestDelegateReceiver::OnUsersReceived);
+	State->OnClients.BindDynamic(State->Receiver.Get(), &UCarespaceTestDelegateReceiver::OnClientsReceived);
+
+	// Typing "ann" sends one request once the input settles
+	State->API->SearchUsers(1, 20, TEXT("a"), State->OnUsers);
+	State->API->SearchUsers(1, 20, TEXT("an"), State->OnUsers);
+	State->API->SearchUsers(1, 20, TEXT("ann"), State->OnUsers);
+	TestEqual("Nothing should be sent before the debounce interval", State->Transport->Num(), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the debounced search"), [State]()
+	{
+		return State->Transport->Num() > 0;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		TestEqual("A burst of searches should send one request", State->Transport->Num(), 1);
+		TestTrue("The request should be for the last search", State->Transport->GetRequest(0).Request->GetURL().Contains(TEXT("search=ann")));
+
+		// The response arrives and is being parsed when the user types on
+		State->Transport->Respond(0, 200, TEXT("{\"data\":[{\"id\":\"stale\"}]}"));
+		State->API->SearchUsers(1, 20, TEXT("anna"), State->OnUsers);
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the superseding search"), [State]()
+	{
+		return State->Transport->Num() > 1;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		TestEqual("The superseded results should be dropped", State->Receiver->NumCalls, 0);
+
+		// A search in flight is cancelled by the next one
+		State->API->SearchUsers(1, 20, TEXT("annab"), State->OnUsers);
+		TestTrue("The superseded request should be cancelled", State->Transport->GetRequest(1).bCancelled);
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the last search"), [State]()
+	{
+		return State->Transport->Num() > 2;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([State]()
+	{
+		State->Transport->Respond(2, 200, TEXT("{\"data\":[{\"id\":\"fresh\"}]}"));
+
+		// A cancelled search never goes out
+		State->API->SearchClients(1, 20, TEXT("smith"), State->OnClients);
+		State->API->CancelPendingSearches();
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the results of the last search"), [State]()
+	{
+		return State->Receiver->NumCalls > 0;
+	}));
+
+	// Leave the dropped parse and the cancelled search time to (wrongly) show up
+	ADD_LATENT_AUTOMATION_COMMAND(FDelayedFunctionLatentCommand([this, State]()
+	{
+		TestEqual("Only the last search should call back", State->Receiver->NumCalls, 1);
+		TestTrue("The results should be those of the last search", State->Receiver->bLastSucceeded && State->Receiver->LastIds == TArray<FString>({ TEXT("fresh") }));
+		TestEqual("A cancelled search should not be sent", State->Transport->Num(), 3);
+	}, 0.5f));
+
+	return true;
+}
+
+/**
+ * Test suite for the connection warm-up of UCarespaceAPI.
+ * Verifies that nothing is sent unless the caller opts in, and that the probe carries no credentials and
+ * waits its turn behind real requests.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceAPIWarmUpTest, "CarespaceSDK.API.WarmUp",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceAPIWarmUpTest::RunTest(const FString& Parameters)
+{
+	UCarespaceAPI* API = NewObject<UCarespaceAPI>();
+	API->Initialize(TEXT("https://api-test.carespace.ai"), TEXT("test-api-key"));
+	UCarespaceHTTPClient* HTTPClient = API->GetHTTPClient();
+	TestEqual("Initialize should not open a connection unless asked to", HTTPClient->GetStats().RequestsSent, 0);
+	TestEqual("Initialize should not queue a connection probe", HTTPClient->GetActiveRequestCount(), 0);
+
+	TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+	HTTPClient->SetTransport(Transport);
+	API->SetBaseURL(TEXT("https://api-staging.carespace.ai"));
+	TestEqual("Changing the base URL should not open a connection unless asked to", Transport->Num(), 0);
+
+	// The probe yields the only slot to a real request
+	HTTPClient->SetMaxConcurrentRequests(1);
+	HTTPClient->SendRequestRaw(TEXT("GET"), TEXT("/users/busy"), TMap<FString, FString>(), FString(), FCarespaceRequestOptions(), FOnHTTPResponseBytes());
+	HTTPClient->WarmUpConnection();
+	HTTPClient->SendRequestRaw(TEXT("GET"), TEXT("/users/me"), TMap<FString, FString>(), FString(), FCarespaceRequestOptions(), FOnHTTPResponseBytes());
+	Transport->Respond(0, 200, TEXT("{}"));
+	TestTrue("The real request should go before the probe", Transport->GetRequest(1).Request->GetURL().EndsWith(TEXT("/users/me")));
+	Transport->Respond(1, 200, TEXT("{}"));
+
+	if (TestEqual("The probe should be sent once the real requests are done", Transport->Num(), 3))
+	{
+		TSharedRef<IHttpRequest> Probe = Transport->GetRequest(2).Request;
+		TestEqual("The probe should be a HEAD", Probe->GetVerb(), TEXT("HEAD"));
+		TestEqual("The probe should not carry the API key", Probe->GetHeader(TEXT("Authorization")), FString());
+		TestEqual("Real requests should carry the API key", Transport->GetRequest(1).Request->GetHeader(TEXT("Authorization")), TEXT("Bearer test-api-key"));
+
+		// Any status code means the connection is open
+		Transport->Respond(2, 404, FString());
+		TestTrue("The warm-up time should be reported", HTTPClient->GetStats().WarmUpSeconds > 0.0f);
+	}
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for cancelling UCarespaceAPI calls whose response is being parsed off the game thread.
+ * Verifies that the caller stays pending until its results are delivered, and that cancelling it by
+ * handle or by owner in the meantime drops the results.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceAPIDeferredCompletionTest, "CarespaceSDK.API.DeferredCompletion",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceAPIDeferredCompletionTest::RunTest(const FString& Parameters)
+{
+	struct FState
+	{
+		TStrongObjectPtr<UCarespaceAPI> API;
+		TStrongObjectPtr<UCarespaceTestDelegateReceiver> Receiver;
+		TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+	};
+	TSharedRef<FState> State = MakeShared<FState>();
+	State->API.Reset(NewObject<UCarespaceAPI>());
+	State->API->Initialize(TEXT("https://api-test.carespace.ai"), TEXT("test-api-key"));
+	State->API->GetHTTPClient()->SetTransport(State->Transport);
+	State->Receiver.Reset(NewObject<UCarespaceTestDelegateReceiver>());
+	UCarespaceHTTPClient* HTTPClient = State->API->GetHTTPClient();
+
+	FOnCarespaceUsersReceived OnUsers;
+	OnUsers.BindDynamic(State->Receiver.Get(), &UCarespaceTestDelegateReceiver::OnUsersReceived);
+	FOnCarespaceClientsReceived OnClients;
+	OnClients.BindDynamic(State->Receiver.Get(), &UCarespaceTestDelegateReceiver::OnClientsReceived);
+	FOnCarespaceProgramsReceived OnPrograms;
+	OnPrograms.BindDynamic(State->Receiver.Get(), &UCarespaceTestDelegateReceiver::OnProgramsReceived);
+
+	// Cancelled by its handle while the response is parsed
+	const FCarespaceRequestHandle UsersHandle = State->API->GetUsers(1, 20, FString(), OnUsers);
+	State->Transport->Respond(0, 200, TEXT("{\"data\":[{\"id\":\"u1\"}]}"));
+	TestTrue("A call should stay pending while its response is parsed", HTTPClient->IsRequestPending(UsersHandle));
+	TestTrue("A call should be cancellable while its response is parsed", UsersHandle.Cancel());
+
+	// Cancelled by its owner while the response is parsed
+	State->API->GetClients(1, 20, FString(), OnClients);
+	State->Transport->Respond(1, 200, TEXT("{\"data\":[{\"id\":\"c1\"}]}"));
+	TestEqual("The owner's call being parsed should be cancelled", HTTPClient->CancelAllRequestsForOwner(State->Receiver.Get()), 1);
+
+	// Left alone, so its results arrive
+	const FCarespaceRequestHandle ProgramsHandle = State->API->GetPrograms(1, 20, FString(), OnPrograms);
+	State->Transport->Respond(2, 200, TEXT("{\"data\":[{\"id\":\"p1\"}]}"));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the results of the call left alone"), [State]()
+	{
+		return State->Receiver->NumCalls > 0;
+	}));
+
+	// Leave the cancelled calls' parses time to finish, so that a late callback would be seen
+	ADD_LATENT_AUTOMATION_COMMAND(FDelayedFunctionLatentCommand([this, State, HTTPClient, ProgramsHandle]()
+	{
+		TestEqual("Only the call left alone should call back", State->Receiver->NumCalls, 1);
+		TestTrue("The results should be those of the call left alone", State->Receiver->LastIds == TArray<FString>{ TEXT("p1") });
+		TestFalse("A delivered call should no longer be pending", HTTPClient->IsRequestPending(ProgramsHandle));
+	}, 0.5f));
+
+	return true;
+}
@@ -0,0 +1,1888 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "CarespaceHTTPClient.h"
+#include "CarespaceCircuitBreaker.h"
+#include "CarespaceCompletionDispatcher.h"
+#include "CarespaceDiskCache.h"
+#include "CarespaceJsonDocument.h"
+#include "CarespaceJsonIndex.h"
+#include "CarespaceJsonSchema.h"
+#include "CarespaceJsonStream.h"
+#include "CarespaceLatencyTracker.h"
+#include "CarespacePreparedEndpoint.h"
+#include "CarespaceRateLimiter.h"
+#include "CarespaceResponseCache.h"
+#include "CarespaceStructPlan.h"
+#include "CarespaceTestHelpers.h"
+#include "CarespaceTestLatentCommands.h"
+#include "CarespaceTestTransport.h"
+#include "CarespaceTimestamp.h"
+#include "JsonObjectConverter.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCarespaceHTTPClientTests, Log, All);
+
+/**
+ * Test suite for the client-side rate limiter.
+ * Verifies endpoint classification, pacing, and learning from X-RateLimit-* headers.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceRateLimiterTest, "CarespaceSDK.HTTPClient.RateLimiter",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceRateLimiterTest::RunTest(const FString& Parameters)
+{
+	// Endpoint classification
+	TestEqual("Auth endpoints should use the auth bucket", FCarespaceRateLimiter::GetEndpointClass(TEXT("/auth/login")), TEXT("auth"));
+	TestEqual("Bulk endpoints should use the bulk bucket", FCarespaceRateLimiter::GetEndpointClass(TEXT("/clients/bulk")), TEXT("bulk"));
+	TestEqual("Other endpoints should use the standard bucket", FCarespaceRateLimiter::GetEndpointClass(TEXT("/programs/123")), TEXT("standard"));
+
+	FCarespaceRateLimiter RateLimiter;
+	const double Start = 1000.0;
+
+	// The documented auth budget is 5 requests per minute
+	for (int32 Index = 0; Index < 5; ++Index)
+	{
+		TestEqual("Requests within the auth budget should not wait", RateLimiter.GetWaitTime(TEXT("auth"), Start), 0.0);
+		RateLimiter.ConsumeToken(TEXT("auth"), Start);
+	}
+	TestTrue("The sixth auth request should be paced", RateLimiter.GetWaitTime(TEXT("auth"), Start) > 0.0);
+	TestEqual("A token should be available again after one refill interval", RateLimiter.GetWaitTime(TEXT("auth"), Start + 12.5), 0.0);
+
+	// The server reports that the standard budget is exhausted until the window resets
+	RateLimiter.UpdateFromHeaders(TEXT("standard"), 1000, 0, 30, Start);
+	const double Wait = RateLimiter.GetWaitTime(TEXT("standard"), Start);
+	TestTrue("An exhausted bucket should wait for the reset", FMath::IsNearlyEqual(Wait, 30.0, 0.01));
+	TestEqual("The full budget should be restored after the reset", RateLimiter.GetWaitTime(TEXT("standard"), Start + 31.0), 0.0);
+
+	// A 429 blocks the bucket for the Retry-After duration
+	RateLimiter.HandleRateLimited(TEXT("bulk"), 5.0, Start);
+	TestTrue("A rate limited bucket should honor Retry-After", FMath::IsNearlyEqual(RateLimiter.GetWaitTime(TEXT("bulk"), Start), 5.0, 0.01));
+
+	const TArray<FCarespaceRateLimitState> States = RateLimiter.GetStates(Start + 31.0);
+	const FCarespaceRateLimitState* StandardState = States.FindByPredicate([](const FCarespaceRateLimitState& State)
+	{
+		return State.EndpointClass == TEXT("standard");
+	});
+
+	TestNotNull("The standard bucket should be reported", StandardState);
+	if (StandardState)
+	{
+		TestTrue("The standard bucket should be marked as learned", StandardState->bLearnedFromServer);
+		TestEqual("The standard bucket limit should come from the headers", StandardState->Limit, 1000);
+	}
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for the default retry policies and their configuration.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceRetryPolicyTest, "CarespaceSDK.HTTPClient.RetryPolicy",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceRetryPolicyTest::RunTest(const FString& Parameters)
+{
+	UCarespaceHTTPClient* HTTPClient = NewObject<UCarespaceHTTPClient>();
+	TestNotNull("HTTP client should be created", HTTPClient);
+
+	if (!HTTPClient)
+	{
+		return false;
+	}
+
+	const FCarespaceRetryPolicy GetPolicy = HTTPClient->GetRetryPolicy(TEXT("GET"));
+	TestTrue("GET should retry network errors", GetPolicy.bRetryOnNetworkError);
+	TestTrue("GET should retry server errors", GetPolicy.bRetryOnServerError);
+
+	const FCarespaceRetryPolicy PostPolicy = HTTPClient->GetRetryPolicy(TEXT("post"));
+	TestFalse("POST should not retry network errors", PostPolicy.bRetryOnNetworkError);
+	TestFalse("POST should not retry server errors", PostPolicy.bRetryOnServerError);
+	TestTrue("POST should retry rate limited requests", PostPolicy.bRetryOnRateLimited);
+
+	HTTPClient->SetMaxRetries(5);
+	HTTPClient->SetRetryDelay(2.0f);
+	TestEqual("SetMaxRetries should apply to every verb", HTTPClient->GetRetryPolicy(TEXT("DELETE")).MaxRetries, 5);
+	TestEqual("SetRetryDelay should apply to every verb", HTTPClient->GetRetryPolicy(TEXT("PUT")).BaseDelaySeconds, 2.0f);
+
+	// Decorrelated jitter stays between the base delay and three times the previous delay, below the cap
+	FCarespaceRetryPolicy Policy;
+	Policy.BaseDelaySeconds = 0.5f;
+	Policy.MaxDelaySeconds = 20.0f;
+
+	double PreviousDelay = 0.0;
+	bool bReachedCap = false;
+	for (int32 Attempt = 0; Attempt < 200; ++Attempt)
+	{
+		const double Delay = Policy.GetNextDelay(PreviousDelay);
+		const double UpperBound = FMath::Min(20.0, FMath::Max(0.5, PreviousDelay) * 3.0);
+		if (Delay < 0.5 - KINDA_SMALL_NUMBER || Delay > UpperBound + KINDA_SMALL_NUMBER)
+		{
+			AddError(FString::Printf(TEXT("Delay %.3f after %.3f is outside [0.5, %.3f]"), Delay, PreviousDelay, UpperBound));
+			break;
+		}
+		bReachedCap |= Delay >= 20.0 - KINDA_SMALL_NUMBER;
+		PreviousDelay = Delay;
+	}
+	TestTrue("Growing delays should eventually be capped", bReachedCap);
+	TestTrue("The first delay should be at most three times the base delay", Policy.GetNextDelay(0.0) <= 1.5 + KINDA_SMALL_NUMBER);
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for the global retry budget.
+ * Verifies that retries stop once the budget is spent and that only successful first attempts refill it.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceRetryBudgetTest, "CarespaceSDK.HTTPClient.RetryBudget",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceRetryBudgetTest::RunTest(const FString& Parameters)
+{
+	UCarespaceHTTPClient* HTTPClient = NewObject<UCarespaceHTTPClient>();
+	TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+	HTTPClient->SetTransport(Transport);
+	HTTPClient->SetRetryBudget(0.5f, 2.0f);
+
+	// Keep failures from opening the circuit, and scheduled retries from firing while the test runs
+	FCarespaceCircuitBreakerSettings CircuitSettings;
+	CircuitSettings.bEnabled = false;
+	HTTPClient->SetCircuitBreakerSettings(CircuitSettings);
+
+	FCarespaceRetryPolicy Policy;
+	Policy.BaseDelaySeconds = 60.0f;
+	Policy.MaxDelaySeconds = 120.0f;
+	HTTPClient->SetRetryPolicy(TEXT("GET"), Policy);
+
+	int32 NumFailed = 0;
+	const FOnHTTPResponseBytes OnComplete = FOnHTTPResponseBytes::CreateLambda([&NumFailed](bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error)
+	{
+		NumFailed += bWasSuccessful ? 0 : 1;
+	});
+
+	int32 NextEndpoint = 0;
+	auto SendAndGetIndex = [HTTPClient, &Transport, &NextEndpoint, &OnComplete]()
+	{
+		HTTPClient->SendRequestRaw(TEXT("GET"), FString::Printf(TEXT("/users/%d"), NextEndpoint++), TMap<FString, FString>(), FString(), FCarespaceRequestOptions(), OnComplete);
+		return Transport->Num() - 1;
+	};
+
+	// Two tokens pay for two retries; the third retryable failure is reported right away
+	Transport->Fail(SendAndGetIndex());
+	Transport->Fail(SendAndGetIndex());
+	TestEqual("Retries should be scheduled while tokens remain", HTTPClient->GetStats().RetriesAttempted, 2);
+	TestEqual("Callers of retried requests should still be waiting", NumFailed, 0);
+
+	Transport->Fail(SendAndGetIndex());
+	TestEqual("A failure with an empty budget should not be retried", HTTPClient->GetStats().RetriesDroppedByBudget, 1);
+	TestEqual("A failure with an empty budget should reach the caller", NumFailed, 1);
+
+	// Non-retryable failures complete without retrying but must not refill the budget
+	Transport->Respond(SendAndGetIndex(), 404, TEXT("{}"));
+	Transport->Respond(SendAndGetIndex(), 400, TEXT("{}"));
+	Transport->Fail(SendAndGetIndex());
+	TestEqual("Client errors should not earn retry tokens", HTTPClient->GetStats().RetriesDroppedByBudget, 2);
+	TestEqual("No retry should have been sent", HTTPClient->GetStats().RetriesAttempted, 2);
+
+	// Two first-attempt successes at 0.5 tokens each pay for one more retry
+	Transport->Respond(SendAndGetIndex(), 200, TEXT("{}"));
+	Transport->Respond(SendAndGetIndex(), 200, TEXT("{}"));
+	Transport->Respond(SendAndGetIndex(), 503, TEXT("{}"));
+	TestEqual("Successes should refill the budget", HTTPClient->GetStats().RetriesAttempted, 3);
+	TestEqual("The refilled budget should not drop the retry", HTTPClient->GetStats().RetriesDroppedByBudget, 2);
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for the in-memory response cache and its LRU byte budget.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceResponseCacheTest, "CarespaceSDK.HTTPClient.ResponseCache",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceResponseCacheTest::RunTest(const FString& Parameters)
+{
+	auto MakeEntry = [](const FString& ETag, int32 BodySize)
+	{
+		TSharedRef<FCarespaceCachedResponse> Entry = MakeShared<FCarespaceCachedResponse>();
+		Entry->ETag = ETag;
+		Entry->Body.SetNumZeroed(BodySize);
+		return Entry;
+	};
+
+	// Room for two 1 KB bodies plus bookkeeping, but not three
+	FCarespaceResponseCache Cache(2 * 1024 + 512);
+
+	Cache.Store(TEXT("users"), MakeEntry(TEXT("\"u1\""), 1024));
+	Cache.Store(TEXT("clients"), MakeEntry(TEXT("\"c1\""), 1024));
+	TestEqual("Both entries should fit in the budget", Cache.Num(), 2);
+
+	// Touch users so that clients becomes the least recently used entry
+	TSharedPtr<const FCarespaceCachedResponse> Users = Cache.Find(TEXT("users"));
+	TestTrue("Stored entry should be found", Users.IsValid());
+	if (Users.IsValid())
+	{
+		TestEqual("ETag should be preserved", Users->ETag, TEXT("\"u1\""));
+	}
+
+	Cache.Store(TEXT("programs"), MakeEntry(TEXT("\"p1\""), 1024));
+	TestTrue("Recently used entry should survive eviction", Cache.Find(TEXT("users")).IsValid());
+	TestFalse("Least recently used entry should be evicted", Cache.Find(TEXT("clients")).IsValid());
+	TestTrue("Cache should stay within its budget", Cache.GetTotalBytes() <= Cache.GetMaxBytes());
+
+	// An entry larger than the whole budget is never stored
+	Cache.Store(TEXT("huge"), MakeEntry(TEXT("\"h1\""), 16 * 1024));
+	TestFalse("Oversized entry should not be stored", Cache.Find(TEXT("huge")).IsValid());
+
+	Cache.Empty();
+	TestEqual("Empty should drop every entry", Cache.Num(), 0);
+	TestEqual("Empty should release every byte", Cache.GetTotalBytes(), (int64)0);
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for parsing UTF-8 response bodies without an intermediate FString.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceJsonBytesTest, "CarespaceSDK.HTTPClient.JsonBytes",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceJsonBytesTest::RunTest(const FString& Parameters)
+{
+	FCarespaceUser User;
+	const bool bParsed = UCarespaceHTTPClient::JsonBytesToStruct(UCarespaceTestHelpers::ToUtf8Bytes(TEXT("{\"id\":\"u1\",\"name\":\"Zoë Müller\",\"email\":\"zoe@example.com\"}")), FCarespaceUser::StaticStruct(), &User);
+	TestTrue("A UTF-8 object should parse", bParsed);
+	TestEqual("Fields should be matched case-insensitively", User.Id, TEXT("u1"));
+	TestEqual("Multi-byte characters should survive decoding", User.Name, TEXT("Zoë Müller"));
+
+	TestFalse("A JSON array is not an object", UCarespaceHTTPClient::JsonBytesToObject(UCarespaceTestHelpers::ToUtf8Bytes(TEXT("[1,2]"))).IsValid());
+	TestFalse("An empty body is not an object", UCarespaceHTTPClient::JsonBytesToObject(TArray<uint8>()).IsValid());
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for prepared endpoints and their path templates.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespacePreparedEndpointTest, "CarespaceSDK.HTTPClient.PreparedEndpoint",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespacePreparedEndpointTest::RunTest(const FString& Parameters)
+{
+	const FCarespacePreparedEndpoint Endpoint(TEXT("get"), TEXT("/clients/{clientId}/programs/{programId}"));
+	TestEqual("The verb should be normalized", Endpoint.GetVerb(), TEXT("GET"));
+	TestEqual("Both placeholders should be found", Endpoint.GetNumArguments(), 2);
+
+	TStringBuilder<128> Path;
+	TestTrue("Matching arguments should be accepted", Endpoint.AppendPath(Path, { FStringView(TEXT("c 1")), FStringView(TEXT("p/2")) }));
+	TestEqual("Arguments should be URL-encoded into the template", FString(Path.ToView()), TEXT("/clients/c%201/programs/p%2F2"));
+
+	TStringBuilder<128> Rejected;
+	TestFalse("A missing argument should be rejected", Endpoint.AppendPath(Rejected, { FStringView(TEXT("c1")) }));
+
+	const FCarespacePreparedEndpoint Login(TEXT("POST"), TEXT("/auth/login"));
+	TestEqual("Auth endpoints should default to the Auth lane", Login.GetOptions().Priority, ECarespaceRequestPriority::Auth);
+	TestEqual("A template without placeholders takes no arguments", Login.GetNumArguments(), 0);
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for prepared requests whose path arguments do not match the template.
+ * Verifies that nothing is sent and that the error is reported through the completion dispatcher, never
+ * inside the send call.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespacePreparedArgumentsTest, "CarespaceSDK.HTTPClient.PreparedArguments",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespacePreparedArgumentsTest::RunTest(const FString& Parameters)
+{
+	struct FState
+	{
+		TStrongObjectPtr<UCarespaceHTTPClient> Client;
+		TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+		int32 NumResponses = 0;
+		FCarespaceError LastError;
+	};
+	TSharedRef<FState> State = MakeShared<FState>();
+	State->Client.Reset(NewObject<UCarespaceHTTPClient>());
+	State->Client->SetTransport(State->Transport);
+
+	AddExpectedError(TEXT("expects 2 arguments"), EAutomationExpectedErrorFlags::Contains, 2);
+
+	const FCarespacePreparedEndpoint Endpoint(TEXT("GET"), TEXT("/clients/{clientId}/programs/{programId}"));
+	const FOnHTTPResponseBytes OnComplete = FOnHTTPResponseBytes::CreateLambda([State](bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error)
+	{
+		++State->NumResponses;
+		State->LastError = Error;
+	});
+
+	const FStringView ClientId(TEXT("c1"));
+	const FCarespaceRequestHandle Handle = State->Client->SendPrepared(Endpoint, MakeArrayView(&ClientId, 1), TMap<FString, FString>(), TArray<uint8>(), OnComplete);
+	State->Client->SendPreparedDeferred(Endpoint, MakeArrayView(&ClientId, 1), TMap<FString, FString>(), []() { return TArray<uint8>(); }, OnComplete);
+	TestEqual("The error should not be reported inside the send call", State->NumResponses, 0);
+	TestTrue("The handle should be pending until the error is reported", State->Client->IsRequestPending(Handle));
+	TestEqual("Nothing should be sent", State->Transport->Num(), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("both errors"), [State]()
+	{
+		return State->NumResponses == 2;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, Handle]()
+	{
+		TestEqual("The error should be a validation error", State->LastError.ErrorType, ECarespaceErrorType::ValidationError);
+		TestFalse("The handle should no longer be pending", State->Client->IsRequestPending(Handle));
+		TestEqual("Nothing should have been sent", State->Transport->Num(), 0);
+		return true;
+	}));
+
+	return true;
+}
+
+/**
+ * Test suite for the latency percentiles that trigger hedged requests.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceLatencyTrackerTest, "CarespaceSDK.HTTPClient.LatencyTracker",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceLatencyTrackerTest::RunTest(const FString& Parameters)
+{
+	TestEqual("Item paths should share their collection's family", FCarespaceLatencyTracker::GetEndpointFamily(TEXT("/programs/123")), TEXT("/programs"));
+	TestEqual("Query strings should not split families", FCarespaceLatencyTracker::GetEndpointFamily(TEXT("/users?page=2")), TEXT("/users"));
+
+	FCarespaceLatencyTracker Tracker(10);
+	double Seconds = 0.0;
+	TestFalse("No estimate should be given without samples", Tracker.GetPercentile(TEXT("/users"), 0.95f, 1, Seconds));
+
+	for (int32 Index = 1; Index <= 10; ++Index)
+	{
+		Tracker.AddSample(TEXT("/users"), Index * 0.1);
+	}
+	TestFalse("No estimate should be given below the minimum sample count", Tracker.GetPercentile(TEXT("/users"), 0.95f, 20, Seconds));
+	TestTrue("An estimate should be given once enough samples exist", Tracker.GetPercentile(TEXT("/users"), 0.9f, 10, Seconds));
+	TestEqual("The 90th percentile of 0.1..1.0 should be 0.9", Seconds, 0.9, 0.001);
+
+	// A full window drops its oldest samples
+	for (int32 Index = 0; Index < 10; ++Index)
+	{
+		Tracker.AddSample(TEXT("/users"), 0.05);
+	}
+	Tracker.GetPercentile(TEXT("/users"), 1.0f, 10, Seconds);
+	TestEqual("Old samples should have been replaced", Seconds, 0.05, 0.001);
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for hedged GET requests.
+ * Verifies that a request slower than its endpoint family's latency percentile is hedged, that the first
+ * response wins and the other request is cancelled, and that no hedge is sent once the hedge budget is spent,
+ * while a circuit is not closed or while the rate limiter makes requests wait.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceHedgingTest, "CarespaceSDK.HTTPClient.Hedging",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceHedgingTest::RunTest(const FString& Parameters)
+{
+	struct FScenario
+	{
+		TStrongObjectPtr<UCarespaceHTTPClient> Client;
+		TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+		TArray<FString> Bodies;
+
+		void Send(const TCHAR* Endpoint)
+		{
+			Client->SendRequestRaw(TEXT("GET"), Endpoint, TMap<FString, FString>(), FString(), FCarespaceRequestOptions(),
+				FOnHTTPResponseBytes::CreateLambda([this](bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error)
+				{
+					Bodies.Add(FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num())));
+				}));
+		}
+	};
+
+	struct FState
+	{
+		FScenario Won;
+		FScenario Budget;
+		FScenario Circuit;
+		FScenario RateLimited;
+	};
+	TSharedRef<FState> State = MakeShared<FState>();
+
+	// One fast response is enough history; anything slower than 0.1s is then hedged
+	FCarespaceHedgingPolicy Policy;
+	Policy.bEnabled = true;
+	Policy.MinSamples = 1;
+	Policy.MinDelaySeconds = 0.1f;
+
+	for (FScenario* Scenario : { &State->Won, &State->Budget, &State->Circuit, &State->RateLimited })
+	{
+		Scenario->Client.Reset(NewObject<UCarespaceHTTPClient>());
+		Scenario->Client->SetTransport(Scenario->Transport);
+		Scenario->Client->SetMaxRetries(0);
+		Scenario->Client->SetHedgingPolicy(Policy);
+		Scenario->Send(TEXT("/programs/warm"));
+		Scenario->Transport->Respond(0, 200, TEXT("{}"));
+	}
+
+	// Only one hedge is in the budget, and the pair of slow requests earns no more
+	FCarespaceHedgingPolicy SingleHedgePolicy = Policy;
+	SingleHedgePolicy.MaxBudgetTokens = 1.0f;
+	SingleHedgePolicy.BudgetRatio = 0.0f;
+	State->Budget.Client->SetHedgingPolicy(SingleHedgePolicy);
+
+	FCarespaceCircuitBreakerSettings CircuitSettings;
+	CircuitSettings.FailureThreshold = 1;
+	State->Circuit.Client->SetCircuitBreakerSettings(CircuitSettings);
+
+	State->Won.Send(TEXT("/programs/slow"));
+	State->Budget.Send(TEXT("/programs/slow-1"));
+	State->Budget.Send(TEXT("/programs/slow-2"));
+
+	// A failure on the same host opens the circuit while the slow request is in flight
+	State->Circuit.Send(TEXT("/programs/slow"));
+	State->Circuit.Send(TEXT("/programs/broken"));
+	State->Circuit.Transport->Respond(2, 500, TEXT("{}"));
+
+	// The server reports the window as used up while the slow request is in flight
+	State->RateLimited.Send(TEXT("/programs/slow"));
+	State->RateLimited.Send(TEXT("/programs/last"));
+	TMap<FString, FString> RateLimitHeaders;
+	RateLimitHeaders.Add(TEXT("X-RateLimit-Limit"), TEXT("100"));
+	RateLimitHeaders.Add(TEXT("X-RateLimit-Remaining"), TEXT("0"));
+	RateLimitHeaders.Add(TEXT("X-RateLimit-Reset"), TEXT("60"));
+	State->RateLimited.Transport->Respond(2, 200, TEXT("{}"), RateLimitHeaders);
+
+	TestEqual("Nothing should be hedged before the percentile threshold", State->Won.Transport->Num(), 2);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the hedge"), [State]()
+	{
+		return State->Won.Transport->Num() > 2;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		const FCarespaceTestTransport& Transport = *State->Won.Transport;
+		TestEqual("One hedge should be sent", State->Won.Client->GetStats().HedgesSent, 1);
+		TestEqual("The hedge should repeat the slow request", Transport.GetRequest(2).Request->GetURL(), Transport.GetRequest(1).Request->GetURL());
+
+		State->Won.Transport->Respond(2, 200, TEXT("{\"from\":\"hedge\"}"));
+		TestTrue("The first response should win", State->Won.Bodies.Num() == 2 && State->Won.Bodies[1] == TEXT("{\"from\":\"hedge\"}"));
+		TestTrue("The losing request should be cancelled", Transport.GetRequest(1).bCancelled);
+		TestEqual("The hedge should be counted as won", State->Won.Client->GetStats().HedgesWon, 1);
+		return true;
+	}));
+
+	// Leave every other hedge timer time to fire
+	ADD_LATENT_AUTOMATION_COMMAND(FDelayedFunctionLatentCommand([this, State]()
+	{
+		TestEqual("Only one of the slow pair should be hedged", State->Budget.Client->GetStats().HedgesSent, 1);
+		TestEqual("The other hedge should be dropped by the budget", State->Budget.Client->GetStats().HedgesDroppedByBudget, 1);
+		TestEqual("The second hedge should not be sent", State->Budget.Transport->Num(), 4);
+
+		TestEqual("Nothing should be hedged while the circuit is open", State->Circuit.Client->GetStats().HedgesSent, 0);
+		TestEqual("The slow request should be alone while the circuit is open", State->Circuit.Transport->GetNumPending(), 1);
+
+		TestEqual("Nothing should be hedged while the rate limiter waits", State->RateLimited.Client->GetStats().HedgesSent, 0);
+		TestEqual("The slow request should be alone while the rate limiter waits", State->RateLimited.Transport->GetNumPending(), 1);
+	}, 0.5f));
+
+	return true;
+}
+
+/**
+ * Test suite for the circuit breaker state machine.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceCircuitBreakerTest, "CarespaceSDK.HTTPClient.CircuitBreaker",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceCircuitBreakerTest::RunTest(const FString& Parameters)
+{
+	FCarespaceCircuitBreakerSettings Settings;
+	Settings.FailureThreshold = 3;
+	Settings.OpenSeconds = 10.0f;
+	Settings.MaxOpenSeconds = 60.0f;
+
+	FCarespaceCircuitBreaker Breaker;
+	Breaker.SetSettings(Settings);
+
+	const FString Key = TEXT("api.carespace.ai/users");
+	bool bIsProbe = false;
+
+	for (int32 Index = 0; Index < 3; ++Index)
+	{
+		TestTrue("A closed circuit should admit requests", Breaker.TryAdmit(Key, 0.0, bIsProbe));
+		TestFalse("Requests through a closed circuit are not probes", bIsProbe);
+		Breaker.RecordFailure(Key, 0.0, bIsProbe);
+	}
+	TestEqual("The circuit should open at the failure threshold", Breaker.GetState(Key), ECarespaceCircuitState::Open);
+	TestTrue("An open circuit should reject requests", Breaker.IsRejecting(Key, 5.0));
+	TestFalse("An open circuit should not admit requests", Breaker.TryAdmit(Key, 5.0, bIsProbe));
+
+	TestTrue("A probe should be admitted after the cool-down", Breaker.TryAdmit(Key, 10.0, bIsProbe));
+	TestTrue("The admitted request should be a probe", bIsProbe);
+	TestEqual("The circuit should be half-open while probing", Breaker.GetState(Key), ECarespaceCircuitState::HalfOpen);
+	bool bSecondIsProbe = false;
+	TestFalse("Only one probe should be in flight", Breaker.TryAdmit(Key, 10.0, bSecondIsProbe));
+
+	Breaker.RecordFailure(Key, 10.0, true);
+	TestEqual("A failed probe should reopen the circuit", Breaker.GetState(Key), ECarespaceCircuitState::Open);
+	TestTrue("The circuit should stay open twice as long", Breaker.IsRejecting(Key, 29.0));
+
+	TestTrue("A probe should be admitted after the longer cool-down", Breaker.TryAdmit(Key, 30.0, bIsProbe));
+	Breaker.RecordFailure(Key, 30.0, false);
+	TestEqual("A late failure of a request sent before the circuit opened should not reopen it", Breaker.GetState(Key), ECarespaceCircuitState::HalfOpen);
+	Breaker.RecordSuccess(Key, 30.0, bIsProbe);
+	TestEqual("A successful probe should close the circuit", Breaker.GetState(Key), ECarespaceCircuitState::Closed);
+	TestFalse("Other keys should be unaffected", Breaker.IsRejecting(TEXT("api.carespace.ai/programs"), 30.0));
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for the circuit breaker of the HTTP client.
+ * Verifies that once a circuit opens, requests to it fail fast with CircuitOpenError, reported through the
+ * completion dispatcher, without reaching the transport.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceCircuitOpenTest, "CarespaceSDK.HTTPClient.CircuitOpen",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceCircuitOpenTest::RunTest(const FString& Parameters)
+{
+	struct FState
+	{
+		TStrongObjectPtr<UCarespaceHTTPClient> Client;
+		TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+		int32 NumResponses = 0;
+		FCarespaceError LastError;
+	};
+	TSharedRef<FState> State = MakeShared<FState>();
+	State->Client.Reset(NewObject<UCarespaceHTTPClient>());
+	State->Client->SetTransport(State->Transport);
+	State->Client->SetMaxRetries(0);
+
+	FCarespaceCircuitBreakerSettings CircuitSettings;
+	CircuitSettings.FailureThreshold = 2;
+	State->Client->SetCircuitBreakerSettings(CircuitSettings);
+
+	auto Send = [State](const TCHAR* Endpoint)
+	{
+		State->Client->SendRequestRaw(TEXT("GET"), Endpoint, TMap<FString, FString>(), FString(), FCarespaceRequestOptions(),
+			FOnHTTPResponseBytes::CreateLambda([State](bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error)
+			{
+				++State->NumResponses;
+				State->LastError = Error;
+			}));
+	};
+
+	Send(TEXT("/users/1"));
+	Send(TEXT("/users/2"));
+	State->Transport->Respond(0, 500, TEXT("{}"));
+	State->Transport->Respond(1, 500, TEXT("{}"));
+	TestEqual("Both failures should be reported", State->NumResponses, 2);
+
+	Send(TEXT("/users/3"));
+	TestEqual("An open circuit should send nothing", State->Transport->Num(), 2);
+	TestEqual("The rejection should not be reported inside the send call", State->NumResponses, 2);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the rejection"), [State]()
+	{
+		return State->NumResponses > 2;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		TestEqual("The rejection should be a circuit-open error", State->LastError.ErrorType, ECarespaceErrorType::CircuitOpenError);
+		TestEqual("The rejection should be counted", State->Client->GetStats().RequestsRejectedByCircuit, 1);
+		TestEqual("Nothing should have been sent", State->Transport->Num(), 2);
+		return true;
+	}));
+
+	return true;
+}
+
+/**
+ * Test suite for the frame-budgeted completion dispatcher.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceCompletionDispatcherTest, "CarespaceSDK.HTTPClient.CompletionDispatcher",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceCompletionDispatcherTest::RunTest(const FString& Parameters)
+{
+	FCarespaceCompletionDispatcher Dispatcher;
+	TArray<FString> Order;
+
+	Dispatcher.Enqueue(ECarespaceRequestPriority::Background, [&Order]() { Order.Add(TEXT("Background")); });
+	Dispatcher.Enqueue(ECarespaceRequestPriority::Interactive, [&Order]() { Order.Add(TEXT("Interactive")); });
+	Dispatcher.Enqueue(ECarespaceRequestPriority::Auth, [&Order]() { Order.Add(TEXT("Auth")); });
+	TestEqual("All completions should be pending", Dispatcher.GetNumPending(), 3);
+
+	TestEqual("An exhausted budget should still run one completion", Dispatcher.Drain(0.0), 1);
+	TestEqual("The most urgent lane should run first", Order[0], TEXT("Auth"));
+	TestEqual("The rest should spill over", Dispatcher.GetNumPending(), 2);
+
+	Dispatcher.Drain(TNumericLimits<double>::Max());
+	TestEqual("Every completion should have run", Order.Num(), 3);
+	TestEqual("Interactive completions should run before background ones", Order[1], TEXT("Interactive"));
+	TestEqual("The queue should be empty", Dispatcher.GetNumPending(), 0);
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for decoding list responses incrementally as their bytes arrive.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceJsonStreamTest, "CarespaceSDK.HTTPClient.JsonStream",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceJsonStreamTest::RunTest(const FString& Parameters)
+{
+	// Brackets, quotes and a nested "data" key inside strings and elements must not confuse the scanner
+	const TArray<uint8> Body = UCarespaceTestHelpers::ToUtf8Bytes(TEXT("{\"meta\":{\"data\":[0]},\"data\":[ {\"id\":\"u1\",\"name\":\"a]\\\"}\"} , {\"id\":\"u2\",\"data\":[1]} ],\"total\":2}"));
+
+	TCarespaceJsonListDecoder<FCarespaceUser> Decoder;
+	int32 FirstElementOffset = INDEX_NONE;
+	for (int32 Index = 0; Index < Body.Num(); ++Index)
+	{
+		Decoder.Feed(TArrayView<const uint8>(&Body[Index], 1));
+		if (FirstElementOffset == INDEX_NONE && Decoder.GetNumElements() == 1)
+		{
+			FirstElementOffset = Index;
+		}
+	}
+
+	TestTrue("The first element should be emitted before the body is complete", FirstElementOffset != INDEX_NONE && FirstElementOffset < Body.Num() - 1);
+	TestTrue("The decoder should have consumed the whole document", Decoder.IsComplete());
+
+	TArray<FCarespaceUser> Users = Decoder.MoveItems();
+	TestEqual("Only the top-level data array should be decoded", Users.Num(), 2);
+	if (Users.Num() == 2)
+	{
+		TestEqual("Escaped characters should stay inside the string", Users[0].Name, TEXT("a]\"}"));
+		TestEqual("The second element should be decoded", Users[1].Id, TEXT("u2"));
+	}
+
+	Decoder.Reset();
+	Decoder.Feed(TArray<uint8>({ 0x1f, 0x8b, 0x08, 0x00 }));
+	TestTrue("A compressed body should be rejected", Decoder.HasFailed());
+	TestFalse("A rejected body is never complete", Decoder.IsComplete());
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for the compile-time JSON field tables.
+ * Verifies that they read and write the same JSON as FJsonObjectConverter.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceJsonSchemaTest, "CarespaceSDK.HTTPClient.JsonSchema",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceJsonSchemaTest::RunTest(const FString& Parameters)
+{
+	FCarespaceProgram Program;
+	Program.Id = TEXT("p1");
+	Program.Name = TEXT("Knee \"rehab\"\n\u00e9");
+	Program.Duration = 42;
+	Program.bIsTemplate = true;
+	Program.CreatedAt = FDateTime(2024, 6, 19, 10, 30, 0);
+	FCarespaceExercise& Exercise = Program.Exercises.AddDefaulted_GetRef();
+	Exercise.VideoURL = TEXT("https://example.com/v.mp4");
+	Exercise.Sets = 3;
+
+	// The field table writes what the reflection-based converter can read back
+	const FString Json = CarespaceJson::ToJsonString(Program);
+	FCarespaceProgram Converted;
+	TestTrue("FJsonObjectConverter should accept the written JSON", FJsonObjectConverter::JsonObjectStringToUStruct(Json, &Converted, 0, 0));
+	TestEqual("Escaped names should survive the converter", Converted.Name, Program.Name);
+	TestEqual("Dates should use the converter's format", Converted.CreatedAt, Program.CreatedAt);
+	TestEqual("Nested arrays should be written", Converted.Exercises.Num(), 1);
+
+	// And reads what the converter writes
+	FString ConverterJson;
+	FJsonObjectConverter::UStructToJsonObjectString(Program, ConverterJson);
+	FTCHARToUTF8 Utf8(*ConverterJson);
+	FCarespaceProgram Decoded;
+	TestTrue("The converter's JSON should decode", CarespaceJson::FromJson(TArrayView<const uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()), Decoded));
+	TestEqual("Strings should round-trip", Decoded.Name, Program.Name);
+	TestEqual("Integers should round-trip", Decoded.Duration, 42);
+	TestTrue("Booleans should round-trip", Decoded.bIsTemplate);
+	TestEqual("Dates should round-trip", Decoded.CreatedAt, Program.CreatedAt);
+	TestTrue("Nested structs should round-trip", Decoded.Exercises.Num() == 1 && Decoded.Exercises[0].VideoURL == Exercise.VideoURL && Decoded.Exercises[0].Sets == 3);
+
+	// Keys are case-insensitive, unknown keys and nulls are ignored, and ISO 8601 dates are accepted
+	const char* ApiJson = "{\"ID\":\"u1\",\"extra\":{\"a\":[1,{\"b\":\"}\"}]},\"email\":null,\"isActive\":false,\"bisactive\":false,\"createdAt\":\"2024-01-02T03:04:05.000Z\"}";
+	FCarespaceUser User;
+	User.Email = TEXT("keep");
+	TestTrue("API JSON should decode", CarespaceJson::FromJson(TArrayView<const uint8>(reinterpret_cast<const uint8*>(ApiJson), FCStringAnsi::Strlen(ApiJson)), User));
+	TestEqual("Keys should match case-insensitively", User.Id, TEXT("u1"));
+	TestEqual("Null should keep the default", User.Email, TEXT("keep"));
+	TestFalse("Booleans should be read by property name", User.bIsActive);
+	TestEqual("ISO 8601 dates should be parsed", User.CreatedAt, FDateTime(2024, 1, 2, 3, 4, 5));
+
+	// A value of the wrong type fails the struct
+	const char* BadJson = "{\"exercises\":\"none\"}";
+	TestFalse("A type mismatch should fail", CarespaceJson::FromJson(TArrayView<const uint8>(reinterpret_cast<const uint8*>(BadJson), FCStringAnsi::Strlen(BadJson)), Program));
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for the cached property plans behind StructToJsonString and JsonStringToStruct.
+ * Verifies caching, condensed output, the converter's contract and the fallback for unsupported types.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceStructPlanTest, "CarespaceSDK.HTTPClient.StructPlan",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceStructPlanTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<const FCarespaceStructPlan> Plan = FCarespaceStructPlan::Get(FCarespaceRequestOptions::StaticStruct());
+	TestTrue("Plans should be cached per struct", Plan == FCarespaceStructPlan::Get(FCarespaceRequestOptions::StaticStruct()));
+	TestFalse("Object references should be left to the converter", Plan->IsSupported());
+	TestTrue("Plain structs should be supported", FCarespaceStructPlan::Get(FCarespaceClient::StaticStruct())->IsSupported());
+
+	FCarespaceClient Client;
+	Client.Id = TEXT("c1");
+	Client.Address.City = TEXT("Zürich");
+	Client.bIsActive = false;
+	Client.DateOfBirth = FDateTime(1990, 5, 17);
+
+	const FString Json = UCarespaceHTTPClient::StructToJsonString(FCarespaceClient::StaticStruct(), &Client);
+	TestFalse("Output should be condensed", Json.Contains(TEXT("\n")));
+	TestTrue("Keys should be written like the converter writes them", Json.StartsWith(TEXT("{\"id\":\"c1\"")) && Json.Contains(TEXT("\"bIsActive\":false")));
+
+	FCarespaceClient Converted;
+	TestTrue("The converter should read the plan's output", FJsonObjectConverter::JsonObjectStringToUStruct(Json, &Converted, 0, 0));
+	TestEqual("Nested structs should be written as objects", Converted.Address.City, Client.Address.City);
+	TestEqual("Dates should be written as text", Converted.DateOfBirth, Client.DateOfBirth);
+
+	FString ConverterJson;
+	FJsonObjectConverter::UStructToJsonObjectString(Client, ConverterJson);
+	FCarespaceClient Decoded;
+	TestTrue("The plan should read the converter's output", UCarespaceHTTPClient::JsonStringToStruct(ConverterJson, FCarespaceClient::StaticStruct(), &Decoded));
+	TestEqual("Strings should round-trip", Decoded.Address.City, Client.Address.City);
+	TestFalse("Booleans should round-trip", Decoded.bIsActive);
+	TestEqual("Dates should round-trip", Decoded.DateOfBirth, Client.DateOfBirth);
+
+	// Enums are written by name, and unsupported structs still convert through the fallback
+	FCarespaceRequestOptions Options;
+	Options.Priority = ECarespaceRequestPriority::Background;
+	const FString OptionsJson = UCarespaceHTTPClient::StructToJsonString(FCarespaceRequestOptions::StaticStruct(), &Options);
+	TestTrue("The fallback should write enums by name", OptionsJson.Contains(TEXT("Background")));
+	TestFalse("The fallback should be condensed too", OptionsJson.Contains(TEXT("\n")));
+
+	FCarespaceHedgingPolicy Policy;
+	TestTrue("Numbers of the wrong type should be converted", UCarespaceHTTPClient::JsonStringToStruct(TEXT("{\"minSamples\":\"7\",\"latencyPercentile\":0.5,\"bEnabled\":1}"), FCarespaceHedgingPolicy::StaticStruct(), &Policy));
+	TestEqual("Integer strings should be parsed", Policy.MinSamples, 7);
+	TestEqual("Floats should be parsed", Policy.LatencyPercentile, 0.5f);
+	TestTrue("Numbers should convert to booleans", Policy.bEnabled);
+
+	// Numbers are as long as the sender makes them, but must follow the JSON grammar
+	const FString LongNumber = TEXT("0.25") + FString::ChrN(80, TEXT('0'));
+	TestTrue("Long numbers should be parsed", UCarespaceHTTPClient::JsonStringToStruct(FString::Printf(TEXT("{\"latencyPercentile\":%s}"), *LongNumber), FCarespaceHedgingPolicy::StaticStruct(), &Policy));
+	TestEqual("Long numbers should keep their value", Policy.LatencyPercentile, 0.25f);
+	for (const TCHAR* Malformed : { TEXT("01"), TEXT("1."), TEXT(".5"), TEXT("+1"), TEXT("1e"), TEXT("--1"), TEXT("1e+-2") })
+	{
+		TestFalse(FString::Printf(TEXT("%s is not a JSON number"), Malformed),
+			UCarespaceHTTPClient::JsonStringToStruct(FString::Printf(TEXT("{\"latencyPercentile\":%s}"), Malformed), FCarespaceHedgingPolicy::StaticStruct(), &Policy));
+	}
+
+	return !HasAnyErrors();
+}
+
+namespace
+{
+	/** Counts the heap allocations behind an FJsonValue tree: every value, object, member map, key, string and array. */
+	int32 CountJsonValueAllocations(const TSharedPtr<FJsonValue>& Value)
+	{
+		int32 Count = 1;
+		switch (Value->Type)
+		{
+		case EJson::String:
+			return Count + 1;
+
+		case EJson::Array:
+			Count += 1;
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+			{
+				Count += CountJsonValueAllocations(Element);
+			}
+			return Count;
+
+		case EJson::Object:
+			Count += 2;
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Member : Value->AsObject()->Values)
+			{
+				Count += 1 + CountJsonValueAllocations(Member.Value);
+			}
+			return Count;
+
+		default:
+			return Count;
+		}
+	}
+}
+
+/**
+ * Test suite for the arena-backed JSON document.
+ * Verifies parsing and lookups, and reports its allocations against an FJsonSerializer tree of the same page.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceJsonDocumentTest, "CarespaceSDK.HTTPClient.JsonDocument",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceJsonDocumentTest::RunTest(const FString& Parameters)
+{
+	FCarespaceJsonDocument Document;
+	const TArray<uint8> ErrorBody = UCarespaceTestHelpers::ToUtf8Bytes(TEXT("{\"Message\":\"Email \\\"x\\\" is taken\",\"details\":[1,2.5,{\"retry\":true,\"field\":null}]}"));
+	TestTrue("An error body should parse", Document.Parse(ErrorBody));
+	const FCarespaceJsonNode* Message = Document.GetRoot().FindField("message");
+	TestTrue("Keys should match case-insensitively", Message != nullptr);
+	TestEqual("Strings should be unescaped on access", Message ? Message->AsString() : FString(), TEXT("Email \"x\" is taken"));
+
+	const TConstArrayView<FCarespaceJsonNode> Details = Document.GetRoot().FindField("details")->GetElements();
+	TestEqual("Arrays should keep their elements", Details.Num(), 3);
+	if (Details.Num() == 3)
+	{
+		TestEqual("Numbers should be parsed on access", Details[1].AsNumber(), 2.5);
+		TestTrue("Nested objects should be reachable", Details[2].FindField("retry")->AsBool());
+		TestTrue("Null members should be kept", Details[2].FindField("field")->GetType() == ECarespaceJsonValueType::Null);
+	}
+
+	TestFalse("Trailing garbage should be rejected", Document.Parse(UCarespaceTestHelpers::ToUtf8Bytes(TEXT("{\"a\":1} x"))));
+	TestFalse("Unterminated containers should be rejected", Document.Parse(UCarespaceTestHelpers::ToUtf8Bytes(TEXT("{\"a\":[1,"))));
+	TestFalse("Numbers outside the JSON grammar should be rejected", Document.Parse(UCarespaceTestHelpers::ToUtf8Bytes(TEXT("{\"a\":-01}"))));
+	TestTrue("Long numbers should be accepted", Document.Parse(UCarespaceTestHelpers::ToUtf8Bytes(TEXT("{\"a\":") + FString::ChrN(70, TEXT('1')) + TEXT("e-69}"))));
+	TestEqual("Long numbers should be parsed in full", Document.GetRoot().FindField("a")->AsNumber(), 1.111111111111111, 1e-9);
+
+	// A 100-client page: one FJsonSerializer allocation per node against a few arena blocks
+	FString Page = TEXT("{\"data\":[");
+	for (int32 Index = 0; Index < 100; ++Index)
+	{
+		Page += FString::Printf(TEXT("%s{\"id\":\"c%d\",\"name\":\"Client %d\",\"email\":\"c%d@example.com\",\"address\":{\"city\":\"Lisbon\",\"country\":\"PT\"},\"bIsActive\":true,\"createdAt\":\"2024-01-02T03:04:05Z\"}"),
+			Index > 0 ? TEXT(",") : TEXT(""), Index, Index, Index);
+	}
+	Page += TEXT("],\"total\":100}");
+	const TArray<uint8> PageBytes = UCarespaceTestHelpers::ToUtf8Bytes(Page);
+
+	const TSharedPtr<FJsonObject> PageObject = UCarespaceHTTPClient::JsonBytesToObject(PageBytes);
+	const int32 SerializerAllocations = PageObject.IsValid() ? CountJsonValueAllocations(MakeShared<FJsonValueObject>(PageObject)) : 0;
+
+	TestTrue("The page should parse", Document.Parse(PageBytes));
+	TestEqual("All clients should be reachable", Document.GetRoot().FindField("data")->GetElements().Num(), 100);
+	const int32 ArenaAllocations = Document.GetArena().GetNumBlocks();
+
+	AddInfo(FString::Printf(TEXT("100-client page: %d allocations with FJsonSerializer, %d with the arena document (%llu bytes)"),
+		SerializerAllocations, ArenaAllocations, static_cast<uint64>(Document.GetArena().GetBytesUsed())));
+	TestTrue("The arena should need a handful of allocations", ArenaAllocations <= 4 && ArenaAllocations * 100 < SerializerAllocations);
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for UTF-8 request bodies.
+ * Verifies that payloads built as bytes carry the same JSON as their FString counterparts, encoded as UTF-8.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceUtf8PayloadTest, "CarespaceSDK.HTTPClient.Utf8Payload",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceUtf8PayloadTest::RunTest(const FString& Parameters)
+{
+	FCarespaceUser User;
+	User.Id = TEXT("user_1");
+	User.Name = TEXT("Jos\u00e9 M\u00fcller \u2713");
+	User.Email = TEXT("jose@example.com");
+
+	const TArray<uint8> UserBytes = UCarespaceHTTPClient::StructToJsonBytes(FCarespaceUser::StaticStruct(), &User);
+	TestTrue("Struct bytes should be the UTF-8 of the struct string", UserBytes == UCarespaceTestHelpers::ToUtf8Bytes(UCarespaceHTTPClient::StructToJsonString(FCarespaceUser::StaticStruct(), &User)));
+	TestTrue("Non-ASCII characters should be encoded as UTF-8", UserBytes.Contains(0xC3) && UserBytes.Contains(0xE2));
+
+	FCarespaceUser Decoded;
+	TestTrue("Struct bytes should decode", UCarespaceHTTPClient::JsonBytesToStruct(UserBytes, FCarespaceUser::StaticStruct(), &Decoded));
+	TestEqual("Non-ASCII names should round-trip", Decoded.Name, User.Name);
+
+	FCarespaceLoginRequest LoginRequest;
+	LoginRequest.Email = TEXT("j\u00fcrgen@example.com");
+	LoginRequest.Password = TEXT("p\u00e4ss");
+	TestTrue("Field-table bytes should match the field-table string", CarespaceJson::ToJsonBytes(LoginRequest) == UCarespaceTestHelpers::ToUtf8Bytes(CarespaceJson::ToJsonString(LoginRequest)));
+
+	TArray<uint8> Body;
+	FCarespaceJsonWriter Writer(Body);
+	Writer.BeginObject();
+	Writer.WriteKey("current_password");
+	Writer.WriteString(TEXT("\u00e4\"\\"));
+	Writer.WriteKey("new_password");
+	Writer.WriteString(TEXT("n\u00e9w"));
+	Writer.EndObject();
+	TestTrue("Hand-written bodies should be escaped UTF-8", Body == UCarespaceTestHelpers::ToUtf8Bytes(TEXT("{\"current_password\":\"\u00e4\\\"\\\\\",\"new_password\":\"n\u00e9w\"}")));
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for the structural JSON index.
+ * Verifies the indexed offsets around escapes and block boundaries, checks list decoding against the stream decoder,
+ * and reports tokenizing and decoding times against TJsonReader.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceJsonIndexTest, "CarespaceSDK.HTTPClient.JsonIndex",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceJsonIndexTest::RunTest(const FString& Parameters)
+{
+	// Escaped quotes and backslash runs, with the second string straddling the first 64-byte block
+	const FString Tricky = TEXT("{\"a\\\"[\":[\"\\\\\",1],\"padding-padding-padding-padding-pad\":\"x\\\\\\\"{\\\\\"}");
+	const TArray<uint8> TrickyBytes = UCarespaceTestHelpers::ToUtf8Bytes(Tricky);
+	FCarespaceJsonIndex Index;
+	TestTrue("A well-formed document should be indexed", Index.Build(TrickyBytes));
+
+	TArray<uint32> Expected;
+	bool bInString = false;
+	for (int32 Offset = 0; Offset < TrickyBytes.Num(); ++Offset)
+	{
+		const uint8 Char = TrickyBytes[Offset];
+		if (bInString && Char == '\\')
+		{
+			++Offset;
+		}
+		else if (Char == '"')
+		{
+			bInString = !bInString;
+			Expected.Add(Offset);
+		}
+		else if (!bInString && (Char == '{' || Char == '}' || Char == '[' || Char == ']' || Char == ':' || Char == ','))
+		{
+			Expected.Add(Offset);
+		}
+	}
+	TestTrue("Structural characters and quotes outside escapes should be indexed", TArray<uint32>(Index.GetStructurals()) == Expected);
+	TestTrue("Backslashes inside a string should be found", Index.HasBackslash(2, 6));
+	TestFalse("Unterminated strings should be rejected", Index.Build(UCarespaceTestHelpers::ToUtf8Bytes(TEXT("{\"a\":\"b\\\"}"))));
+	TestFalse("Control characters in strings should be rejected", Index.Build(UCarespaceTestHelpers::ToUtf8Bytes(TEXT("{\"a\":\"b\nc\"}"))));
+
+	// A page of 100 programs with nested exercises and a member the schema does not know
+	FString Page = TEXT("{\"total\":100,\"meta\":{\"data\":[]},\"data\":[");
+	for (int32 ProgramIndex = 0; ProgramIndex < 100; ++ProgramIndex)
+	{
+		Page += FString::Printf(TEXT("%s{\"id\":\"p%d\",\"name\":\"Knee \\\"rehab\\\" %d\",\"duration\":%d,\"bIsTemplate\":true,\"createdAt\":\"2024-01-02T03:04:05Z\",")
+			TEXT("\"extra\":{\"tags\":[\"]\",\"}\"]},\"exercises\":[{\"id\":\"e1\",\"sets\":3,\"videoURL\":\"https://cdn.example.com/e1.mp4\"},{\"id\":\"e2\",\"sets\":4}]}"),
+			ProgramIndex > 0 ? TEXT(",") : TEXT(""), ProgramIndex, ProgramIndex, ProgramIndex);
+	}
+	Page += TEXT("]}");
+	const TArray<uint8> PageBytes = UCarespaceTestHelpers::ToUtf8Bytes(Page);
+
+	TArray<FCarespaceProgram> Indexed;
+	TestTrue("The page should decode through the index", CarespaceJson::FromJsonList(PageBytes, "data", Indexed));
+
+	TCarespaceJsonListDecoder<FCarespaceProgram> StreamDecoder;
+	StreamDecoder.Feed(PageBytes);
+	const TArray<FCarespaceProgram> Streamed = StreamDecoder.MoveItems();
+
+	TestEqual("Both decoders should find every program", Indexed.Num(), Streamed.Num());
+	TestEqual("Only the top-level array should be decoded", Indexed.Num(), 100);
+	if (Indexed.Num() == 100 && Streamed.Num() == 100)
+	{
+		TestEqual("Escaped names should match", Indexed[42].Name, Streamed[42].Name);
+		TestEqual("Nested exercises should match", Indexed[99].Exercises.Num(), 2);
+		TestEqual("Nested members should match", Indexed[99].Exercises[1].Sets, Streamed[99].Exercises[1].Sets);
+		TestTrue("Dates should match", Indexed[7].CreatedAt == Streamed[7].CreatedAt);
+	}
+
+	// Tokenizing and decoding times; reported only, since they depend on the machine
+	constexpr int32 Iterations = 50;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+#if CARESPACE_WITH_UTF8_JSON
+		TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(PageBytes.GetData()), PageBytes.Num()));
+#else
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(PageBytes.GetData()), PageBytes.Num());
+		TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(FString(Converted.Length(), Converted.Get()));
+#endif
+		EJsonNotation Notation;
+		while (Reader->ReadNext(Notation))
+		{
+		}
+	}
+	const double JsonReaderSeconds = (FPlatformTime::Seconds() - StartTime) / Iterations;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Index.Build(PageBytes);
+	}
+	const double IndexSeconds = (FPlatformTime::Seconds() - StartTime) / Iterations;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		TCarespaceJsonListDecoder<FCarespaceProgram> Decoder;
+		Decoder.Feed(PageBytes);
+	}
+	const double StreamSeconds = (FPlatformTime::Seconds() - StartTime) / Iterations;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		TArray<FCarespaceProgram> Programs;
+		CarespaceJson::FromJsonList(PageBytes, "data", Programs);
+	}
+	const double IndexedSeconds = (FPlatformTime::Seconds() - StartTime) / Iterations;
+
+	AddInfo(FString::Printf(TEXT("%d-byte page, %s kernel: tokenize %.1f us with TJsonReader, %.1f us with the index; decode %.1f us streamed, %.1f us indexed"),
+		PageBytes.Num(), FCarespaceJsonIndex::GetKernelName(), JsonReaderSeconds * 1e6, IndexSeconds * 1e6, StreamSeconds * 1e6, IndexedSeconds * 1e6));
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for parallel list decoding.
+ * Verifies that elements decoded across worker threads come back complete and in document order.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceParallelListDecodeTest, "CarespaceSDK.HTTPClient.ParallelListDecode",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceParallelListDecodeTest::RunTest(const FString& Parameters)
+{
+	// Every seventh element does not match the struct and must be skipped without shifting the others
+	FString Page = TEXT("{\"data\":[");
+	for (int32 ProgramIndex = 0; ProgramIndex < 500; ++ProgramIndex)
+	{
+		Page += ProgramIndex > 0 ? TEXT(",") : TEXT("");
+		Page += ProgramIndex % 7 == 3
+			? FString::Printf(TEXT("{\"id\":\"p%d\",\"exercises\":\"none\"}"), ProgramIndex)
+			: FString::Printf(TEXT("{\"id\":\"p%d\",\"duration\":%d,\"exercises\":[{\"id\":\"e1\",\"sets\":3},{\"id\":\"e2\",\"sets\":%d}]}"), ProgramIndex, ProgramIndex, ProgramIndex);
+	}
+	Page += TEXT("],\"total\":500}");
+
+	FTCHARToUTF8 Utf8(*Page);
+	const TArray<uint8> PageBytes(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+	double StartTime = FPlatformTime::Seconds();
+	TArray<FCarespaceProgram> Serial;
+	TestTrue("The page should decode on one thread", CarespaceJson::FromJsonList(PageBytes, "data", Serial, EParallelForFlags::ForceSingleThread));
+	const double SerialSeconds = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	TArray<FCarespaceProgram> Parallel;
+	TestTrue("The page should decode in parallel", CarespaceJson::FromJsonList(PageBytes, "data", Parallel));
+	const double ParallelSeconds = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual("Mismatching elements should be skipped", Parallel.Num(), 500 - 71);
+	TestEqual("Both schedules should decode the same elements", Parallel.Num(), Serial.Num());
+	bool bInOrder = Parallel.Num() == Serial.Num();
+	for (int32 Index = 0; bInOrder && Index < Parallel.Num(); ++Index)
+	{
+		bInOrder = Parallel[Index].Id == Serial[Index].Id && Parallel[Index].Exercises.Num() == 2 && Parallel[Index].Exercises[1].Sets == Parallel[Index].Duration;
+	}
+	TestTrue("Elements should be complete and in document order", bInOrder);
+
+	AddInfo(FString::Printf(TEXT("500 programs: %.2f ms on one thread, %.2f ms in parallel"), SerialSeconds * 1000.0, ParallelSeconds * 1000.0));
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for the fixed-format timestamp parser.
+ * Verifies agreement with FDateTime::ParseIso8601, calendar validation and its use by the typed decoders.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceTimestampTest, "CarespaceSDK.HTTPClient.Timestamp",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceTimestampTest::RunTest(const FString& Parameters)
+{
+	const TCHAR* Agreeing[] = {
+		TEXT("2024-01-02"),
+		TEXT("2024-01-02T03:04:05Z"),
+		TEXT("2024-01-02T03:04:05.123Z"),
+		TEXT("2024-01-02T03:04:05.5+02:30"),
+		TEXT("2024-12-31T23:30:00-01:00"),
+		TEXT("2024-02-29T12:00:00")
+	};
+	for (const TCHAR* Text : Agreeing)
+	{
+		FDateTime Expected;
+		FDateTime Parsed;
+		TestTrue(FString::Printf(TEXT("The engine should parse %s"), Text), FDateTime::ParseIso8601(Text, Expected));
+		TestTrue(FString::Printf(TEXT("%s should parse"), Text), FCarespaceTimestamp::Parse(Text, Parsed));
+		TestEqual(FString::Printf(TEXT("%s should match the engine"), Text), Parsed, Expected);
+	}
+
+	// Fractions finer than milliseconds keep the 100 ns resolution of FDateTime
+	int64 Ticks = 0;
+	TestTrue("Microsecond fractions should parse", FCarespaceTimestamp::ParseTicks(TEXT("2024-01-02T03:04:05.1234567891Z"), Ticks));
+	TestEqual("Fractions should be kept to the tick", Ticks, FDateTime(2024, 1, 2, 3, 4, 5).GetTicks() + 1234567);
+
+	const TCHAR* Rejected[] = {
+		TEXT("2023-02-29"),
+		TEXT("2024-04-31T00:00:00Z"),
+		TEXT("2024-01-02T24:00:00Z"),
+		TEXT("2024-01-02T03:04:05."),
+		TEXT("2024-01-02T03:04:05+0200"),
+		TEXT("2024.01.02-03.04.05")
+	};
+	for (const TCHAR* Text : Rejected)
+	{
+		TestFalse(FString::Printf(TEXT("%s should be rejected"), Text), FCarespaceTimestamp::ParseTicks(Text, Ticks));
+	}
+
+	// Raw UTF-8 text orders by ticks without building FDateTime values
+	const FTCHARToUTF8 Older(TEXT("2024-05-01T10:00:00+02:00"));
+	const FTCHARToUTF8 Newer(TEXT("2024-05-01T08:30:00Z"));
+	int64 OlderTicks = 0;
+	int64 NewerTicks = 0;
+	TestTrue("UTF-8 timestamps should parse",
+		FCarespaceTimestamp::ParseTicks(TArrayView<const uint8>(reinterpret_cast<const uint8*>(Older.Get()), Older.Length()), OlderTicks) &&
+		FCarespaceTimestamp::ParseTicks(TArrayView<const uint8>(reinterpret_cast<const uint8*>(Newer.Get()), Newer.Length()), NewerTicks));
+	TestTrue("Offsets should be applied before comparing", OlderTicks < NewerTicks);
+
+	// The typed decoders take the fast path and still fall back to the engine format FDateTime::ToString writes
+	const char* UserJson = "{\"id\":\"u1\",\"createdAt\":\"2024.01.02-03.04.05\",\"updatedAt\":\"2024-05-01T08:30:00.250Z\"}";
+	FCarespaceUser User;
+	TestTrue("The user should decode", CarespaceJson::FromJson(TArrayView<const uint8>(reinterpret_cast<const uint8*>(UserJson), FCStringAnsi::Strlen(UserJson)), User));
+	TestEqual("UpdatedAt should come from the fast parser", User.UpdatedAt, FDateTime(2024, 5, 1, 8, 30, 0, 250));
+	TestEqual("CreatedAt should fall back to FDateTime::Parse", User.CreatedAt, FDateTime(2024, 1, 2, 3, 4, 5));
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for coalescing of identical in-flight GET requests.
+ * Verifies that identical calls share one HTTP request and that calls made with different credentials never do.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceRequestCoalescingTest, "CarespaceSDK.HTTPClient.RequestCoalescing",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceRequestCoalescingTest::RunTest(const FString& Parameters)
+{
+	UCarespaceHTTPClient* HTTPClient = NewObject<UCarespaceHTTPClient>();
+	TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+	HTTPClient->SetTransport(Transport);
+	HTTPClient->SetAPIKey(TEXT("token-a"));
+
+	TMap<FString, FString> Query;
+	Query.Add(TEXT("page"), TEXT("1"));
+
+	int32 NumTokenA = 0;
+	int32 NumTokenB = 0;
+	FString LastBody;
+	const FOnHTTPResponseBytes OnTokenA = FOnHTTPResponseBytes::CreateLambda([&NumTokenA, &LastBody](bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error)
+	{
+		NumTokenA += bWasSuccessful ? 1 : 0;
+		LastBody = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num()));
+	});
+	const FOnHTTPResponseBytes OnTokenB = FOnHTTPResponseBytes::CreateLambda([&NumTokenB, &LastBody](bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error)
+	{
+		NumTokenB += bWasSuccessful ? 1 : 0;
+		LastBody = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num()));
+	});
+
+	for (int32 Index = 0; Index < 5; ++Index)
+	{
+		HTTPClient->SendRequestRaw(TEXT("GET"), TEXT("/users"), Query, FString(), FCarespaceRequestOptions(), OnTokenA);
+	}
+	TestEqual("Identical GETs should share one HTTP request", Transport->Num(), 1);
+	TestEqual("Every caller after the first should be coalesced", HTTPClient->GetStats().RequestsCoalesced, 4);
+
+	// A refreshed token must not be answered with the response fetched for the previous one
+	HTTPClient->SetAPIKey(TEXT("token-b"));
+	HTTPClient->SendRequestRaw(TEXT("GET"), TEXT("/users"), Query, FString(), FCarespaceRequestOptions(), OnTokenB);
+	HTTPClient->SendRequestRaw(TEXT("GET"), TEXT("/users"), Query, FString(), FCarespaceRequestOptions(), OnTokenB);
+	TestEqual("A GET with other credentials should send its own request", Transport->Num(), 2);
+	TestEqual("The first request should carry the first token", Transport->GetRequest(0).Request->GetHeader(TEXT("Authorization")), FString(TEXT("Bearer token-a")));
+	TestEqual("The second request should carry the second token", Transport->GetRequest(1).Request->GetHeader(TEXT("Authorization")), FString(TEXT("Bearer token-b")));
+
+	Transport->Respond(0, 200, TEXT("{\"user\":\"a\"}"));
+	TestEqual("One response should complete every coalesced caller", NumTokenA, 5);
+	TestEqual("Callers of the other token should still be waiting", NumTokenB, 0);
+	TestEqual("Callers should receive the body of their own request", LastBody, FString(TEXT("{\"user\":\"a\"}")));
+
+	Transport->Respond(1, 200, TEXT("{\"user\":\"b\"}"));
+	TestEqual("Callers of the second token should be completed by their own response", NumTokenB, 2);
+	TestEqual("The second token's callers should receive its body", LastBody, FString(TEXT("{\"user\":\"b\"}")));
+
+	// Once completed, the request no longer collects callers
+	HTTPClient->SendRequestRaw(TEXT("GET"), TEXT("/users"), Query, FString(), FCarespaceRequestOptions(), OnTokenB);
+	TestEqual("A GET after completion should send a fresh request", Transport->Num(), 3);
+
+	// Bodies are never shared between callers of other verbs
+	HTTPClient->SendRequestRaw(TEXT("POST"), TEXT("/users"), TMap<FString, FString>(), TEXT("{}"), FCarespaceRequestOptions(), OnTokenB);
+	HTTPClient->SendRequestRaw(TEXT("POST"), TEXT("/users"), TMap<FString, FString>(), TEXT("{}"), FCarespaceRequestOptions(), OnTokenB);
+	TestEqual("POSTs should never be coalesced", Transport->Num(), 5);
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for the priority lanes of the request queue.
+ * Verifies that queued requests start in lane order (Auth, Interactive, Background) and in FIFO order within a lane.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceRequestPriorityTest, "CarespaceSDK.HTTPClient.RequestPriority",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceRequestPriorityTest::RunTest(const FString& Parameters)
+{
+	UCarespaceHTTPClient* HTTPClient = NewObject<UCarespaceHTTPClient>();
+	TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+	HTTPClient->SetTransport(Transport);
+	HTTPClient->SetMaxConcurrentRequests(1);
+
+	auto Send = [HTTPClient](const TCHAR* Endpoint, ECarespaceRequestPriority Priority)
+	{
+		FCarespaceRequestOptions Options;
+		Options.Priority = Priority;
+		HTTPClient->SendRequestRaw(TEXT("GET"), Endpoint, TMap<FString, FString>(), FString(), Options, FOnHTTPResponseBytes());
+	};
+
+	// The first request takes the only slot; the rest queue up in the reverse of their lane order
+	Send(TEXT("/users/busy"), ECarespaceRequestPriority::Interactive);
+	Send(TEXT("/programs/prefetch-1"), ECarespaceRequestPriority::Background);
+	Send(TEXT("/programs/prefetch-2"), ECarespaceRequestPriority::Background);
+	Send(TEXT("/users/1"), ECarespaceRequestPriority::Interactive);
+	Send(TEXT("/auth/refresh"), ECarespaceRequestPriority::Auth);
+	{
+		FCarespaceScopedRequestPriority BackgroundScope(HTTPClient, ECarespaceRequestPriority::Background);
+		Send(TEXT("/programs/prefetch-3"), ECarespaceRequestPriority::Auth);
+	}
+
+	TestEqual("Only one request should be in flight", Transport->Num(), 1);
+	TestEqual("The Auth lane should hold one request", HTTPClient->GetQueueDepth(ECarespaceRequestPriority::Auth), 1);
+	TestEqual("The Interactive lane should hold one request", HTTPClient->GetQueueDepth(ECarespaceRequestPriority::Interactive), 1);
+	TestEqual("The scoped override should move a request to the Background lane", HTTPClient->GetQueueDepth(ECarespaceRequestPriority::Background), 3);
+
+	const TCHAR* ExpectedOrder[] = {
+		TEXT("/users/busy"),
+		TEXT("/auth/refresh"),
+		TEXT("/users/1"),
+		TEXT("/programs/prefetch-1"),
+		TEXT("/programs/prefetch-2"),
+		TEXT("/programs/prefetch-3")
+	};
+
+	// Each completion frees the slot for the most urgent queued request
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(ExpectedOrder); ++Index)
+	{
+		if (!TestEqual(FString::Printf(TEXT("Request %d should have started"), Index), Transport->Num(), Index + 1))
+		{
+			break;
+		}
+		TestTrue(FString::Printf(TEXT("Request %d should be %s"), Index, ExpectedOrder[Index]), Transport->GetRequest(Index).Request->GetURL().EndsWith(ExpectedOrder[Index]));
+		Transport->Respond(Index, 200, TEXT("{}"));
+	}
+
+	TestEqual("Every lane should be drained", HTTPClient->GetTotalQueueDepth(), 0);
+	TestEqual("The queue should have peaked at five requests", HTTPClient->GetStats().PeakQueueDepth, 5);
+
+	return !HasAnyErrors();
+}
+
+namespace
+{
+	/** @return An empty directory for the disk cache entries of one test */
+	FString MakeDiskCacheTestDirectory(const TCHAR* TestName)
+	{
+		const FString Directory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("CarespaceDiskCache"), TestName);
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		return Directory;
+	}
+
+	TArray<FString> FindDiskCacheFiles(const FString& Directory)
+	{
+		TArray<FString> Files;
+		IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, TEXT("*.cache")), true, false);
+		for (FString& File : Files)
+		{
+			File = FPaths::Combine(Directory, File);
+		}
+		return Files;
+	}
+
+	/** @return An unsigned JWT whose payload carries the given subject and issue time */
+	FString MakeTestToken(const FString& Subject, int32 IssuedAt)
+	{
+		FString Payload = FBase64::Encode(FString::Printf(TEXT("{\"sub\":\"%s\",\"iat\":%d}"), *Subject, IssuedAt));
+		Payload.ReplaceCharInline(TEXT('+'), TEXT('-'));
+		Payload.ReplaceCharInline(TEXT('/'), TEXT('_'));
+		Payload.RemoveFromEnd(TEXT("="));
+		Payload.RemoveFromEnd(TEXT("="));
+		return TEXT("eyJhbGciOiJub25lIn0.") + Payload + TEXT(".signature");
+	}
+}
+
+/**
+ * Test suite for the size bound of the persistent response cache.
+ * Verifies that writes past MaxBytes delete older entries until the directory fits again.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceDiskCacheBudgetTest, "CarespaceSDK.HTTPClient.DiskCacheBudget",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceDiskCacheBudgetTest::RunTest(const FString& Parameters)
+{
+	FCarespaceDiskCacheSettings Settings;
+	Settings.bEnabled = true;
+	Settings.Directory = MakeDiskCacheTestDirectory(TEXT("Budget"));
+	Settings.MaxBytes = 4 * 1024;
+
+	FCarespaceDiskCache Cache;
+	Cache.SetSettings(Settings);
+
+	// Random bodies do not compress, so every entry takes a little over 1 KB on disk
+	FRandomStream Random(1234);
+	for (int32 Index = 0; Index < 8; ++Index)
+	{
+		TSharedRef<FCarespaceCachedResponse> Entry = MakeShared<FCarespaceCachedResponse>();
+		Entry->ETag = FString::Printf(TEXT("\"v%d\""), Index);
+		Entry->Body.SetNumUninitialized(1024);
+		for (uint8& Byte : Entry->Body)
+		{
+			Byte = static_cast<uint8>(Random.RandHelper(256));
+		}
+		Cache.StoreAsync(FString::Printf(TEXT("GET /programs/%d"), Index), Entry).Wait();
+	}
+
+	const TArray<FString> Files = FindDiskCacheFiles(Settings.Directory);
+	int64 TotalBytes = 0;
+	for (const FString& File : Files)
+	{
+		TotalBytes += IFileManager::Get().FileSize(*File);
+	}
+
+	TestTrue("Older entries should have been deleted", Files.Num() > 0 && Files.Num() < 8);
+	TestTrue("The directory should fit in MaxBytes", TotalBytes <= Settings.MaxBytes);
+
+	Cache.Clear().Wait();
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for the schema version check of the persistent response cache.
+ * Verifies that an entry written for other data types is never loaded and is deleted when found.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceDiskCacheSchemaTest, "CarespaceSDK.HTTPClient.DiskCacheSchema",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceDiskCacheSchemaTest::RunTest(const FString& Parameters)
+{
+	FCarespaceDiskCacheSettings Settings;
+	Settings.bEnabled = true;
+	Settings.Directory = MakeDiskCacheTestDirectory(TEXT("Schema"));
+
+	FCarespaceDiskCache Cache;
+	Cache.SetSettings(Settings);
+
+	TSharedRef<FCarespaceCachedResponse> Entry = MakeShared<FCarespaceCachedResponse>();
+	Entry->ETag = TEXT("\"v1\"");
+	Entry->Body = { '{', '}' };
+	Cache.StoreAsync(TEXT("GET /programs"), Entry).Wait();
+
+	double AgeSeconds = 0.0;
+	TSharedPtr<FCarespaceCachedResponse> Loaded = Cache.Load(TEXT("GET /programs"), AgeSeconds);
+	TestTrue("An entry of the current schema should load", Loaded.IsValid() && Loaded->Body == Entry->Body);
+
+	const TArray<FString> Files = FindDiskCacheFiles(Settings.Directory);
+	if (!TestEqual("One entry should have been written", Files.Num(), 1))
+	{
+		return false;
+	}
+
+	// The header is the magic, the format version and then the schema version, 4 bytes each
+	TArray<uint8> FileData;
+	FFileHelper::LoadFileToArray(FileData, *Files[0]);
+	const uint32 OtherSchemaVersion = CARESPACE_SDK_SCHEMA_VERSION + 1;
+	FMemory::Memcpy(FileData.GetData() + 8, &OtherSchemaVersion, sizeof(OtherSchemaVersion));
+	FFileHelper::SaveArrayToFile(FileData, *Files[0]);
+
+	TestFalse("An entry of another schema should not load", Cache.Load(TEXT("GET /programs"), AgeSeconds).IsValid());
+	TestFalse("An entry of another schema should be deleted", IFileManager::Get().FileExists(*Files[0]));
+
+	Cache.Clear().Wait();
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for warm starts from the persistent response cache.
+ * Verifies that a persisted response answers a caller while its refresh is still in flight, that the entry is
+ * shared by every token of the same account but no other account, and that the refresh does not call back again.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceDiskCacheStaleWhileRevalidateTest, "CarespaceSDK.HTTPClient.DiskCacheStaleWhileRevalidate",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceDiskCacheStaleWhileRevalidateTest::RunTest(const FString& Parameters)
+{
+	struct FState
+	{
+		FCarespaceDiskCacheSettings Settings;
+		TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+		TSharedRef<FCarespaceTestTransport> OtherAccountTransport = MakeShared<FCarespaceTestTransport>();
+		TStrongObjectPtr<UCarespaceHTTPClient> Client;
+		TStrongObjectPtr<UCarespaceHTTPClient> OtherAccountClient;
+		int32 NumResponses = 0;
+		int32 NumOtherAccountResponses = 0;
+		FString LastBody;
+	};
+	TSharedRef<FState> State = MakeShared<FState>();
+	State->Settings.bEnabled = true;
+	State->Settings.Directory = MakeDiskCacheTestDirectory(TEXT("StaleWhileRevalidate"));
+
+	// A previous session of the account fetched the catalog and persisted it
+	{
+		UCarespaceHTTPClient* PreviousSession = NewObject<UCarespaceHTTPClient>();
+		TSharedRef<FCarespaceTestTransport> PreviousTransport = MakeShared<FCarespaceTestTransport>();
+		PreviousSession->SetTransport(PreviousTransport);
+		PreviousSession->SetAPIKey(MakeTestToken(TEXT("account-1"), 1));
+		PreviousSession->SetDiskCacheSettings(State->Settings);
+		PreviousSession->SendRequestRaw(TEXT("GET"), TEXT("/programs"), TMap<FString, FString>(), FString(), FCarespaceRequestOptions(), FOnHTTPResponseBytes());
+
+		TMap<FString, FString> Headers;
+		Headers.Add(TEXT("ETag"), TEXT("\"v1\""));
+		PreviousTransport->Respond(0, 200, TEXT("{\"programs\":[\"persisted\"]}"), Headers);
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the entry to be persisted"), [State]()
+	{
+		return FindDiskCacheFiles(State->Settings.Directory).Num() == 1;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		// The new session runs with a refreshed token of the same account
+		State->Client.Reset(NewObject<UCarespaceHTTPClient>());
+		State->Client->SetTransport(State->Transport);
+		State->Client->SetAPIKey(MakeTestToken(TEXT("account-1"), 2));
+		State->Client->SetDiskCacheSettings(State->Settings);
+		State->Client->SendRequestRaw(TEXT("GET"), TEXT("/programs"), TMap<FString, FString>(), FString(), FCarespaceRequestOptions(),
+			FOnHTTPResponseBytes::CreateLambda([State](bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error)
+			{
+				State->NumResponses += bWasSuccessful ? 1 : 0;
+				State->LastBody = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num()));
+			}));
+
+		State->OtherAccountClient.Reset(NewObject<UCarespaceHTTPClient>());
+		State->OtherAccountClient->SetTransport(State->OtherAccountTransport);
+		State->OtherAccountClient->SetAPIKey(MakeTestToken(TEXT("account-2"), 2));
+		State->OtherAccountClient->SetDiskCacheSettings(State->Settings);
+		State->OtherAccountClient->SendRequestRaw(TEXT("GET"), TEXT("/programs"), TMap<FString, FString>(), FString(), FCarespaceRequestOptions(),
+			FOnHTTPResponseBytes::CreateLambda([State](bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error)
+			{
+				++State->NumOtherAccountResponses;
+			}));
+
+		// The disk is read on a worker, so the refresh goes out without waiting for it
+		TestEqual("The refresh should be sent while the entry loads", State->Transport->Num(), 1);
+		TestEqual("The caller should not be answered inside its send call", State->NumResponses, 0);
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the persisted response"), [State]()
+	{
+		return State->NumResponses > 0;
+	}));
+
+	// Give the other account's load the same time to (wrongly) answer
+	ADD_LATENT_AUTOMATION_COMMAND(FDelayedFunctionLatentCommand([this, State]()
+	{
+		TestEqual("The caller should receive the persisted body", State->LastBody, FString(TEXT("{\"programs\":[\"persisted\"]}")));
+		TestEqual("The response should count as served from disk", State->Client->GetStats().ResponsesServedFromDisk, 1);
+		TestEqual("The refresh should still be in flight", State->Transport->GetNumPending(), 1);
+
+		TestEqual("Another account should not be served the entry", State->NumOtherAccountResponses, 0);
+		TestEqual("Another account should not count a disk hit", State->OtherAccountClient->GetStats().ResponsesServedFromDisk, 0);
+
+		TMap<FString, FString> Headers;
+		Headers.Add(TEXT("ETag"), TEXT("\"v2\""));
+		State->Transport->Respond(0, 200, TEXT("{\"programs\":[\"fresh\"]}"), Headers);
+		TestEqual("The refresh should not call back again", State->NumResponses, 1);
+
+		State->OtherAccountTransport->Respond(0, 200, TEXT("{\"programs\":[]}"));
+		TestEqual("Another account should be answered by its own request", State->NumOtherAccountResponses, 1);
+
+		State->Client->ClearDiskCache();
+	}, 0.5f));
+
+	return true;
+}
+
+/**
+ * Test suite for compression of request bodies.
+ * Verifies that large bodies are sent gzip-encoded and that a 415 response resends the body uncompressed exactly once.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceRequestCompressionTest, "CarespaceSDK.HTTPClient.RequestCompression",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceRequestCompressionTest::RunTest(const FString& Parameters)
+{
+	UCarespaceHTTPClient* HTTPClient = NewObject<UCarespaceHTTPClient>();
+	TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+	HTTPClient->SetTransport(Transport);
+	HTTPClient->SetRequestCompression(ECarespaceContentEncoding::Gzip, 256);
+
+	FString Json = TEXT("[");
+	for (int32 Index = 0; Index < 64; ++Index)
+	{
+		Json += FString::Printf(TEXT("%s{\"exercise\":\"squat\",\"repetitions\":%d}"), Index > 0 ? TEXT(",") : TEXT(""), Index);
+	}
+	Json += TEXT("]");
+	const FTCHARToUTF8 Utf8(*Json, Json.Len());
+	const TArray<uint8> Body(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+	int32 NumResponses = 0;
+	int32 LastResponseCode = 0;
+	const FOnHTTPResponseBytes OnComplete = FOnHTTPResponseBytes::CreateLambda([&NumResponses, &LastResponseCode](bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error)
+	{
+		++NumResponses;
+		LastResponseCode = Error.StatusCode;
+	});
+
+	// Small bodies are not worth the CPU time
+	HTTPClient->SendRequestRaw(TEXT("POST"), TEXT("/sessions"), TMap<FString, FString>(), TEXT("{}"), FCarespaceRequestOptions(), OnComplete);
+	TestTrue("A body under the threshold should be sent as is", Transport->GetRequest(0).Request->GetHeader(TEXT("Content-Encoding")).IsEmpty());
+	Transport->Respond(0, 201, TEXT("{}"));
+
+	HTTPClient->SendRequestRaw(TEXT("POST"), TEXT("/sessions"), TMap<FString, FString>(), Body, FCarespaceRequestOptions(), OnComplete);
+	const TSharedRef<IHttpRequest> Compressed = Transport->GetRequest(1).Request;
+	TestEqual("A body over the threshold should be gzip-encoded", Compressed->GetHeader(TEXT("Content-Encoding")), FString(TEXT("gzip")));
+	TestTrue("The encoded body should be smaller", Compressed->GetContent().Num() < Body.Num());
+	TestEqual("The compressed request should be counted", HTTPClient->GetStats().RequestsCompressed, 1);
+
+	TArray<uint8> Decoded;
+	Decoded.SetNumUninitialized(Body.Num());
+	TestTrue("The encoded body should decode to the original",
+		FCompression::UncompressMemory(NAME_Gzip, Decoded.GetData(), Decoded.Num(), Compressed->GetContent().GetData(), Compressed->GetContent().Num()) && Decoded == Body);
+
+	// The server does not understand the encoding: the same body goes out again, uncompressed
+	Transport->Respond(1, 415, TEXT("{\"message\":\"Unsupported Media Type\"}"));
+	if (!TestEqual("A 415 should resend the body", Transport->Num(), 3))
+	{
+		return false;
+	}
+	const TSharedRef<IHttpRequest> Resent = Transport->GetRequest(2).Request;
+	TestTrue("The resent body should carry no Content-Encoding", Resent->GetHeader(TEXT("Content-Encoding")).IsEmpty());
+	TestTrue("The resent body should be the original", Resent->GetContent() == Body);
+	TestEqual("The caller should wait for the resent request", NumResponses, 1);
+
+	// An uncompressed body is not resent again
+	Transport->Respond(2, 415, TEXT("{\"message\":\"Unsupported Media Type\"}"));
+	TestEqual("A second 415 should not resend the body", Transport->Num(), 3);
+	TestEqual("The second 415 should reach the caller", NumResponses, 2);
+	TestEqual("The caller should see the 415", LastResponseCode, 415);
+
+	// The host is remembered, so later bodies skip the round trip
+	HTTPClient->SendRequestRaw(TEXT("POST"), TEXT("/sessions"), TMap<FString, FString>(), Body, FCarespaceRequestOptions(), OnComplete);
+	TestTrue("Later bodies to the host should be sent uncompressed", Transport->GetRequest(3).Request->GetHeader(TEXT("Content-Encoding")).IsEmpty());
+	TestEqual("Only the first large body should have been compressed", HTTPClient->GetStats().RequestsCompressed, 1);
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for decoding of compressed response bodies.
+ * Verifies gzip and deflate bodies, that the gzip size field is only a hint, and that corrupt or oversized
+ * bodies fail the call and are never cached.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceResponseDecodingTest, "CarespaceSDK.HTTPClient.ResponseDecoding",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceResponseDecodingTest::RunTest(const FString& Parameters)
+{
+	UCarespaceHTTPClient* HTTPClient = NewObject<UCarespaceHTTPClient>();
+	TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+	HTTPClient->SetTransport(Transport);
+
+	FString Json = TEXT("[");
+	for (int32 Index = 0; Index < 256; ++Index)
+	{
+		Json += FString::Printf(TEXT("%s{\"id\":\"program-%d\",\"name\":\"Knee rehabilitation\"}"), Index > 0 ? TEXT(",") : TEXT(""), Index);
+	}
+	Json += TEXT("]");
+	const FTCHARToUTF8 Utf8(*Json, Json.Len());
+	const TArray<uint8> Body(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+	auto Compress = [&Body](FName FormatName)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, Body.Num());
+		TArray<uint8> Compressed;
+		Compressed.SetNumUninitialized(CompressedSize);
+		FCompression::CompressMemory(FormatName, Compressed.GetData(), CompressedSize, Body.GetData(), Body.Num());
+		Compressed.SetNum(CompressedSize);
+		return Compressed;
+	};
+
+	bool bLastSucceeded = false;
+	TArray<uint8> LastBody;
+	FCarespaceError LastError;
+	auto Fetch = [&](const TCHAR* Encoding, TArray<uint8> Content)
+	{
+		bLastSucceeded = false;
+		LastBody.Reset();
+		const int32 Index = Transport->Num();
+		HTTPClient->SendRequestRaw(TEXT("GET"), TEXT("/programs"), TMap<FString, FString>(), FString(), FCarespaceRequestOptions(),
+			FOnHTTPResponseBytes::CreateLambda([&](bool bWasSuccessful, const TArray<uint8>& ResponseBody, const FCarespaceError& Error)
+			{
+				bLastSucceeded = bWasSuccessful;
+				LastBody = ResponseBody;
+				LastError = Error;
+			}));
+
+		TMap<FString, FString> Headers;
+		Headers.Add(TEXT("Content-Encoding"), Encoding);
+		Headers.Add(TEXT("ETag"), FString::Printf(TEXT("\"%d\""), Index));
+		Transport->RespondBytes(Index, 200, MoveTemp(Content), Headers);
+	};
+
+	Fetch(TEXT("gzip"), Compress(NAME_Gzip));
+	TestTrue("A gzip body should be decoded", bLastSucceeded && LastBody == Body);
+
+	Fetch(TEXT("deflate"), Compress(NAME_Zlib));
+	TestTrue("A deflate body should be decoded", bLastSucceeded && LastBody == Body);
+	TestEqual("Both bodies should count as decompressed", HTTPClient->GetStats().ResponsesDecompressed, 2);
+
+	// The size field only sizes the first buffer; the stream's own length check still catches a wrong one
+	TArray<uint8> WrappedSize = Compress(NAME_Gzip);
+	WrappedSize.Last(3) = 0;
+	WrappedSize.Last(2) = 0;
+	WrappedSize.Last(1) = 0;
+	WrappedSize.Last(0) = 16;
+	Fetch(TEXT("gzip"), WrappedSize);
+	TestFalse("A gzip size field that disagrees with the stream should fail the CRC check", bLastSucceeded);
+
+	// A size field beyond the cap is refused before anything is allocated
+	TArray<uint8> Oversized = Compress(NAME_Gzip);
+	for (int32 Offset = 0; Offset < 4; ++Offset)
+	{
+		Oversized.Last(Offset) = 0xff;
+	}
+	Fetch(TEXT("gzip"), Oversized);
+	TestFalse("A body announcing more than the cap should fail", bLastSucceeded);
+	TestEqual("A refused body should report a network error", LastError.ErrorType, ECarespaceErrorType::NetworkError);
+
+	// The right magic bytes followed by garbage
+	TArray<uint8> Corrupt = Compress(NAME_Gzip);
+	for (int32 Offset = 10; Offset < Corrupt.Num() - 8; ++Offset)
+	{
+		Corrupt[Offset] = static_cast<uint8>(Offset * 37);
+	}
+	Fetch(TEXT("gzip"), Corrupt);
+	TestFalse("A corrupt gzip body should fail the call", bLastSucceeded);
+	TestTrue("A corrupt body should not be passed on", LastBody.Num() == 0);
+
+	TArray<uint8> Truncated = Compress(NAME_Zlib);
+	Truncated.SetNum(Truncated.Num() / 2);
+	Fetch(TEXT("deflate"), Truncated);
+	TestFalse("A truncated deflate body should fail the call", bLastSucceeded);
+
+	// Only the deflate body, the last one decoded, may be used as a validator
+	const int32 ValidatorIndex = Transport->Num();
+	HTTPClient->SendRequestRaw(TEXT("GET"), TEXT("/programs"), TMap<FString, FString>(), FString(), FCarespaceRequestOptions(), FOnHTTPResponseBytes());
+	TestEqual("Bodies that failed to decode should not be cached", Transport->GetRequest(ValidatorIndex).Request->GetHeader(TEXT("If-None-Match")), FString(TEXT("\"1\"")));
+	Transport->Respond(ValidatorIndex, 304, FString());
+
+	// Bodies a platform HTTP stack already decoded keep the header but not the magic bytes
+	Fetch(TEXT("gzip"), Body);
+	TestTrue("An already decoded body should be passed on as is", bLastSucceeded && LastBody == Body);
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for cancelling requests.
+ * Verifies cancellation of a queued request before it is sent, of one caller of a coalesced request, and of the
+ * requests of an owner that is cancelled explicitly or destroyed.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceRequestCancellationTest, "CarespaceSDK.HTTPClient.RequestCancellation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceRequestCancellationTest::RunTest(const FString& Parameters)
+{
+	UCarespaceHTTPClient* HTTPClient = NewObject<UCarespaceHTTPClient>();
+	TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+	HTTPClient->SetTransport(Transport);
+	HTTPClient->SetMaxConcurrentRequests(1);
+
+	TArray<FString> Completed;
+	auto Send = [HTTPClient, &Completed](const FString& Endpoint, const FString& Caller, UObject* Owner = nullptr)
+	{
+		FCarespaceRequestOptions Options;
+		Options.Owner = Owner;
+		return HTTPClient->SendRequestRaw(TEXT("GET"), Endpoint, TMap<FString, FString>(), FString(), Options,
+			FOnHTTPResponseBytes::CreateLambda([&Completed, Caller](bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error)
+			{
+				Completed.Add(Caller);
+			}));
+	};
+
+	// A queued request that is cancelled never goes out
+	Send(TEXT("/users/busy"), TEXT("busy"));
+	const FCarespaceRequestHandle Queued = Send(TEXT("/users/1"), TEXT("queued"));
+	TestEqual("The second request should wait for the slot", HTTPClient->GetTotalQueueDepth(), 1);
+	TestTrue("Cancelling a queued request should succeed", Queued.Cancel());
+	TestFalse("A cancelled request should no longer be pending", Queued.IsPending());
+	TestFalse("Cancelling twice should report nothing pending", Queued.Cancel());
+	TestEqual("The cancelled request should leave its lane", HTTPClient->GetTotalQueueDepth(), 0);
+
+	Transport->Respond(0, 200, TEXT("{}"));
+	TestEqual("The cancelled request should never be sent", Transport->Num(), 1);
+	TestFalse("The cancelled caller should not be called back", Completed.Contains(TEXT("queued")));
+
+	// Cancelling one caller of a coalesced request leaves the request to the others
+	Send(TEXT("/users/2"), TEXT("first"));
+	const FCarespaceRequestHandle Joiner = Send(TEXT("/users/2"), TEXT("joiner"));
+	Send(TEXT("/users/2"), TEXT("last"));
+	TestEqual("The callers should share one request", Transport->Num(), 2);
+	TestTrue("Cancelling a joiner should succeed", Joiner.Cancel());
+	TestFalse("The shared request should stay in flight", Transport->GetRequest(1).bCancelled);
+
+	Completed.Reset();
+	Transport->Respond(1, 200, TEXT("{}"));
+	TestTrue("The remaining callers should be called back", Completed == TArray<FString>({ TEXT("first"), TEXT("last") }));
+
+	// Once the last caller cancels, the request itself is aborted
+	const FCarespaceRequestHandle Only = Send(TEXT("/users/3"), TEXT("only"));
+	Only.Cancel();
+	TestTrue("A request without callers should be aborted", Transport->GetRequest(2).bCancelled);
+	TestEqual("Every cancelled caller should be counted", HTTPClient->GetStats().RequestsCancelled, 3);
+
+	// Owners cancel their requests explicitly or by being destroyed
+	UObject* ClosedWidget = NewObject<UCarespaceHTTPClient>();
+	UObject* DestroyedWidget = NewObject<UCarespaceHTTPClient>();
+	Completed.Reset();
+	HTTPClient->SetMaxConcurrentRequests(4);
+	Send(TEXT("/clients/1"), TEXT("closed"), ClosedWidget);
+	Send(TEXT("/clients/2"), TEXT("destroyed"), DestroyedWidget);
+	Send(TEXT("/clients/3"), TEXT("unowned"));
+	TestEqual("Every owned request should be sent", Transport->Num(), 6);
+
+	TestEqual("The owner's request should be cancelled", HTTPClient->CancelAllRequestsForOwner(ClosedWidget), 1);
+	TestTrue("The owner's request should be aborted", Transport->GetRequest(3).bCancelled);
+
+	// A destroyed owner is skipped even before the periodic sweep cancels its requests
+	DestroyedWidget->MarkAsGarbage();
+	Transport->Respond(4, 200, TEXT("{}"));
+	Transport->Respond(5, 200, TEXT("{}"));
+	TestTrue("Only the unowned caller should be called back", Completed == TArray<FString>({ TEXT("unowned") }));
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Test suite for attempt timeouts and deadlines.
+ * Verifies per-endpoint and per-call timeouts, that a timed-out request is cancelled and reported once as a
+ * TimeoutError to every caller, and that a caller's deadline only fails that caller.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCarespaceRequestTimeoutTest, "CarespaceSDK.HTTPClient.RequestTimeout",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCarespaceRequestTimeoutTest::RunTest(const FString& Parameters)
+{
+	struct FState
+	{
+		TStrongObjectPtr<UCarespaceHTTPClient> Client;
+		TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+		TMap<FString, FCarespaceError> Errors;
+		TSet<FString> Succeeded;
+		double StartTime = 0.0;
+		TMap<FString, double> CompletionTimes;
+	};
+	TSharedRef<FState> State = MakeShared<FState>();
+	State->Client.Reset(NewObject<UCarespaceHTTPClient>());
+	UCarespaceHTTPClient* HTTPClient = State->Client.Get();
+	HTTPClient->SetTransport(State->Transport);
+	HTTPClient->SetMaxRetries(0);
+
+	// Ticker delays count from the start of the frame they were added in, so they may fire a frame early
+	static constexpr double TickerSlack = 0.1;
+	HTTPClient->SetEndpointTimeout(TEXT("/programs"), 0.2f);
+
+	FCarespaceCircuitBreakerSettings CircuitSettings;
+	CircuitSettings.bEnabled = false;
+	HTTPClient->SetCircuitBreakerSettings(CircuitSettings);
+
+	auto Send = [State](const TCHAR* Endpoint, const TCHAR* Caller, const FCarespaceRequestOptions& Options)
+	{
+		State->Client->SendRequestRaw(TEXT("GET"), Endpoint, TMap<FString, FString>(), FString(), Options,
+			FOnHTTPResponseBytes::CreateLambda([State, Caller = FString(Caller)](bool bWasSuccessful, const TArray<uint8>& Body, const FCarespaceError& Error)
+			{
+				State->CompletionTimes.Add(Caller, FPlatformTime::Seconds() - State->StartTime);
+				if (bWasSuccessful)
+				{
+					State->Succeeded.Add(Caller);
+				}
+				else
+				{
+					State->Errors.Add(Caller, Error);
+				}
+			}));
+	};
+
+	State->StartTime = FPlatformTime::Seconds();
+
+	// Two callers share the request of an endpoint with a short default timeout
+	Send(TEXT("/programs"), TEXT("programs-1"), FCarespaceRequestOptions());
+	Send(TEXT("/programs"), TEXT("programs-2"), FCarespaceRequestOptions());
+
+	// A per-call timeout overrides the client-wide one
+	FCarespaceRequestOptions SlowOptions;
+	SlowOptions.TimeoutSeconds = 0.6f;
+	Send(TEXT("/users"), TEXT("users"), SlowOptions);
+
+	// A caller with a deadline joins a request without one, and only that caller gives up on it
+	FCarespaceRequestOptions DeadlineOptions;
+	DeadlineOptions.DeadlineSeconds = 0.3f;
+	Send(TEXT("/clients"), TEXT("clients-patient"), FCarespaceRequestOptions());
+	Send(TEXT("/clients"), TEXT("clients-deadline"), DeadlineOptions);
+
+	TestEqual("Each endpoint should send one request", State->Transport->Num(), 3);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the endpoint timeout"), [State]()
+	{
+		return State->CompletionTimes.Contains(TEXT("programs-2"));
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		TestTrue("The timed-out request should be cancelled", State->Transport->GetRequest(0).bCancelled);
+		for (const TCHAR* Caller : { TEXT("programs-1"), TEXT("programs-2") })
+		{
+			const FCarespaceError* Error = State->Errors.Find(Caller);
+			TestTrue(FString::Printf(TEXT("%s should receive a TimeoutError"), Caller), Error && Error->ErrorType == ECarespaceErrorType::TimeoutError);
+			TestTrue(FString::Printf(TEXT("%s should not time out before the endpoint timeout"), Caller), State->CompletionTimes[Caller] >= 0.2 - TickerSlack);
+		}
+		TestEqual("A shared request should count one timeout", State->Client->GetStats().RequestsTimedOut, 1);
+		TestFalse("The per-call timeout should still be running", State->CompletionTimes.Contains(TEXT("users")));
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the deadline"), [State]()
+	{
+		return State->CompletionTimes.Contains(TEXT("clients-deadline"));
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		const FCarespaceError* Error = State->Errors.Find(TEXT("clients-deadline"));
+		TestTrue("The expired caller should receive a TimeoutError", Error && Error->ErrorType == ECarespaceErrorType::TimeoutError);
+		TestTrue("The deadline should not fire early", State->CompletionTimes[TEXT("clients-deadline")] >= 0.3 - TickerSlack);
+		TestFalse("The request should stay in flight for the other caller", State->Transport->GetRequest(2).bCompleted);
+
+		State->Transport->Respond(2, 200, TEXT("{}"));
+		TestTrue("The other caller should still receive the response", State->Succeeded.Contains(TEXT("clients-patient")));
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the per-call timeout"), [State]()
+	{
+		return State->CompletionTimes.Contains(TEXT("users"));
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		const FCarespaceError* Error = State->Errors.Find(TEXT("users"));
+		TestTrue("The per-call timeout should report a TimeoutError", Error && Error->ErrorType == ECarespaceErrorType::TimeoutError);
+		TestTrue("The per-call timeout should not fire early", State->CompletionTimes[TEXT("users")] >= 0.6 - TickerSlack);
+		TestEqual("Every timed-out request and expired caller should be counted once", State->Client->GetStats().RequestsTimedOut, 3);
+		return true;
+	}));
+
+	return true;
+}
@@ -428,6 +428,12 @@ FString UCarespaceTestHelpers::GenerateTestEmail(const FString& Username, const
 	return FString::Printf(TEXT("%s@%s"), *ActualUsername, *Domain);
 }
 
+TArray<uint8> UCarespaceTestHelpers::ToUtf8Bytes(const FString& Text)
+{
+	FTCHARToUTF8 Utf8(*Text, Text.Len());
+	return TArray<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+}
+
 bool UCarespaceTestHelpers::WaitForCondition(float MaxWaitTime, float CheckInterval, const TFunction<bool()>& Condition)
 {
 	if (!Condition)
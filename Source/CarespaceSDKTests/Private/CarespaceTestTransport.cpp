@@ -0,0 +1,76 @@
+#include "CarespaceTestTransport.h"
+
+FString FCarespaceTestResponse::GetHeader(const FString& HeaderName) const
+{
+	// Header names are case-insensitive, like those of the HTTP module's responses
+	for (const TPair<FString, FString>& Header : Headers)
+	{
+		if (Header.Key.Equals(HeaderName, ESearchCase::IgnoreCase))
+		{
+			return Header.Value;
+		}
+	}
+	return FString();
+}
+
+void FCarespaceTestTransport::ProcessRequest(const TSharedRef<IHttpRequest>& Request, const FOnCarespaceTransportComplete& OnComplete)
+{
+	Requests.Add(FSentRequest{ Request, OnComplete });
+}
+
+void FCarespaceTestTransport::CancelRequest(const TSharedRef<IHttpRequest>& Request)
+{
+	const int32 Index = Requests.IndexOfByPredicate([&Request](const FSentRequest& Sent) { return Sent.Request == Request; });
+	if (Index != INDEX_NONE && !Requests[Index].bCompleted)
+	{
+		Requests[Index].bCancelled = true;
+		Complete(Index, nullptr);
+	}
+}
+
+int32 FCarespaceTestTransport::GetNumPending() const
+{
+	int32 NumPending = 0;
+	for (const FSentRequest& Sent : Requests)
+	{
+		NumPending += Sent.bCompleted ? 0 : 1;
+	}
+	return NumPending;
+}
+
+int32 FCarespaceTestTransport::GetFirstPending() const
+{
+	return Requests.IndexOfByPredicate([](const FSentRequest& Sent) { return !Sent.bCompleted; });
+}
+
+void FCarespaceTestTransport::Respond(int32 Index, int32 ResponseCode, const FString& Body, const TMap<FString, FString>& Headers)
+{
+	const FTCHARToUTF8 Utf8(*Body, Body.Len());
+	RespondBytes(Index, ResponseCode, TArray<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()), Headers);
+}
+
+void FCarespaceTestTransport::RespondBytes(int32 Index, int32 ResponseCode, TArray<uint8> Body, const TMap<FString, FString>& Headers)
+{
+	if (!Requests.IsValidIndex(Index) || Requests[Index].bCompleted)
+	{
+		return;
+	}
+	Complete(Index, MakeShared<FCarespaceTestResponse>(ResponseCode, MoveTemp(Body), Headers, Requests[Index].Request->GetURL()));
+}
+
+void FCarespaceTestTransport::Fail(int32 Index)
+{
+	if (Requests.IsValidIndex(Index) && !Requests[Index].bCompleted)
+	{
+		Complete(Index, nullptr);
+	}
+}
+
+void FCarespaceTestTransport::Complete(int32 Index, TSharedPtr<const ICarespaceHttpResponse> Response)
+{
+	// The completion may send new requests, which can reallocate the array
+	Requests[Index].bCompleted = true;
+	const FOnCarespaceTransportComplete OnComplete = Requests[Index].OnComplete;
+	const FHttpRequestPtr Request = Requests[Index].Request;
+	OnComplete.ExecuteIfBound(Request, Response);
+}
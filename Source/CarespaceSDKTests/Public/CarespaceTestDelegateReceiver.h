@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "CarespaceTypes.h"
+#include "CarespaceTestDelegateReceiver.generated.h"
+
+/**
+ * Records the calls of the dynamic result delegates of UCarespaceAPI, which can only be bound to a UFUNCTION:
+ *
+ *   FOnCarespaceUsersReceived OnUsers;
+ *   OnUsers.BindDynamic(Receiver, &UCarespaceTestDelegateReceiver::OnUsersReceived);
+ */
+UCLASS()
+class CARESPACESDKTESTS_API UCarespaceTestDelegateReceiver : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION()
+	void OnUsersReceived(bool bWasSuccessful, const TArray<FCarespaceUser>& Users)
+	{
+		++NumCalls;
+		bLastSucceeded = bWasSuccessful;
+		LastIds.Reset();
+		for (const FCarespaceUser& User : Users)
+		{
+			LastIds.Add(User.Id);
+		}
+	}
+
+	UFUNCTION()
+	void OnClientsReceived(bool bWasSuccessful, const TArray<FCarespaceClient>& Clients)
+	{
+		++NumCalls;
+		bLastSucceeded = bWasSuccessful;
+		LastIds.Reset();
+		for (const FCarespaceClient& Client : Clients)
+		{
+			LastIds.Add(Client.Id);
+		}
+	}
+
+	UFUNCTION()
+	void OnProgramsReceived(bool bWasSuccessful, const TArray<FCarespaceProgram>& Programs)
+	{
+		++NumCalls;
+		bLastSucceeded = bWasSuccessful;
+		LastIds.Reset();
+		for (const FCarespaceProgram& Program : Programs)
+		{
+			LastIds.Add(Program.Id);
+		}
+	}
+
+	/** Number of calls of any of the delegates */
+	int32 NumCalls = 0;
+
+	bool bLastSucceeded = false;
+
+	/** Ids of the items passed to the last call */
+	TArray<FString> LastIds;
+};
@@ -249,6 +249,14 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Test Helpers|Utilities")
 	static FString GenerateTestEmail(const FString& Username = TEXT(""), const FString& Domain = TEXT("test.com"));
 
+	/**
+	 * Encodes text as UTF-8 without a terminator, as response and request bodies are sent.
+	 * 
+	 * @param Text Text to encode, usually a JSON document
+	 * @return UTF-8 bytes of the text
+	 */
+	static TArray<uint8> ToUtf8Bytes(const FString& Text);
+
 	/**
 	 * Waits for asynchronous operations to complete in tests.
 	 * 
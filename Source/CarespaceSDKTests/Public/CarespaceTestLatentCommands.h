@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+/**
+ * Latent command that waits, one frame at a time, until a condition holds. The test fails instead of hanging
+ * if the condition does not hold within the timeout, which is counted from the first frame the command runs:
+ *
+ *   ADD_LATENT_AUTOMATION_COMMAND(FCarespaceWaitUntilCommand(this, TEXT("the response"), [&Done]() { return Done; }));
+ */
+class CARESPACESDKTESTS_API FCarespaceWaitUntilCommand : public IAutomationLatentCommand
+{
+public:
+	FCarespaceWaitUntilCommand(FAutomationTestBase* InTest, FString InDescription, TFunction<bool()> InCondition, double InTimeoutSeconds = 5.0)
+		: Test(InTest)
+		, Description(MoveTemp(InDescription))
+		, Condition(MoveTemp(InCondition))
+		, TimeoutSeconds(InTimeoutSeconds)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		if (Condition())
+		{
+			return true;
+		}
+
+		if (GetCurrentRunTime() > TimeoutSeconds)
+		{
+			Test->AddError(FString::Printf(TEXT("Timed out after %.1fs waiting for %s"), TimeoutSeconds, *Description));
+			return true;
+		}
+		return false;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	FString Description;
+	TFunction<bool()> Condition;
+	double TimeoutSeconds;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CarespaceHttpTransport.h"
+
+/**
+ * Response built in memory by FCarespaceTestTransport.
+ */
+class CARESPACESDKTESTS_API FCarespaceTestResponse : public ICarespaceHttpResponse
+{
+public:
+	FCarespaceTestResponse(int32 InResponseCode, TArray<uint8> InContent, TMap<FString, FString> InHeaders, FString InURL)
+		: ResponseCode(InResponseCode)
+		, Content(MoveTemp(InContent))
+		, Headers(MoveTemp(InHeaders))
+		, URL(MoveTemp(InURL))
+	{
+	}
+
+	virtual int32 GetResponseCode() const override { return ResponseCode; }
+	virtual FString GetHeader(const FString& HeaderName) const override;
+	virtual const TArray<uint8>& GetContent() const override { return Content; }
+	virtual FString GetURL() const override { return URL; }
+
+private:
+	int32 ResponseCode;
+	TArray<uint8> Content;
+	TMap<FString, FString> Headers;
+	FString URL;
+};
+
+/**
+ * Transport for automation tests. Requests are recorded instead of sent, and stay in flight until the
+ * test answers or fails them, so that coalescing, scheduling, retries and cancellation can be observed
+ * deterministically:
+ *
+ *   TSharedRef<FCarespaceTestTransport> Transport = MakeShared<FCarespaceTestTransport>();
+ *   Client->SetTransport(Transport);
+ *   Client->SendRequestRaw(TEXT("GET"), TEXT("/users"), ...);
+ *   Transport->Respond(0, 200, TEXT("{\"success\":true}"));
+ */
+class CARESPACESDKTESTS_API FCarespaceTestTransport : public ICarespaceHttpTransport
+{
+public:
+	struct FSentRequest
+	{
+		TSharedRef<IHttpRequest> Request;
+		FOnCarespaceTransportComplete OnComplete;
+		bool bCompleted = false;
+		bool bCancelled = false;
+	};
+
+	virtual void ProcessRequest(const TSharedRef<IHttpRequest>& Request, const FOnCarespaceTransportComplete& OnComplete) override;
+
+	/** Completes the request without a response, as the HTTP module does for cancelled requests. */
+	virtual void CancelRequest(const TSharedRef<IHttpRequest>& Request) override;
+
+	/** @return Number of requests sent so far, including completed ones */
+	int32 Num() const { return Requests.Num(); }
+
+	/** @return Number of requests that were neither answered nor cancelled */
+	int32 GetNumPending() const;
+
+	/** @return The Index-th request sent */
+	const FSentRequest& GetRequest(int32 Index) const { return Requests[Index]; }
+
+	/** @return Index of the oldest pending request, INDEX_NONE if there is none */
+	int32 GetFirstPending() const;
+
+	/** Answers a pending request; its completion runs before this returns. */
+	void Respond(int32 Index, int32 ResponseCode, const FString& Body, const TMap<FString, FString>& Headers = TMap<FString, FString>());
+
+	/** Variant of Respond with a body that is sent as is, e.g. a compressed one. */
+	void RespondBytes(int32 Index, int32 ResponseCode, TArray<uint8> Body, const TMap<FString, FString>& Headers = TMap<FString, FString>());
+
+	/** Completes a pending request without a response, as a connection failure would. */
+	void Fail(int32 Index);
+
+private:
+	void Complete(int32 Index, TSharedPtr<const ICarespaceHttpResponse> Response);
+
+	TArray<FSentRequest> Requests;
+};